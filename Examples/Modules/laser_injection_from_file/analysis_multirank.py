@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+#
+# Copyright 2022 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This file is part of the WarpX automated test suite. It tests the injection
+# of a laser pulse from an external binary file on several MPI ranks, each of
+# which only holds the part of the field data needed by its own boxes.
+#
+# The input binary file, with a gaussian laser pulse, is written by
+# run_multirank.py, which then starts WarpX. The simulations use small boxes,
+# small time chunks (which are read in the background) and load balancing
+# (which changes the data range of the ranks). The data is either read by the
+# I/O processor and sent to the other ranks, or read directly by each rank.
+#
+# - In 2D, compare the laser envelope and central frequency to the theory
+#   (see analysis.py)
+# - In 3D, where the ranks hold a part of the data along both x and y, the
+#   laser propagates along z: compare the laser envelope and wavelength to
+#   the theory
+
+import sys
+
+import numpy as np
+from scipy.signal import hilbert
+
+import yt ; yt.funcs.mylog.setLevel(50)
+
+from analysis import do_analysis, write_file_unf
+
+#Maximum acceptable error for this test
+relative_error_threshold = 0.065
+
+#Physical parameters
+um = 1.e-6
+fs = 1.e-15
+c = 299792458
+
+#Parameters of the gaussian beam in 3D (at focus on the antenna)
+wavelength = 1.*um
+w0 = 3.*um
+tt = 5.*fs
+t_c = 15.*fs
+E_max = 1e12
+
+#Parameters of the txy grid in 3D
+tcoords_3d = np.linspace(0.*fs, 30.*fs, 200)
+xcoords_3d = np.linspace(-8.*um, 8.*um, 65)
+ycoords_3d = np.linspace(-8.*um, 8.*um, 65)
+
+def create_gaussian_3d():
+    T, X, Y = np.meshgrid(tcoords_3d, xcoords_3d, ycoords_3d, indexing='ij')
+    E_t = np.cos(2.*np.pi*c/wavelength*(T-t_c)) * \
+        np.exp(-(X*X + Y*Y)/(w0*w0) - (T-t_c)*(T-t_c)/(tt*tt))
+    write_file_unf("gauss_3d_unf.txye", xcoords_3d, ycoords_3d, tcoords_3d, E_t)
+
+def do_analysis_3d(fname):
+    ds = yt.load(fname)
+    t = ds.current_time.to_value()
+
+    # The fields of the plotfile are cell-centered
+    lo = ds.domain_left_edge.v
+    hi = ds.domain_right_edge.v
+    n = ds.domain_dimensions
+    x, y, z = [lo[i] + (np.arange(n[i]) + 0.5)*(hi[i] - lo[i])/n[i] for i in range(3)]
+    X, Y, Z = np.meshgrid(x, y, z, indexing='ij')
+
+    # The antenna emits the pulse in both directions
+    transverse = np.exp(-(X*X + Y*Y)/(w0*w0))
+    env_theory = E_max * transverse * (
+        np.exp(-(Z - c*(t - t_c))**2/(c*tt)**2) +
+        np.exp(-(Z + c*(t - t_c))**2/(c*tt)**2))
+
+    all_data_level_0 = ds.covering_grid(level=0, left_edge=ds.domain_left_edge,
+                                        dims=ds.domain_dimensions)
+    F_laser = all_data_level_0['boxlib', 'Ey'].v
+    env = np.abs(hilbert(F_laser, axis=2))
+
+    relative_error_env = np.sum(np.abs(env-env_theory)) / np.sum(np.abs(env))
+    print("Relative error envelope: ", relative_error_env)
+    assert(relative_error_env < relative_error_threshold)
+
+    # Wavelength of the field on the axis
+    F_axis = F_laser[n[0]//2, n[1]//2, :]
+    k = np.fft.rfftfreq(n[2], (hi[2] - lo[2])/n[2])
+    k_max = k[np.abs(np.fft.rfft(F_axis)).argmax()]
+    relative_error_k = np.abs(k_max*wavelength - 1.)
+    print("Relative error wavenumber: ", relative_error_k)
+    assert(relative_error_k < relative_error_threshold)
+
+def main():
+    fname = sys.argv[1]
+    if yt.load(fname).dimensionality == 3:
+        do_analysis_3d(fname)
+    else:
+        do_analysis(fname, "comp_multirank.pdf", 250)
+
+if __name__ == "__main__":
+    main()
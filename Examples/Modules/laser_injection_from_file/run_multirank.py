@@ -0,0 +1,45 @@
+#!/usr/bin/env python3
+#
+# Copyright 2022 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# Write the input binary file with a gaussian laser pulse, and then run WarpX
+# with the input file and the parameters given as arguments, e.g.
+#   run_multirank.py inputs.3d_test_txye diag1.file_prefix=plt
+#
+# This script is launched by the test suite on each MPI rank. Every rank writes
+# the same file in its own temporary directory, and then atomically moves it
+# to the current directory, so that no rank can read a partially written file.
+# The script then replaces itself with the WarpX executable, which initializes
+# MPI.
+
+import glob
+import os
+import sys
+import tempfile
+
+from analysis import create_gaussian_2d
+from analysis_multirank import create_gaussian_3d
+
+def main():
+    executables = glob.glob("*.ex")
+    assert len(executables) == 1
+    inputs = sys.argv[1]
+    cwd = os.getcwd()
+    with tempfile.TemporaryDirectory(dir=cwd) as tmp_dir:
+        os.chdir(tmp_dir)
+        if "3d" in inputs:
+            create_gaussian_3d()
+        else:
+            create_gaussian_2d()
+        os.chdir(cwd)
+        for fname in os.listdir(tmp_dir):
+            os.replace(os.path.join(tmp_dir, fname), fname)
+    executable = "./" + executables[0]
+    os.execv(executable, [executable] + sys.argv[1:])
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,61 @@
+#!/usr/bin/env python3
+#
+# Copyright 2022 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+"""
+This script checks the generation and the cache of the QED lookup tables.
+
+The test generates the Quantum Synchrotron and Breit-Wheeler lookup tables on
+2 MPI ranks, which compute distinct rows of the tables, and saves them in a
+cache directory. This script then runs the same simulation on a single rank
+twice: once with the same cache directory, so that the tables are loaded from
+the cache, and once with an empty cache directory, so that the tables are
+generated again. The tables of the three runs must be identical.
+"""
+import filecmp
+import glob
+import os
+
+qs_params = (
+    "qed_qs.lookup_table_mode=generate qed_qs.tab_dndt_chi_min=0.001 "
+    "qed_qs.tab_dndt_chi_max=1000.0 qed_qs.tab_dndt_how_many=64 "
+    "qed_qs.tab_em_chi_min=0.001 qed_qs.tab_em_frac_min=1.0e-12 "
+    "qed_qs.tab_em_chi_max=1000.0 qed_qs.tab_em_chi_how_many=64 "
+    "qed_qs.tab_em_frac_how_many=64 ")
+bw_params = (
+    "qed_bw.lookup_table_mode=generate qed_bw.tab_dndt_chi_min=0.01 "
+    "qed_bw.tab_dndt_chi_max=1000.0 qed_bw.tab_dndt_how_many=64 "
+    "qed_bw.tab_pair_chi_min=0.01 qed_bw.tab_pair_chi_max=1000.0 "
+    "qed_bw.tab_pair_chi_how_many=64 qed_bw.tab_pair_frac_how_many=64 ")
+
+# The tables generated by the test are in the cache
+for process in ["qs", "bw"]:
+    assert os.path.isfile(process + "_table")
+    assert len(glob.glob("qed_table_cache/" + process + "_table_*.bin")) == 1
+
+executables = glob.glob("*.ex")
+assert len(executables) == 1
+
+def run(suffix, cache_dir):
+    status = os.system("./" + executables[0] + " inputs_3d " + qs_params + bw_params +
+                       "qed_qs.save_table_in=qs_table_" + suffix + " " +
+                       "qed_bw.save_table_in=bw_table_" + suffix + " " +
+                       "qed_qs.table_cache_dir=" + cache_dir + " " +
+                       "qed_bw.table_cache_dir=" + cache_dir + " " +
+                       "diag1.file_prefix=" + suffix + "/diag1")
+    assert status == 0
+
+# Tables loaded from the cache
+run("cached", "qed_table_cache")
+# Tables generated again, on a single rank
+run("fresh", "qed_table_cache_fresh")
+
+for process in ["qs", "bw"]:
+    for suffix in ["cached", "fresh"]:
+        same = filecmp.cmp(process + "_table", process + "_table_" + suffix, shallow=False)
+        print("%s table identical to the %s table: %s" % (process, suffix, same))
+        assert same
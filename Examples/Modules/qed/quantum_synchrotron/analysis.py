@@ -300,7 +300,11 @@ def check():
         print("*************\n")
 
     test_name = os.path.split(os.getcwd())[1]
-    checksumAPI.evaluate_checksum(test_name, filename_end)
+    # Tables generated at runtime do not reproduce the builtin ones bit by bit,
+    # so the emission events differ from the benchmark: in that case, only the
+    # checks against the theoretical rates above are meaningful.
+    if not test_name.endswith('_generated_tables'):
+        checksumAPI.evaluate_checksum(test_name, filename_end)
 
 def main():
     check()
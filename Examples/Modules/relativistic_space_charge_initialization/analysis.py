@@ -89,4 +89,7 @@ def check(E, E_th, label):
 check( Ex_array, Ex_th, 'Ex' )
 
 test_name = os.path.split(os.getcwd())[1]
-checksumAPI.evaluate_checksum(test_name, filename, do_particles=False)
+# With the FFT integrated Green function solver (open boundaries), the fields
+# are only checked against the theory above
+if not test_name.endswith('_fft_igf'):
+    checksumAPI.evaluate_checksum(test_name, filename, do_particles=False)
@@ -111,4 +111,7 @@ if ds.dimensionality == 3:
     check( Ez_array, Ez_th, 'Ez' )
 
 test_name = os.path.split(os.getcwd())[1]
-checksumAPI.evaluate_checksum(test_name, filename, do_particles=0)
+# With the FFT integrated Green function solver (open boundaries), the fields
+# are only checked against the theory above
+if not test_name.endswith('_fft_igf'):
+    checksumAPI.evaluate_checksum(test_name, filename, do_particles=0)
@@ -0,0 +1,48 @@
+#!/usr/bin/env python3
+#
+# Copyright 2022 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+"""
+This script checks the reuse of the Poisson solver between steps
+(warpx.self_fields_reuse_solver) with the expanding sphere of electrons
+(see analysis_electrostatic_sphere.py), from the PoissonSolverStats
+reduced diagnostic:
+- without reuse, the linear operator is built at each step;
+- with reuse, it is only built once, and no solve takes more MLMG iterations
+  than the first one, which starts from a zero potential as all the solves
+  do without reuse.
+The fields are compared with the benchmark of the run without reuse, up to
+the precision of the Poisson solver.
+"""
+import os
+import sys
+
+import numpy as np
+
+sys.path.insert(1, '../../../../warpx/Regression/Checksum/')
+import checksumAPI
+
+filename = sys.argv[1]
+test_name = os.path.split(os.getcwd())[1]
+
+# Columns: step, time, iterations, setups, setup_time, solve_time
+stats = np.genfromtxt('./diags/reducedfiles/poisson.txt')
+iterations = stats[:, 2]
+setups = stats[:, 3]
+print("MLMG iterations per step:", iterations)
+print("Linear operators built per step:", setups)
+
+if test_name.endswith('no_solver_reuse'):
+    assert np.all(setups >= 1)
+    checksumAPI.evaluate_checksum(test_name, filename)
+else:
+    num_reuse = np.count_nonzero(setups == 0)
+    print("Steps that reuse the linear operator:", num_reuse)
+    assert num_reuse > 0
+    assert np.all(iterations[1:] <= iterations[0])
+    checksumAPI.evaluate_checksum('ElectrostaticSphereLabFrame_no_solver_reuse', filename,
+                                  rtol=1.e-6)
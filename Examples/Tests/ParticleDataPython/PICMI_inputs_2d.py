@@ -152,6 +152,29 @@ new_pid_vals = sim.extension.get_particle_arrays(
 for vals in new_pid_vals:
     assert np.allclose(vals, 5)
 
+# the batch accessors return the same data as the per-component accessors
+structs, arrays = sim.extension.get_particle_arrays_batch(
+    'electrons', ['w', 'ux', 'newPid'], 0
+)
+assert np.array_equal(
+    np.concatenate([struct['x'] for struct in structs]),
+    np.concatenate(sim.extension.get_particle_x('electrons'))
+)
+assert np.array_equal(
+    np.concatenate(arrays['ux']),
+    np.concatenate(sim.extension.get_particle_ux('electrons'))
+)
+assert np.allclose(np.concatenate(arrays['w']), 2.0)
+assert np.allclose(np.concatenate(arrays['newPid']), 5.0)
+
+Efields, Elovects = sim.extension.get_mesh_electric_field_all_directions(0)
+for direction in range(3):
+    for E_batch, E in zip(Efields[direction],
+                          sim.extension.get_mesh_electric_field(0, direction)):
+        assert np.array_equal(E_batch, E)
+    lovects, _ = sim.extension.get_mesh_electric_field_lovects(0, direction)
+    assert np.array_equal(Elovects[direction], lovects)
+
 ##########################
 # take the final sim step
 ##########################
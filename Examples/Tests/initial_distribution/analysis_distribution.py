@@ -15,11 +15,13 @@
 # 6 denotes maxwell-boltzmann distribution w/ constant velocity
 # 7 denotes maxwell-boltzmann distribution w/ spatially-varying velocity
 # The distribution is obtained through reduced diagnostic ParticleHistogram.
+# 1 is also checked with the 2D reduced diagnostic PhaseSpaceHistogram.
 
 import os
 import sys
 
 import numpy as np
+import openpmd_api as io
 from read_raw_data import read_reduced_diags, read_reduced_diags_histogram
 import scipy.constants as scc
 import scipy.special as scs
@@ -69,6 +71,20 @@ print('Maxwell-Boltzmann distribution difference:', f2_error)
 assert(f1_error < tolerance)
 assert(f2_error < tolerance)
 
+# 2D (ux,uy) histogram, integrated over uy: only particles with uy
+# in the range of the bins are counted, which is almost all of them
+series = io.Series("h1xy/openpmd_%T.json", io.Access.read_only)
+mesh = series.iterations[1].meshes["data"]
+h1xy = mesh[io.Mesh_Record_Component.SCALAR].load_chunk()
+series.flush()
+assert(list(mesh.axis_labels) == ["ux", "uy"])
+assert(np.allclose(mesh.grid_global_offset, [-4.0e-2, -4.0e-2]))
+f1xy_error = np.sum(np.abs(f-h1xy.sum(axis=1)))/bin_value.size / f_peak
+
+print('Gaussian 2D phase-space distribution difference:', f1xy_error)
+
+assert(f1xy_error < tolerance)
+
 #================
 # maxwell-juttner
 #================
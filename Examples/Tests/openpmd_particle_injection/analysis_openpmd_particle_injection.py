@@ -0,0 +1,58 @@
+#!/usr/bin/env python3
+#
+# Copyright 2022 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+"""
+This script tests the injection of particles from an openPMD file
+(<species>.injection_style = external_file), which is read in parallel.
+
+The tests openPMDParticleInjection_np1, _np2 and _np4 run the same input on
+1, 2 and 4 MPI ranks, each rank reading a slice of the particle records, and
+write their diagnostics to distinct prefixes.
+This script checks that the particles written at step 0 are exactly the
+particles of the file beam.h5 (written by write_particle_file.py), so that
+the three tests inject the same particles.
+"""
+import sys
+
+import numpy as np
+import openpmd_api as io
+
+def read_particles(filename):
+    series = io.Series(filename, io.Access.read_only)
+    beam = series.iterations[0].particles["beam"]
+    data = {}
+    for comp in ["x", "y", "z"]:
+        data["position_" + comp] = beam["position"][comp].load_chunk()
+        data["offset_" + comp] = beam["positionOffset"][comp].load_chunk()
+        data["momentum_" + comp] = beam["momentum"][comp].load_chunk()
+    data["weighting"] = beam["weighting"][io.Mesh_Record_Component.SCALAR].load_chunk()
+    series.flush()
+    pos = np.array([data["position_" + c] + data["offset_" + c] for c in ["x", "y", "z"]])
+    mom = np.array([data["momentum_" + c] for c in ["x", "y", "z"]])
+    return pos, mom, data["weighting"]
+
+def main():
+    diag_dir = sys.argv[1]
+    pos_file, mom_file, w_file = read_particles("beam.h5")
+    pos, mom, w = read_particles(diag_dir + "/openpmd_%T.h5")
+    assert pos.shape == pos_file.shape
+    # The particles are not in the same order as in the file
+    order_file = np.argsort(pos_file[0])
+    order_diag = np.argsort(pos[0])
+    error_pos = np.max(np.abs(pos[:, order_diag] - pos_file[:, order_file])) / 1.e-5
+    error_mom = np.max(np.abs(mom[:, order_diag] - mom_file[:, order_file])) \
+        / np.max(np.abs(mom_file))
+    error_w = np.max(np.abs(w[order_diag] - w_file[order_file])) / np.max(w_file)
+    print(diag_dir + ": relative errors on position, momentum and weighting:",
+          error_pos, error_mom, error_w)
+    assert error_pos < 1.e-12
+    assert error_mom < 1.e-12
+    assert error_w < 1.e-12
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+#
+# Copyright 2022 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+"""
+Write an openPMD file with random particles, whose charge, mass and weighting
+are constant records, and then run WarpX, which injects these particles
+(<species>.injection_style = external_file). The arguments of this script are
+passed to WarpX.
+
+This script is launched by the test suite on each MPI rank. Every rank writes
+the same file (the random generator is seeded) to a temporary name, and then
+atomically moves it to beam.h5, so that no rank can read a partially written
+file. The script then replaces itself with the WarpX executable, which
+initializes MPI.
+"""
+import glob
+import os
+import sys
+
+import numpy as np
+import openpmd_api as io
+from scipy.constants import e, m_e
+
+np.random.seed(0)
+n_particles = 1000
+weighting = 1.e5
+position = np.random.uniform(-1.e-5, 1.e-5, (3, n_particles))
+momentum = m_e * 3.e8 * np.random.normal(0., 1., (3, n_particles))
+
+def write_particle_file(filename):
+    series = io.Series(filename, io.Access.create)
+    beam = series.iterations[0].particles["beam"]
+    dataset = io.Dataset(np.dtype("float64"), [n_particles])
+    for idim, comp in enumerate(["x", "y", "z"]):
+        for record, values in [("position", position), ("momentum", momentum)]:
+            beam[record][comp].reset_dataset(dataset)
+            beam[record][comp].store_chunk(values[idim])
+        beam["positionOffset"][comp].reset_dataset(dataset)
+        beam["positionOffset"][comp].make_constant(0.)
+    beam["position"].unit_dimension = {io.Unit_Dimension.L: 1}
+    beam["positionOffset"].unit_dimension = {io.Unit_Dimension.L: 1}
+    beam["momentum"].unit_dimension = {io.Unit_Dimension.M: 1,
+                                       io.Unit_Dimension.L: 1,
+                                       io.Unit_Dimension.T: -1}
+    for record, value in [("charge", -e), ("mass", m_e), ("weighting", weighting)]:
+        beam[record][io.Mesh_Record_Component.SCALAR].reset_dataset(dataset)
+        beam[record][io.Mesh_Record_Component.SCALAR].make_constant(value)
+    series.flush()
+    del series
+
+def main():
+    executables = glob.glob("*.ex")
+    assert len(executables) == 1
+    tmp_filename = "beam_%d.h5" % os.getpid()
+    write_particle_file(tmp_filename)
+    os.replace(tmp_filename, "beam.h5")
+    executable = "./" + executables[0]
+    os.execv(executable, [executable, "inputs_3d"] + sys.argv[1:])
+
+if __name__ == "__main__":
+    main()
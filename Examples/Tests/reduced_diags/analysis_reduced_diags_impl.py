@@ -223,6 +223,18 @@ def do_analysis(single_precision = False):
     FR_Mindata = np.genfromtxt('./diags/reducedfiles/FR_Min.txt')  # Field Reduction using minimum
     FR_Integraldata = np.genfromtxt('./diags/reducedfiles/FR_Integral.txt')  # Field Reduction using integral
 
+    # The same particle energy, written in binary format: it only differs from
+    # the text output by the 14 digits of the text format
+    EP_binarydata = np.fromfile('./diags/reducedfiles/EP_binary.bin').reshape(EPdata.shape)
+    assert np.allclose(EP_binarydata, EPdata, rtol=1.e-13, atol=0.)
+
+    # Phase timings: the phases are exclusive, so that their times add up to the total
+    # time of the step, on each rank, and thus for the averages over the ranks
+    PTdata = np.genfromtxt('./diags/reducedfiles/PT.txt')
+    PT_avg = PTdata[1][3::3]
+    assert np.all(PTdata[1][2:] >= 0.)
+    assert np.isclose(np.sum(PT_avg[:-1]), PT_avg[-1], rtol=1.e-6)
+
     # First index "1" points to the values written at the last time step
     values_rd['field energy'] = EFdata[1][2]
     values_rd['field energy in quarter of simulation domain'] = FR_Integraldata[1][2]
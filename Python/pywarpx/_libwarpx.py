@@ -137,6 +137,7 @@ class LibWarpX():
         else:
             c_particlereal = ctypes.c_float
             _numpy_particlereal_dtype = 'f4'
+        self._numpy_particlereal_dtype = _numpy_particlereal_dtype
 
         self.dim = self.libwarpx_so.warpx_SpaceDim()
 
@@ -154,7 +155,7 @@ class LibWarpX():
         # some useful typenames
         _LP_particle_p = ctypes.POINTER(ctypes.POINTER(Particle))
         _LP_LP_c_int = ctypes.POINTER(_LP_c_int)
-        #_LP_c_void_p = ctypes.POINTER(ctypes.c_void_p)
+        _LP_c_void_p = ctypes.POINTER(ctypes.c_void_p)
         _LP_c_real = ctypes.POINTER(c_real)
         _LP_LP_c_real = ctypes.POINTER(_LP_c_real)
         _LP_c_particlereal = ctypes.POINTER(c_particlereal)
@@ -166,6 +167,13 @@ class LibWarpX():
         self.libwarpx_so.amrex_init_with_inited_mpi.argtypes = (ctypes.c_int, _LP_LP_c_char, _MPI_Comm_type)
         self.libwarpx_so.warpx_getParticleStructs.restype = _LP_particle_p
         self.libwarpx_so.warpx_getParticleArrays.restype = _LP_LP_c_particlereal
+        self.libwarpx_so.warpx_getParticleArraysBatch.restype = _LP_c_void_p
+        self.libwarpx_so.warpx_getParticleArraysBatch.argtypes = (
+            ctypes.c_char_p, ctypes.c_int, ctypes.POINTER(ctypes.c_char_p), ctypes.c_int,
+            ctypes.POINTER(ctypes.c_int), ctypes.POINTER(_LP_c_int), ctypes.POINTER(_LP_c_void_p))
+        self.libwarpx_so.warpx_getEfieldAllDirections.restype = _LP_c_void_p
+        self.libwarpx_so.warpx_getBfieldAllDirections.restype = _LP_c_void_p
+        self.libwarpx_so.warpx_getCurrentDensityAllDirections.restype = _LP_c_void_p
         self.libwarpx_so.warpx_getParticleCompIndex.restype = ctypes.c_int
         self.libwarpx_so.warpx_getEfield.restype = _LP_LP_c_real
         self.libwarpx_so.warpx_getEfieldLoVects.restype = _LP_c_int
@@ -736,6 +744,62 @@ class LibWarpX():
         _libc.free(data)
         return particle_data
 
+    def get_particle_arrays_batch(self, species_name, comp_names, level=0):
+        '''
+
+        This returns, in a single call, the particle struct data and the particle
+        array data of several components on each tile for this process.
+        This is much faster than calling get_particle_structs and get_particle_arrays
+        for each component, since the tiles are only walked once.
+
+        The data for the numpy arrays are not copied, but share the underlying
+        memory buffer with WarpX. The numpy arrays are fully writeable.
+        Tiles without particles are skipped, so that all the returned lists
+        are aligned, tile by tile.
+
+        Parameters
+        ----------
+
+            species_name   : the species name that the data will be returned for
+            comp_names     : the list of components of the array data that will be returned
+            level          : the AMR level to get the data for
+
+        Returns
+        -------
+
+            A List of structured numpy arrays (as returned by get_particle_structs),
+            and a dictionary mapping each component name to a List of numpy arrays.
+
+        '''
+
+        ncomps = len(comp_names)
+        c_comp_names = (ctypes.c_char_p * ncomps)(*[comp.encode('utf-8') for comp in comp_names])
+        particles_per_tile = _LP_c_int()
+        num_tiles = ctypes.c_int(0)
+        structs = ctypes.POINTER(ctypes.c_void_p)()
+        data = self.libwarpx_so.warpx_getParticleArraysBatch(
+            ctypes.c_char_p(species_name.encode('utf-8')), ncomps, c_comp_names,
+            level, ctypes.byref(num_tiles), ctypes.byref(particles_per_tile),
+            ctypes.byref(structs)
+        )
+
+        real_dtype = np.dtype(self._numpy_particlereal_dtype)
+        struct_data = []
+        array_data = {comp: [] for comp in comp_names}
+        for i in range(num_tiles.value):
+            np_tile = particles_per_tile[i]
+            if np_tile == 0:
+                continue
+            struct_data.append(self._array1d_from_pointer(structs[i], self._p_dtype, np_tile))
+            for icomp, comp in enumerate(comp_names):
+                array_data[comp].append(
+                    self._array1d_from_pointer(data[i*ncomps + icomp], real_dtype, np_tile))
+
+        _libc.free(particles_per_tile)
+        _libc.free(structs)
+        _libc.free(data)
+        return struct_data, array_data
+
     def get_particle_x(self, species_name, level=0):
         '''
 
@@ -1133,6 +1197,103 @@ class LibWarpX():
         _libc.free(data)
         return grid_data
 
+    def _get_mesh_field_all_directions(self, warpx_func, level, include_ghosts):
+        """
+        Generic routine to fetch the lists of field data arrays and of their
+        lower corners for the three directions of a vector field, in a single call.
+        """
+        shapes = _LP_c_int()
+        lovects = _LP_c_int()
+        size = ctypes.c_int(0)
+        ncomps = ctypes.c_int(0)
+        ngrowvect = _LP_c_int()
+        data = warpx_func(level,
+                          ctypes.byref(size), ctypes.byref(ncomps),
+                          ctypes.byref(ngrowvect), ctypes.byref(shapes), ctypes.byref(lovects))
+        if not data:
+            raise Exception('object was not initialized')
+
+        dtype = np.dtype(self._numpy_real_dtype)
+        shapesize = self.dim
+        if ncomps.value > 1:
+            shapesize += 1
+        grid_data = []
+        grid_lovects = []
+        for idir in range(3):
+            ngvect = [ngrowvect[self.dim*idir + d] for d in range(self.dim)]
+            dir_data = []
+            # --- Shape (dims, number of grids), as returned by the lovects functions
+            dir_lovects = np.zeros((self.dim, size.value), dtype=int)
+            for ibox in range(size.value):
+                i = idir*size.value + ibox
+                shape = tuple([shapes[shapesize*i + d] for d in range(shapesize)])
+                # --- The data is stored in Fortran order, hence shape is reversed and a transpose is taken.
+                arr = self._array1d_from_pointer(data[i], dtype, int(np.prod(shape)))
+                arr = arr.reshape(shape[::-1]).T
+                for d in range(self.dim):
+                    dir_lovects[d, ibox] = lovects[self.dim*i + d]
+                if include_ghosts:
+                    dir_data.append(arr)
+                else:
+                    dir_data.append(arr[tuple([slice(ngvect[d], -ngvect[d]) for d in range(self.dim)])])
+                    dir_lovects[:, ibox] += ngvect
+            grid_data.append(dir_data)
+            grid_lovects.append(dir_lovects)
+
+        _libc.free(shapes)
+        _libc.free(lovects)
+        _libc.free(ngrowvect)
+        _libc.free(data)
+        return grid_data, grid_lovects
+
+    def get_mesh_electric_field_all_directions(self, level, include_ghosts=True):
+        '''
+
+        This returns, in a single call, the lists of numpy arrays containing the mesh
+        electric field data on each grid for this process, for the three directions,
+        as well as the lists of the lower corners of the grids.
+
+        This version is for the full "auxiliary" solution on the given level.
+
+        The data for the numpy arrays are not copied, but share the underlying
+        memory buffer with WarpX. The numpy arrays are fully writeable.
+
+        Parameters
+        ----------
+
+            level          : the AMR level to get the data for
+            include_ghosts : whether to include ghost zones or not
+
+        Returns
+        -------
+
+            A List (one per direction) of Lists of numpy arrays,
+            and a List (one per direction) of arrays of lower corners,
+            of shape (dims, number of grids).
+
+        '''
+
+        return self._get_mesh_field_all_directions(self.libwarpx_so.warpx_getEfieldAllDirections, level, include_ghosts)
+
+    def get_mesh_magnetic_field_all_directions(self, level, include_ghosts=True):
+        '''
+
+        Same as get_mesh_electric_field_all_directions, for the magnetic field.
+
+        '''
+
+        return self._get_mesh_field_all_directions(self.libwarpx_so.warpx_getBfieldAllDirections, level, include_ghosts)
+
+    def get_mesh_current_density_all_directions(self, level, include_ghosts=True):
+        '''
+
+        Same as get_mesh_electric_field_all_directions, for the current density
+        (fine patch).
+
+        '''
+
+        return self._get_mesh_field_all_directions(self.libwarpx_so.warpx_getCurrentDensityAllDirections, level, include_ghosts)
+
     def get_mesh_electric_field(self, level, direction, include_ghosts=True):
         '''
 
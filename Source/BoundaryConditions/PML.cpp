@@ -731,6 +731,7 @@ PML::PML (const int lev, const BoxArray& grid_ba, const DistributionMapping& gri
         const amrex::IntVect fill_guards = amrex::IntVect(0);
         const bool in_pml = true;
         const bool periodic_single_box = false;
+        const bool distributed_fft = false;
         const bool update_with_rho = false;
         const bool fft_do_time_averaging = false;
         const RealVect dx{AMREX_D_DECL(geom->CellSize(0), geom->CellSize(1), geom->CellSize(2))};
@@ -741,7 +742,7 @@ PML::PML (const int lev, const BoxArray& grid_ba, const DistributionMapping& gri
         realspace_ba.enclosedCells().grow(nge); // cell-centered + guard cells
         spectral_solver_fp = std::make_unique<SpectralSolver>(lev, realspace_ba, dm,
             nox_fft, noy_fft, noz_fft, do_nodal, fill_guards, v_galilean_zero,
-            v_comoving_zero, dx, dt, in_pml, periodic_single_box, update_with_rho,
+            v_comoving_zero, dx, dt, in_pml, periodic_single_box, distributed_fft, update_with_rho,
             fft_do_time_averaging, do_multi_J, m_dive_cleaning, m_divb_cleaning);
 #endif
     }
@@ -851,6 +852,7 @@ PML::PML (const int lev, const BoxArray& grid_ba, const DistributionMapping& gri
             const amrex::IntVect fill_guards = amrex::IntVect(0);
             const bool in_pml = true;
             const bool periodic_single_box = false;
+            const bool distributed_fft = false;
             const bool update_with_rho = false;
             const bool fft_do_time_averaging = false;
             const RealVect cdx{AMREX_D_DECL(cgeom->CellSize(0), cgeom->CellSize(1), cgeom->CellSize(2))};
@@ -861,7 +863,7 @@ PML::PML (const int lev, const BoxArray& grid_ba, const DistributionMapping& gri
             realspace_cba.enclosedCells().grow(nge); // cell-centered + guard cells
             spectral_solver_cp = std::make_unique<SpectralSolver>(lev, realspace_cba, cdm,
                 nox_fft, noy_fft, noz_fft, do_nodal, fill_guards, v_galilean_zero,
-                v_comoving_zero, cdx, dt, in_pml, periodic_single_box, update_with_rho,
+                v_comoving_zero, cdx, dt, in_pml, periodic_single_box, distributed_fft, update_with_rho,
                 fft_do_time_averaging, do_multi_J, m_dive_cleaning, m_divb_cleaning);
 #endif
         }
@@ -1401,79 +1403,46 @@ PushPMLPSATDSinglePatch (
 {
     const SpectralFieldIndex& Idx = solver.m_spectral_index;
 
-    // Perform forward Fourier transforms
-    solver.ForwardTransform(lev, *pml_E[0], Idx.Exy, PMLComp::xy);
-    solver.ForwardTransform(lev, *pml_E[0], Idx.Exz, PMLComp::xz);
-    solver.ForwardTransform(lev, *pml_E[1], Idx.Eyx, PMLComp::yx);
-    solver.ForwardTransform(lev, *pml_E[1], Idx.Eyz, PMLComp::yz);
-    solver.ForwardTransform(lev, *pml_E[2], Idx.Ezx, PMLComp::zx);
-    solver.ForwardTransform(lev, *pml_E[2], Idx.Ezy, PMLComp::zy);
-    solver.ForwardTransform(lev, *pml_B[0], Idx.Bxy, PMLComp::xy);
-    solver.ForwardTransform(lev, *pml_B[0], Idx.Bxz, PMLComp::xz);
-    solver.ForwardTransform(lev, *pml_B[1], Idx.Byx, PMLComp::yx);
-    solver.ForwardTransform(lev, *pml_B[1], Idx.Byz, PMLComp::yz);
-    solver.ForwardTransform(lev, *pml_B[2], Idx.Bzx, PMLComp::zx);
-    solver.ForwardTransform(lev, *pml_B[2], Idx.Bzy, PMLComp::zy);
+    // Components of the PML fields and corresponding spectral fields
+    // (all transformed together, with batched FFTs)
+    BackwardTransformComps pml_comps = {
+        {pml_E[0].get(), Idx.Exy, PMLComp::xy}, {pml_E[0].get(), Idx.Exz, PMLComp::xz},
+        {pml_E[1].get(), Idx.Eyx, PMLComp::yx}, {pml_E[1].get(), Idx.Eyz, PMLComp::yz},
+        {pml_E[2].get(), Idx.Ezx, PMLComp::zx}, {pml_E[2].get(), Idx.Ezy, PMLComp::zy},
+        {pml_B[0].get(), Idx.Bxy, PMLComp::xy}, {pml_B[0].get(), Idx.Bxz, PMLComp::xz},
+        {pml_B[1].get(), Idx.Byx, PMLComp::yx}, {pml_B[1].get(), Idx.Byz, PMLComp::yz},
+        {pml_B[2].get(), Idx.Bzx, PMLComp::zx}, {pml_B[2].get(), Idx.Bzy, PMLComp::zy}};
 
     // WarpX::do_pml_dive_cleaning = true
     if (pml_F)
     {
-        solver.ForwardTransform(lev, *pml_E[0], Idx.Exx, PMLComp::xx);
-        solver.ForwardTransform(lev, *pml_E[1], Idx.Eyy, PMLComp::yy);
-        solver.ForwardTransform(lev, *pml_E[2], Idx.Ezz, PMLComp::zz);
-        solver.ForwardTransform(lev, *pml_F, Idx.Fx, PMLComp::x);
-        solver.ForwardTransform(lev, *pml_F, Idx.Fy, PMLComp::y);
-        solver.ForwardTransform(lev, *pml_F, Idx.Fz, PMLComp::z);
+        pml_comps.insert(pml_comps.end(), {
+            {pml_E[0].get(), Idx.Exx, PMLComp::xx}, {pml_E[1].get(), Idx.Eyy, PMLComp::yy},
+            {pml_E[2].get(), Idx.Ezz, PMLComp::zz}, {pml_F.get(), Idx.Fx, PMLComp::x},
+            {pml_F.get(), Idx.Fy, PMLComp::y}, {pml_F.get(), Idx.Fz, PMLComp::z}});
     }
 
     // WarpX::do_pml_divb_cleaning = true
     if (pml_G)
     {
-        solver.ForwardTransform(lev, *pml_B[0], Idx.Bxx, PMLComp::xx);
-        solver.ForwardTransform(lev, *pml_B[1], Idx.Byy, PMLComp::yy);
-        solver.ForwardTransform(lev, *pml_B[2], Idx.Bzz, PMLComp::zz);
-        solver.ForwardTransform(lev, *pml_G, Idx.Gx, PMLComp::x);
-        solver.ForwardTransform(lev, *pml_G, Idx.Gy, PMLComp::y);
-        solver.ForwardTransform(lev, *pml_G, Idx.Gz, PMLComp::z);
+        pml_comps.insert(pml_comps.end(), {
+            {pml_B[0].get(), Idx.Bxx, PMLComp::xx}, {pml_B[1].get(), Idx.Byy, PMLComp::yy},
+            {pml_B[2].get(), Idx.Bzz, PMLComp::zz}, {pml_G.get(), Idx.Gx, PMLComp::x},
+            {pml_G.get(), Idx.Gy, PMLComp::y}, {pml_G.get(), Idx.Gz, PMLComp::z}});
+    }
+
+    ForwardTransformComps forward_comps;
+    for (const auto& comp : pml_comps) {
+        forward_comps.push_back({comp.mf, comp.field_index, comp.i_comp});
     }
 
+    // Perform forward Fourier transforms
+    solver.ForwardTransform(lev, forward_comps);
+
     // Advance fields in spectral space
     solver.pushSpectralFields();
 
     // Perform backward Fourier transforms
-    solver.BackwardTransform(lev, *pml_E[0], Idx.Exy, PMLComp::xy);
-    solver.BackwardTransform(lev, *pml_E[0], Idx.Exz, PMLComp::xz);
-    solver.BackwardTransform(lev, *pml_E[1], Idx.Eyx, PMLComp::yx);
-    solver.BackwardTransform(lev, *pml_E[1], Idx.Eyz, PMLComp::yz);
-    solver.BackwardTransform(lev, *pml_E[2], Idx.Ezx, PMLComp::zx);
-    solver.BackwardTransform(lev, *pml_E[2], Idx.Ezy, PMLComp::zy);
-    solver.BackwardTransform(lev, *pml_B[0], Idx.Bxy, PMLComp::xy);
-    solver.BackwardTransform(lev, *pml_B[0], Idx.Bxz, PMLComp::xz);
-    solver.BackwardTransform(lev, *pml_B[1], Idx.Byx, PMLComp::yx);
-    solver.BackwardTransform(lev, *pml_B[1], Idx.Byz, PMLComp::yz);
-    solver.BackwardTransform(lev, *pml_B[2], Idx.Bzx, PMLComp::zx);
-    solver.BackwardTransform(lev, *pml_B[2], Idx.Bzy, PMLComp::zy);
-
-    // WarpX::do_pml_dive_cleaning = true
-    if (pml_F)
-    {
-        solver.BackwardTransform(lev, *pml_E[0], Idx.Exx, PMLComp::xx);
-        solver.BackwardTransform(lev, *pml_E[1], Idx.Eyy, PMLComp::yy);
-        solver.BackwardTransform(lev, *pml_E[2], Idx.Ezz, PMLComp::zz);
-        solver.BackwardTransform(lev, *pml_F, Idx.Fx, PMLComp::x);
-        solver.BackwardTransform(lev, *pml_F, Idx.Fy, PMLComp::y);
-        solver.BackwardTransform(lev, *pml_F, Idx.Fz, PMLComp::z);
-    }
-
-    // WarpX::do_pml_divb_cleaning = true
-    if (pml_G)
-    {
-        solver.BackwardTransform(lev, *pml_B[0], Idx.Bxx, PMLComp::xx);
-        solver.BackwardTransform(lev, *pml_B[1], Idx.Byy, PMLComp::yy);
-        solver.BackwardTransform(lev, *pml_B[2], Idx.Bzz, PMLComp::zz);
-        solver.BackwardTransform(lev, *pml_G, Idx.Gx, PMLComp::x);
-        solver.BackwardTransform(lev, *pml_G, Idx.Gy, PMLComp::y);
-        solver.BackwardTransform(lev, *pml_G, Idx.Gz, PMLComp::z);
-    }
+    solver.BackwardTransform(lev, pml_comps);
 }
 #endif
@@ -12,6 +12,7 @@
 #   include "BoundaryConditions/PML_RZ.H"
 #endif
 #include "PML_current.H"
+#include "Utils/PhaseTimers.H"
 #include "Utils/WarpXProfilerWrapper.H"
 #include "WarpX_PML_kernels.H"
 
@@ -60,6 +61,7 @@ WarpX::DampPML (const int lev, PatchType patch_type)
     if (!do_pml) return;
 
     WARPX_PROFILE("WarpX::DampPML()");
+    PhaseTimers::Scope phase_timer(PhaseTimers::FieldSolve);
 #if (defined WARPX_DIM_RZ) && (defined WARPX_USE_PSATD)
     if (pml_rz[lev]) {
         pml_rz[lev]->ApplyDamping(Efield_fp[lev][1].get(), Efield_fp[lev][2].get(),
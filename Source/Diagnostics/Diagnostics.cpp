@@ -367,7 +367,7 @@ Diagnostics::InitBaseData ()
     }
     // Construct Flush class.
     if        (m_format == "plotfile"){
-        m_flush_format = std::make_unique<FlushFormatPlotfile>() ;
+        m_flush_format = std::make_unique<FlushFormatPlotfile>(m_diag_name) ;
     } else if (m_format == "checkpoint"){
         // creating checkpoint format
         m_flush_format = std::make_unique<FlushFormatCheckpoint>() ;
@@ -0,0 +1,83 @@
+/* Copyright 2022 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "AsyncFlushQueue.H"
+
+#include "Utils/TextMsg.H"
+
+#include <AMReX_BLassert.H>
+
+#include <utility>
+
+AsyncFlushQueue::AsyncFlushQueue (int max_in_flight)
+    : m_max_in_flight(max_in_flight)
+{
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_max_in_flight >= 1,
+        "the maximum number of in-flight asynchronous flushes must be at least 1");
+    m_thread = std::thread(&AsyncFlushQueue::Run, this);
+}
+
+AsyncFlushQueue::~AsyncFlushQueue ()
+{
+    Wait();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_job_submitted.notify_one();
+    m_thread.join();
+}
+
+void
+AsyncFlushQueue::WaitForCapacity ()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_job_done.wait(lock, [this]{ return m_in_flight < m_max_in_flight; });
+}
+
+void
+AsyncFlushQueue::Submit (std::function<void()> job)
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_job_done.wait(lock, [this]{ return m_in_flight < m_max_in_flight; });
+        m_jobs.push(std::move(job));
+        ++m_in_flight;
+    }
+    m_job_submitted.notify_one();
+}
+
+void
+AsyncFlushQueue::Wait ()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_job_done.wait(lock, [this]{ return m_in_flight == 0; });
+}
+
+void
+AsyncFlushQueue::Run ()
+{
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_job_submitted.wait(lock, [this]{ return m_stop || !m_jobs.empty(); });
+            if (m_jobs.empty()) return; // m_stop and nothing left to do
+            job = std::move(m_jobs.front());
+            m_jobs.pop();
+        }
+
+        // the job (and the snapshot data it owns) is released before it is marked as done
+        job();
+        job = nullptr;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_in_flight;
+        }
+        m_job_done.notify_all();
+    }
+}
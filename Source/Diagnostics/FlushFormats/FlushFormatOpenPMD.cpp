@@ -6,6 +6,7 @@
 
 #include <AMReX.H>
 #include <AMReX_BLassert.H>
+#include <AMReX_ParallelDescriptor.H>
 #include <AMReX_ParmParse.H>
 #include <AMReX_REAL.H>
 
@@ -93,13 +94,51 @@ FlushFormatOpenPMD::FlushFormatOpenPMD (const std::string& diag_name)
     engine_parameters.insert({k, v});
   }
 
+  // Asynchronous flush: the data is copied to host buffers and written by a background I/O thread
+  bool async_flush = false;
+  pp_diag_name.query("async_flush", async_flush);
+  int async_max_in_flight = 1;
+  pp_diag_name.query("async_max_in_flight", async_max_in_flight);
+  MPI_Comm comm = amrex::ParallelDescriptor::Communicator();
+  if (async_flush) {
+      WARPX_ALWAYS_ASSERT_WITH_MESSAGE(diag_type_str == "Full",
+          diag_name + ".async_flush is only supported for Full diagnostics");
+#ifdef AMREX_USE_MPI
+      // the I/O thread calls MPI (through openPMD-api) concurrently with the main thread
+      int thread_provided = -1;
+      MPI_Query_thread(&thread_provided);
+      WARPX_ALWAYS_ASSERT_WITH_MESSAGE(thread_provided == MPI_THREAD_MULTIPLE,
+          diag_name + ".async_flush requires MPI_THREAD_MULTIPLE support "
+          "(compile with -DWarpX_MPI_THREAD_MULTIPLE=ON)");
+      MPI_Comm_dup(amrex::ParallelDescriptor::Communicator(), &m_io_comm);
+      comm = m_io_comm;
+#endif
+  }
+
   auto & warpx = WarpX::GetInstance();
   m_OpenPMDPlotWriter = std::make_unique<WarpXOpenPMDPlot>(
     encoding, openpmd_backend,
     operator_type, operator_parameters,
     engine_type, engine_parameters,
-    warpx.getPMLdirections()
+    warpx.getPMLdirections(),
+    comm
   );
+
+  if (async_flush) {
+      m_flush_queue = std::make_unique<AsyncFlushQueue>(async_max_in_flight);
+  }
+}
+
+FlushFormatOpenPMD::~FlushFormatOpenPMD ()
+{
+    // complete the pending flushes and close the series before releasing their communicator
+    m_flush_queue.reset();
+    m_OpenPMDPlotWriter.reset();
+#ifdef AMREX_USE_MPI
+    if (m_io_comm != MPI_COMM_NULL) {
+        MPI_Comm_free(&m_io_comm);
+    }
+#endif
 }
 
 void
@@ -127,6 +166,18 @@ FlushFormatOpenPMD::WriteToFile (
     if( isBTD )
         output_iteration = snapshotID;
 
+    if (m_flush_queue) {
+        // copy the data now and write it on the I/O thread, while the simulation continues;
+        // wait first for a free slot, to bound the number of snapshots held in memory
+        m_flush_queue->WaitForCapacity();
+        auto snapshot = std::make_shared<OpenPMDSnapshot>(
+            m_OpenPMDPlotWriter->TakeSnapshot(varnames, mf, geom, output_levels, output_iteration,
+                                              time, particle_diags, prefix, file_min_digits));
+        WarpXOpenPMDPlot* const writer = m_OpenPMDPlotWriter.get();
+        m_flush_queue->Submit([writer, snapshot] () { writer->WriteSnapshot(*snapshot); });
+        return;
+    }
+
     // Set step and output directory name.
     m_OpenPMDPlotWriter->SetStep(output_iteration, prefix, file_min_digits, isBTD);
 
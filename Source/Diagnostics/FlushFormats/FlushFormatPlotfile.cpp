@@ -10,6 +10,7 @@
 #include "WarpX.H"
 
 #include <AMReX.H>
+#include <AMReX_AsyncOut.H>
 #include <AMReX_Box.H>
 #include <AMReX_BoxArray.H>
 #include <AMReX_Config.H>
@@ -48,6 +49,28 @@ using namespace amrex;
 namespace
 {
     const std::string default_level_prefix {"Level_"};
+
+    /** Number of plotfiles submitted to the AMReX I/O thread, by all the diagnostics,
+     *  since it was last drained with amrex::AsyncOut::Wait */
+    int num_async_plotfiles_in_flight = 0;
+}
+
+FlushFormatPlotfile::FlushFormatPlotfile (const std::string& diag_name)
+{
+    ParmParse pp_diag_name(diag_name);
+    pp_diag_name.query("async_flush", m_async_flush);
+    pp_diag_name.query("async_max_in_flight", m_async_max_in_flight);
+    if (m_async_flush) {
+        std::string diag_type_str;
+        pp_diag_name.get("diag_type", diag_type_str);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(diag_type_str == "Full",
+            diag_name + ".async_flush is only supported for Full diagnostics");
+        // the field and particle data are copied and written by the AMReX I/O thread
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(amrex::AsyncOut::UseAsyncOut(),
+            diag_name + ".async_flush requires amrex.async_out=1 for plotfiles");
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_async_max_in_flight >= 1,
+            diag_name + ".async_max_in_flight must be at least 1");
+    }
 }
 
 void
@@ -67,6 +90,16 @@ FlushFormatPlotfile::WriteToFile (
     const std::string& filename = amrex::Concatenate(prefix, iteration[0], file_min_digits);
     amrex::Print() << Utils::TextMsg::Info("Writing plotfile " + filename);
 
+    if (m_async_flush) {
+        // bound the number of plotfiles held in memory by the AMReX I/O thread;
+        // AsyncOut::Wait drains the plotfiles of all the diagnostics, hence the global counter
+        if (num_async_plotfiles_in_flight >= m_async_max_in_flight) {
+            amrex::AsyncOut::Wait();
+            num_async_plotfiles_in_flight = 0;
+        }
+        ++num_async_plotfiles_in_flight;
+    }
+
     Vector<std::string> rfs;
     VisMF::Header::Version current_version = VisMF::GetHeaderVersion();
     VisMF::SetHeaderVersion(amrex::VisMF::Header::Version_v1);
@@ -95,6 +95,15 @@ MultiDiagnostics::FilterComputePackFlushLastTimestep (int step)
     }
 }
 
+bool
+MultiDiagnostics::DoCheckpoint (int step)
+{
+    for (auto& diag : alldiags){
+        if (diag->IsCheckpoint() && diag->DoComputeAndPack(step)) return true;
+    }
+    return false;
+}
+
 void
 MultiDiagnostics::NewIteration ()
 {
@@ -320,89 +320,112 @@ void BeamRelevant::ComputeDiags (int step)
             },
             reduce_ops2);
 
-        std::vector<ParticleReal> values_per_rank_2nd = {
-            amrex::get<0>(r2), // x_ms
-            amrex::get<1>(r2), // y_ms
-            amrex::get<2>(r2), // z_ms
-            amrex::get<3>(r2), // ux_ms
-            amrex::get<4>(r2), // uy_ms
-            amrex::get<5>(r2), // uz_ms
-            amrex::get<6>(r2), // gm_ms
-            amrex::get<7>(r2), // xux
-            amrex::get<8>(r2), // yuy
-            amrex::get<9>(r2), // zuz
-            amrex::get<10>(r2) // charge
-        };
+        // save the local sums: the reduced sum over mpi ranks is deferred to
+        // MultiReducedDiags, and the output data is computed in FinalizeDiags
+        m_moments.resize(11);
+        m_moments[0] = amrex::get<0>(r2); // x_ms
+        m_moments[1] = amrex::get<1>(r2); // y_ms
+        m_moments[2] = amrex::get<2>(r2); // z_ms
+        m_moments[3] = amrex::get<3>(r2); // ux_ms
+        m_moments[4] = amrex::get<4>(r2); // uy_ms
+        m_moments[5] = amrex::get<5>(r2); // uz_ms
+        m_moments[6] = amrex::get<6>(r2); // gm_ms
+        m_moments[7] = amrex::get<7>(r2); // xux
+        m_moments[8] = amrex::get<8>(r2); // yuy
+        m_moments[9] = amrex::get<9>(r2); // zuz
+        m_moments[10] = amrex::get<10>(r2); // charge
+        m_means.resize(7);
+        m_means[0] = x_mean;
+        m_means[1] = y_mean;
+        m_means[2] = z_mean;
+        m_means[3] = ux_mean;
+        m_means[4] = uy_mean;
+        m_means[5] = uz_mean;
+        m_means[6] = gm_mean;
+        m_w_sum = w_sum;
+        m_mass = m;
+        DeferReduction(m_moments.data(), static_cast<int>(m_moments.size()), ReduceOp::Sum);
+    }
+    // end loop over species
+}
+// end void BeamRelevant::ComputeDiags
 
-        // reduced sum over mpi ranks (reduce to IO rank)
-        ParallelDescriptor::ReduceRealSum
-        ( values_per_rank_2nd.data(), values_per_rank_2nd.size(), ParallelDescriptor::IOProcessorNumber());
-
-        ParticleReal x_ms   = values_per_rank_2nd.at(0) /= w_sum;
-        ParticleReal y_ms   = values_per_rank_2nd.at(1) /= w_sum;
-        ParticleReal z_ms   = values_per_rank_2nd.at(2) /= w_sum;
-        ParticleReal ux_ms  = values_per_rank_2nd.at(3) /= w_sum;
-        ParticleReal uy_ms  = values_per_rank_2nd.at(4) /= w_sum;
-        ParticleReal uz_ms  = values_per_rank_2nd.at(5) /= w_sum;
-        ParticleReal gm_ms  = values_per_rank_2nd.at(6) /= w_sum;
-        ParticleReal xux    = values_per_rank_2nd.at(7) /= w_sum;
-        ParticleReal yuy    = values_per_rank_2nd.at(8) /= w_sum;
-        ParticleReal zuz    = values_per_rank_2nd.at(9) /= w_sum;
-        ParticleReal charge = values_per_rank_2nd.at(10);
-
-        // save data
+void BeamRelevant::FinalizeDiags (int /*step*/)
+{
+    Real const w_sum = m_w_sum;
+    Real const m = m_mass;
+
+    Real const x_mean  = m_means[0];
+    Real const y_mean  = m_means[1];
+    Real const z_mean  = m_means[2];
+    Real const ux_mean = m_means[3];
+    Real const uy_mean = m_means[4];
+    Real const uz_mean = m_means[5];
+    Real const gm_mean = m_means[6];
+
+    Real const x_ms   = m_moments[0] / w_sum;
+    Real const y_ms   = m_moments[1] / w_sum;
+    Real const z_ms   = m_moments[2] / w_sum;
+    Real const ux_ms  = m_moments[3] / w_sum;
+    Real const uy_ms  = m_moments[4] / w_sum;
+    Real const uz_ms  = m_moments[5] / w_sum;
+    Real const gm_ms  = m_moments[6] / w_sum;
+    Real const xux    = m_moments[7] / w_sum;
+    Real const yuy    = m_moments[8] / w_sum;
+    Real const zuz    = m_moments[9] / w_sum;
+    Real const charge = m_moments[10];
+
+    // save data
 #if (defined WARPX_DIM_3D || defined WARPX_DIM_RZ)
-        m_data[0]  = x_mean;
-        m_data[1]  = y_mean;
-        m_data[2]  = z_mean;
-        m_data[3]  = ux_mean * m;
-        m_data[4]  = uy_mean * m;
-        m_data[5]  = uz_mean * m;
-        m_data[6]  = gm_mean;
-        m_data[7]  = std::sqrt(x_ms);
-        m_data[8]  = std::sqrt(y_ms);
-        m_data[9]  = std::sqrt(z_ms);
-        m_data[10] = std::sqrt(ux_ms) * m;
-        m_data[11] = std::sqrt(uy_ms) * m;
-        m_data[12] = std::sqrt(uz_ms) * m;
-        m_data[13] = std::sqrt(gm_ms);
-        m_data[14] = std::sqrt(x_ms*ux_ms-xux*xux) / PhysConst::c;
-        m_data[15] = std::sqrt(y_ms*uy_ms-yuy*yuy) / PhysConst::c;
-        m_data[16] = std::sqrt(z_ms*uz_ms-zuz*zuz) / PhysConst::c;
-        m_data[17] = charge;
+    m_data[0]  = x_mean;
+    m_data[1]  = y_mean;
+    m_data[2]  = z_mean;
+    m_data[3]  = ux_mean * m;
+    m_data[4]  = uy_mean * m;
+    m_data[5]  = uz_mean * m;
+    m_data[6]  = gm_mean;
+    m_data[7]  = std::sqrt(x_ms);
+    m_data[8]  = std::sqrt(y_ms);
+    m_data[9]  = std::sqrt(z_ms);
+    m_data[10] = std::sqrt(ux_ms) * m;
+    m_data[11] = std::sqrt(uy_ms) * m;
+    m_data[12] = std::sqrt(uz_ms) * m;
+    m_data[13] = std::sqrt(gm_ms);
+    m_data[14] = std::sqrt(x_ms*ux_ms-xux*xux) / PhysConst::c;
+    m_data[15] = std::sqrt(y_ms*uy_ms-yuy*yuy) / PhysConst::c;
+    m_data[16] = std::sqrt(z_ms*uz_ms-zuz*zuz) / PhysConst::c;
+    m_data[17] = charge;
 #elif (defined WARPX_DIM_XZ)
-        m_data[0]  = x_mean;
-        m_data[1]  = z_mean;
-        m_data[2]  = ux_mean * m;
-        m_data[3]  = uy_mean * m;
-        m_data[4]  = uz_mean * m;
-        m_data[5]  = gm_mean;
-        m_data[6]  = std::sqrt(x_ms);
-        m_data[7]  = std::sqrt(z_ms);
-        m_data[8]  = std::sqrt(ux_ms) * m;
-        m_data[9]  = std::sqrt(uy_ms) * m;
-        m_data[10] = std::sqrt(uz_ms) * m;
-        m_data[11] = std::sqrt(gm_ms);
-        m_data[12] = std::sqrt(x_ms*ux_ms-xux*xux) / PhysConst::c;
-        m_data[13] = std::sqrt(z_ms*uz_ms-zuz*zuz) / PhysConst::c;
-        m_data[14] = charge;
-        amrex::ignore_unused(y_mean, y_ms, yuy);
+    m_data[0]  = x_mean;
+    m_data[1]  = z_mean;
+    m_data[2]  = ux_mean * m;
+    m_data[3]  = uy_mean * m;
+    m_data[4]  = uz_mean * m;
+    m_data[5]  = gm_mean;
+    m_data[6]  = std::sqrt(x_ms);
+    m_data[7]  = std::sqrt(z_ms);
+    m_data[8]  = std::sqrt(ux_ms) * m;
+    m_data[9]  = std::sqrt(uy_ms) * m;
+    m_data[10] = std::sqrt(uz_ms) * m;
+    m_data[11] = std::sqrt(gm_ms);
+    m_data[12] = std::sqrt(x_ms*ux_ms-xux*xux) / PhysConst::c;
+    m_data[13] = std::sqrt(z_ms*uz_ms-zuz*zuz) / PhysConst::c;
+    m_data[14] = charge;
+    amrex::ignore_unused(y_mean, y_ms, yuy);
 #elif (defined WARPX_DIM_1D_Z)
-        m_data[0]  = z_mean;
-        m_data[1]  = ux_mean * m;
-        m_data[2]  = uy_mean * m;
-        m_data[3]  = uz_mean * m;
-        m_data[4]  = gm_mean;
-        m_data[5]  = std::sqrt(z_ms);
-        m_data[6]  = std::sqrt(ux_ms) * m;
-        m_data[7]  = std::sqrt(uy_ms) * m;
-        m_data[8] = std::sqrt(uz_ms) * m;
-        m_data[9] = std::sqrt(gm_ms);
-        m_data[10] = std::sqrt(z_ms*uz_ms-zuz*zuz) / PhysConst::c;
-        m_data[11] = charge;
-        amrex::ignore_unused(x_mean, x_ms, xux, y_mean, y_ms, yuy);
+    m_data[0]  = z_mean;
+    m_data[1]  = ux_mean * m;
+    m_data[2]  = uy_mean * m;
+    m_data[3]  = uz_mean * m;
+    m_data[4]  = gm_mean;
+    m_data[5]  = std::sqrt(z_ms);
+    m_data[6]  = std::sqrt(ux_ms) * m;
+    m_data[7]  = std::sqrt(uy_ms) * m;
+    m_data[8] = std::sqrt(uz_ms) * m;
+    m_data[9] = std::sqrt(gm_ms);
+    m_data[10] = std::sqrt(z_ms*uz_ms-zuz*zuz) / PhysConst::c;
+    m_data[11] = charge;
+    amrex::ignore_unused(x_mean, x_ms, xux, y_mean, y_ms, yuy);
 #endif
-    }
-    // end loop over species
 }
-// end void BeamRelevant::ComputeDiags
+// end void BeamRelevant::FinalizeDiags
@@ -19,9 +19,11 @@
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_ParmParse.H>
 #include <AMReX_REAL.H>
+#include <AMReX_iMultiFab.H>
 
 #include <algorithm>
 #include <fstream>
+#include <memory>
 #include <vector>
 
 using namespace amrex;
@@ -75,6 +77,14 @@ FieldEnergy::FieldEnergy (std::string rd_name)
 }
 // end constructor
 
+// function that computes the squared L2 norm of the local data of a MultiFab
+Real FieldEnergy::LocalNorm2Squared (const MultiFab& mf, const Geometry& geom)
+{
+    // count the points shared by several boxes (nodal data, periodic boundaries) only once
+    const auto mask = mf.OwnerMask(geom.periodicity());
+    return MultiFab::Dot(*mask, mf, 0, mf, 0, 1, 0, true);
+}
+
 // function that computes field energy
 void FieldEnergy::ComputeDiags (int step)
 {
@@ -108,17 +118,12 @@ void FieldEnergy::ComputeDiags (int step)
         auto dV = geom.CellSize(0) * geom.CellSize(1) * geom.CellSize(2);
 #endif
 
-        // compute E squared
-        Real const tmpEx = Ex.norm2(0,geom.periodicity());
-        Real const tmpEy = Ey.norm2(0,geom.periodicity());
-        Real const tmpEz = Ez.norm2(0,geom.periodicity());
-        Real const Es = tmpEx*tmpEx + tmpEy*tmpEy + tmpEz*tmpEz;
-
-        // compute B squared
-        Real const tmpBx = Bx.norm2(0,geom.periodicity());
-        Real const tmpBy = By.norm2(0,geom.periodicity());
-        Real const tmpBz = Bz.norm2(0,geom.periodicity());
-        Real const Bs = tmpBx*tmpBx + tmpBy*tmpBy + tmpBz*tmpBz;
+        // compute E squared and B squared, summed over the data owned by this MPI rank
+        // (the reduction over MPI ranks is deferred, see below)
+        Real const Es = LocalNorm2Squared(Ex, geom) + LocalNorm2Squared(Ey, geom) +
+                        LocalNorm2Squared(Ez, geom);
+        Real const Bs = LocalNorm2Squared(Bx, geom) + LocalNorm2Squared(By, geom) +
+                        LocalNorm2Squared(Bz, geom);
 
         constexpr int noutputs = 3; // total energy, E-field energy and B-field energy
         constexpr int index_total = 0;
@@ -133,7 +138,10 @@ void FieldEnergy::ComputeDiags (int step)
     }
     // end loop over refinement levels
 
-    /* m_data now contains up-to-date values for:
+    // Reduced sum over MPI ranks, deferred to MultiReducedDiags
+    DeferReduction(m_data.data(), static_cast<int>(nLevel)*3, ReduceOp::Sum);
+
+    /* once the reduction has completed, m_data contains up-to-date values for:
      *  [total field energy at level 0,
      *   electric field energy at level 0,
      *   magnetic field energy at level 0,
@@ -265,17 +265,8 @@ void FieldMaximum::ComputeDiags (int step)
         Real hv_E = amrex::get<0>(reduceE_data.value()); // highest value of |E|**2
         Real hv_B = amrex::get<0>(reduceB_data.value()); // highest value of |B|**2
 
-        // MPI reduce
-        ParallelDescriptor::ReduceRealMax(hv_Ex);
-        ParallelDescriptor::ReduceRealMax(hv_Ey);
-        ParallelDescriptor::ReduceRealMax(hv_Ez);
-        ParallelDescriptor::ReduceRealMax(hv_Bx);
-        ParallelDescriptor::ReduceRealMax(hv_By);
-        ParallelDescriptor::ReduceRealMax(hv_Bz);
-        ParallelDescriptor::ReduceRealMax(hv_E);
-        ParallelDescriptor::ReduceRealMax(hv_B);
-
-        // Fill output array
+        // Fill output array with the local maxima
+        // (the MPI reduction is deferred, see below)
         m_data[lev*noutputs+index_Ex] = hv_Ex;
         m_data[lev*noutputs+index_Ey] = hv_Ey;
         m_data[lev*noutputs+index_Ez] = hv_Ez;
@@ -287,7 +278,11 @@ void FieldMaximum::ComputeDiags (int step)
     }
     // end loop over refinement levels
 
-    /* m_data now contains up-to-date values for:
+    // MPI reduce, deferred to MultiReducedDiags
+    // (the maximum of sqrt(|E|**2) is the square root of the maximum of |E|**2)
+    DeferReduction(m_data.data(), static_cast<int>(nLevel)*8, ReduceOp::Max);
+
+    /* once the reduction has completed, m_data contains up-to-date values for:
      *  [max(Ex),max(Ey),max(Ez),max(|E|),
      *   max(Bx),max(By),max(Bz),max(|B|)] */
 }
@@ -175,14 +175,11 @@ void FieldMomentum::ComputeDiags (int step)
                 });
         }
 
-        // MPI reduce
+        // Local sum (the MPI reduction is deferred, see below)
         auto r = reduce_data.value();
         amrex::Real ExB_x = amrex::get<0>(r);
         amrex::Real ExB_y = amrex::get<1>(r);
         amrex::Real ExB_z = amrex::get<2>(r);
-        amrex::ParallelDescriptor::ReduceRealSum(ExB_x);
-        amrex::ParallelDescriptor::ReduceRealSum(ExB_y);
-        amrex::ParallelDescriptor::ReduceRealSum(ExB_z);
 
         // Get cell size
         amrex::Geometry const & geom = warpx.Geom(lev);
@@ -200,4 +197,7 @@ void FieldMomentum::ComputeDiags (int step)
         m_data[offset+1] = PhysConst::ep0 * ExB_y * dV;
         m_data[offset+2] = PhysConst::ep0 * ExB_z * dV;
     }
+
+    // MPI reduce, deferred to MultiReducedDiags
+    DeferReduction(m_data.data(), static_cast<int>(nLevel)*3, ReduceOp::Sum);
 }
@@ -56,6 +56,10 @@ FieldProbe::FieldProbe (std::string rd_name)
         "FieldProbe reduced diagnostics does not work for RZ coordinate.");
 #endif
 
+    // several output rows (one per probe particle) are written per step
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_format == "text",
+        "FieldProbe reduced diagnostics only supports format = text");
+
     // read number of levels
     int nLevel = 0;
     amrex::ParmParse pp_amr("amr");
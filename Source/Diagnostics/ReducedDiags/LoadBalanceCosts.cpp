@@ -9,6 +9,7 @@
 #include "Diagnostics/ReducedDiags/ReducedDiags.H"
 #include "Particles/MultiParticleContainer.H"
 #include "Utils/IntervalsParser.H"
+#include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "WarpX.H"
 
@@ -68,6 +69,9 @@ namespace
 LoadBalanceCosts::LoadBalanceCosts (std::string rd_name)
     : ReducedDiags{rd_name}
 {
+    // the number of output columns varies with the number of boxes
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_format == "text",
+        "LoadBalanceCosts reduced diagnostics only supports format = text");
 }
 
 // function that gathers costs
@@ -103,7 +107,7 @@ void LoadBalanceCosts::ComputeDiags (int step)
     m_data.resize(dataSize, 0.0_rt);
     m_data.assign(dataSize, 0.0_rt);
 
-    // read in WarpX costs to local copy; compute if using `Heuristic` update
+    // read in WarpX costs to local copy; compute if using `Heuristic` or `Calibrated` update
     amrex::Vector<std::unique_ptr<amrex::LayoutData<amrex::Real> > > costs;
 
     costs.resize(nLevels);
@@ -116,6 +120,10 @@ void LoadBalanceCosts::ComputeDiags (int step)
     {
         warpx.ComputeCostsHeuristic(costs);
     }
+    else if (warpx.load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Calibrated)
+    {
+        warpx.ComputeCostsCalibrated(costs);
+    }
 
     // keep track of correct index in array over all boxes on all levels
     // shift index for m_data
@@ -30,8 +30,13 @@ LoadBalanceEfficiency::LoadBalanceEfficiency (std::string rd_name)
     pp_amr.query("max_level", nLevel);
     nLevel += 1;
 
+    // with predictive load balancing, also write the expected and
+    // actual efficiency over the last load balancing interval
+    ParmParse pp_algo("algo");
+    pp_algo.query("load_balance_predictive", m_predictive);
+
     // resize data array
-    m_data.resize(nLevel, 0.0_rt);
+    m_data.resize((m_predictive) ? 3*nLevel : nLevel, 0.0_rt);
 
     if (ParallelDescriptor::IOProcessor())
     {
@@ -51,6 +56,16 @@ LoadBalanceEfficiency::LoadBalanceEfficiency (std::string rd_name)
                 ofs << m_sep;
                 ofs << "[" << c++ << "]lev" + std::to_string(lev);
             }
+            if (m_predictive)
+            {
+                for (int lev = 0; lev < nLevel; ++lev)
+                {
+                    ofs << m_sep;
+                    ofs << "[" << c++ << "]lev" + std::to_string(lev) + "_expected";
+                    ofs << m_sep;
+                    ofs << "[" << c++ << "]lev" + std::to_string(lev) + "_actual";
+                }
+            }
             ofs << std::endl;
 
             // close file
@@ -76,6 +91,13 @@ void LoadBalanceEfficiency::ComputeDiags (int step)
     {
         // save data
         m_data[lev] = warpx.getLoadBalanceEfficiency(lev);
+
+        if (m_predictive)
+        {
+            const int nLevelMax = static_cast<int>(m_data.size())/3;
+            m_data[nLevelMax + 2*lev] = warpx.getLoadBalanceExpectedEfficiency(lev);
+            m_data[nLevelMax + 2*lev + 1] = warpx.getLoadBalanceActualEfficiency(lev);
+        }
     }
     // end loop over refinement levels
 
@@ -83,5 +105,9 @@ void LoadBalanceEfficiency::ComputeDiags (int step)
      *  [load balance efficiency at level 0,
      *   load balance efficiency at level 1,
      *   load balance efficiency at level 2,
+     *   ......]
+     * followed, with predictive load balancing, by:
+     *  [expected efficiency at level 0, actual efficiency at level 0,
+     *   expected efficiency at level 1, actual efficiency at level 1,
      *   ......] */
 }
@@ -19,9 +19,13 @@
 #include "ParticleHistogram.H"
 #include "ParticleMomentum.H"
 #include "ParticleNumber.H"
+#include "PhaseSpaceHistogram.H"
+#include "PhaseTimings.H"
+#include "PoissonSolverStats.H"
 #include "RhoMaximum.H"
 #include "Utils/IntervalsParser.H"
 #include "Utils/WarpXProfilerWrapper.H"
+#include "WarpX.H"
 
 #include <AMReX.H>
 #include <AMReX_ParallelDescriptor.H>
@@ -32,6 +36,7 @@
 #include <functional>
 #include <iterator>
 #include <map>
+#include <tuple>
 
 using namespace amrex;
 
@@ -60,8 +65,11 @@ MultiReducedDiags::MultiReducedDiags ()
             {"LoadBalanceCosts",      [](CS s){return std::make_unique<LoadBalanceCosts>(s);}},
             {"LoadBalanceEfficiency", [](CS s){return std::make_unique<LoadBalanceEfficiency>(s);}},
             {"ParticleHistogram",     [](CS s){return std::make_unique<ParticleHistogram>(s);}},
+            {"PhaseSpaceHistogram",   [](CS s){return std::make_unique<PhaseSpaceHistogram>(s);}},
+            {"PhaseTimings",          [](CS s){return std::make_unique<PhaseTimings>(s);}},
             {"ParticleNumber",        [](CS s){return std::make_unique<ParticleNumber>(s);}},
-            {"ParticleExtrema",       [](CS s){return std::make_unique<ParticleExtrema>(s);}}
+            {"ParticleExtrema",       [](CS s){return std::make_unique<ParticleExtrema>(s);}},
+            {"PoissonSolverStats",    [](CS s){return std::make_unique<PoissonSolverStats>(s);}}
         };
     // loop over all reduced diags and fill m_multi_rd with requested reduced diags
     std::transform(m_rd_names.begin(), m_rd_names.end(), std::back_inserter(m_multi_rd),
@@ -103,15 +111,92 @@ void MultiReducedDiags::ComputeDiags (int step)
 {
     WARPX_PROFILE("MultiReducedDiags::ComputeDiags()");
 
+    // complete the reductions started at the previous call
+    CompleteDeferredReductions();
+
+    const Real time = WarpX::GetInstance().gett_new(0);
+
     // loop over all reduced diags
     for (int i_rd = 0; i_rd < static_cast<int>(m_rd_names.size()); ++i_rd)
     {
+        m_multi_rd[i_rd] -> m_time = time;
         m_multi_rd[i_rd] -> ComputeDiags(step);
     }
     // end loop over all reduced diags
+
+    // start the reductions deferred by the reduced diags
+    StartDeferredReductions(step);
 }
 // end void MultiReducedDiags::ComputeDiags
 
+void MultiReducedDiags::StartDeferredReductions (int step)
+{
+    WARPX_PROFILE("MultiReducedDiags::StartDeferredReductions()");
+
+    // pack the local data, for each reduction operation
+    for (auto& buffer : m_deferred_buffers) { buffer.clear(); }
+    for (const auto& rd : m_multi_rd)
+    {
+        for (const auto& [data, n, op] : rd->m_deferred_reductions)
+        {
+            auto& buffer = m_deferred_buffers[static_cast<int>(op)];
+            buffer.insert(buffer.end(), data, data + n);
+            m_has_deferred_reductions = true;
+        }
+    }
+    if (!m_has_deferred_reductions) { return; }
+    m_deferred_step = step;
+
+#ifdef AMREX_USE_MPI
+    // start one non-blocking reduction per operation
+    const std::array<MPI_Op, m_num_reduce_ops> mpi_ops = {MPI_SUM, MPI_MAX, MPI_MIN};
+    for (int i_op = 0; i_op < m_num_reduce_ops; ++i_op)
+    {
+        m_deferred_requests[i_op] = MPI_REQUEST_NULL;
+        if (m_deferred_buffers[i_op].empty()) { continue; }
+        MPI_Iallreduce(MPI_IN_PLACE, m_deferred_buffers[i_op].data(),
+                       static_cast<int>(m_deferred_buffers[i_op].size()),
+                       ParallelDescriptor::Mpi_typemap<Real>::type(), mpi_ops[i_op],
+                       ParallelDescriptor::Communicator(), &m_deferred_requests[i_op]);
+    }
+#endif
+}
+
+void MultiReducedDiags::CompleteDeferredReductions ()
+{
+    if (!m_has_deferred_reductions) { return; }
+
+    WARPX_PROFILE("MultiReducedDiags::CompleteDeferredReductions()");
+
+#ifdef AMREX_USE_MPI
+    MPI_Waitall(m_num_reduce_ops, m_deferred_requests.data(), MPI_STATUSES_IGNORE);
+#endif
+
+    // unpack the reduced data, in the same order as it was packed
+    std::array<std::size_t, m_num_reduce_ops> offsets = {0, 0, 0};
+    for (const auto& rd : m_multi_rd)
+    {
+        for (const auto& [data, n, op] : rd->m_deferred_reductions)
+        {
+            const int i_op = static_cast<int>(op);
+            const auto begin = m_deferred_buffers[i_op].begin() + offsets[i_op];
+            std::copy(begin, begin + n, data);
+            offsets[i_op] += n;
+        }
+    }
+
+    // compute and write the output data of the reduced diags
+    for (const auto& rd : m_multi_rd)
+    {
+        if (rd->m_deferred_reductions.empty()) { continue; }
+        rd->m_deferred_reductions.clear();
+        rd->FinalizeDiags(m_deferred_step);
+        if (ParallelDescriptor::IOProcessor()) { rd->WriteToFile(m_deferred_step); }
+    }
+
+    m_has_deferred_reductions = false;
+}
+
 // function to write data
 void MultiReducedDiags::WriteToFile (int step)
 {
@@ -124,9 +209,20 @@ void MultiReducedDiags::WriteToFile (int step)
         // Judge if the diags should be done
         if (!m_multi_rd[i_rd]->m_intervals.contains(step+1)) { continue; }
 
+        // Diags waiting for deferred reductions are written once they complete
+        if (!m_multi_rd[i_rd]->m_deferred_reductions.empty()) { continue; }
+
         // call the write to file function
         m_multi_rd[i_rd]->WriteToFile(step);
     }
     // end loop over all reduced diags
 }
 // end void MultiReducedDiags::WriteToFile
+
+void MultiReducedDiags::FlushToFile ()
+{
+    // Only the I/O rank does
+    if ( !ParallelDescriptor::IOProcessor() ) { return; }
+
+    for (const auto& rd : m_multi_rd) { rd->FlushToFile(); }
+}
@@ -49,6 +49,7 @@ ParticleEnergy::ParticleEnergy (std::string rd_name)
 
     // resize data array
     m_data.resize(2*nSpecies+2, 0.0_rt);
+    m_weights.resize(nSpecies, 0.0_rt);
 
     // get species names (std::vector<std::string>)
     const auto species_names = mypc.GetSpeciesNames();
@@ -100,11 +101,6 @@ void ParticleEnergy::ComputeDiags (int step)
     // Get number of species
     const int nSpecies = mypc.nSpecies();
 
-    // Some useful offsets to fill m_data below
-    int offset_total_species, offset_mean_species, offset_mean_all;
-
-    amrex::Real Wtot = 0.0_rt;
-
     // Loop over species
     for (int i_s = 0; i_s < nSpecies; ++i_s)
     {
@@ -159,20 +155,42 @@ void ParticleEnergy::ComputeDiags (int step)
             Ws   = amrex::get<1>(r);
         }
 
-        // Reduced sum over MPI ranks
-        ParallelDescriptor::ReduceRealSum(Etot, ParallelDescriptor::IOProcessorNumber());
-        ParallelDescriptor::ReduceRealSum(Ws  , ParallelDescriptor::IOProcessorNumber());
+        // Save local results for this species i_s into m_data and m_weights.
+        // Offset:
+        // 1 value of total energy for all  species +
+        // 1 value of total energy for each species
+        m_data[1 + i_s] = Etot;
+        m_weights[i_s] = Ws;
+    }
+
+    // Reduced sum over MPI ranks, deferred to MultiReducedDiags
+    DeferReduction(m_data.data() + 1, nSpecies, ReduceOp::Sum);
+    DeferReduction(m_weights.data(), nSpecies, ReduceOp::Sum);
+}
+// end void ParticleEnergy::ComputeDiags
+
+void ParticleEnergy::FinalizeDiags (int /*step*/)
+{
+    // Get number of species
+    const int nSpecies = static_cast<int>(m_weights.size());
+
+    // Some useful offsets to fill m_data below
+    int offset_total_species, offset_mean_species, offset_mean_all;
+
+    amrex::Real Wtot = 0.0_rt;
+
+    // Loop over species
+    for (int i_s = 0; i_s < nSpecies; ++i_s)
+    {
+        const amrex::Real Ws = m_weights[i_s];
 
         // Accumulate sum of weights over all species (must come after MPI reduction of Ws)
         Wtot += Ws;
 
-        // Save results for this species i_s into m_data
-
         // Offset:
         // 1 value of total energy for all  species +
         // 1 value of total energy for each species
         offset_total_species = 1 + i_s;
-        m_data[offset_total_species] = Etot;
 
         // Offset:
         // 1 value of total energy for all  species +
@@ -182,7 +200,7 @@ void ParticleEnergy::ComputeDiags (int step)
         offset_mean_species = 1 + nSpecies + 1 + i_s;
         if (Ws > std::numeric_limits<Real>::min())
         {
-            m_data[offset_mean_species] = Etot / Ws;
+            m_data[offset_mean_species] = m_data[offset_total_species] / Ws;
         }
         else
         {
@@ -226,3 +244,4 @@ void ParticleEnergy::ComputeDiags (int step)
     //  ...
     //  mean  energy (species n)]
 }
+// end void ParticleEnergy::FinalizeDiags
@@ -212,14 +212,12 @@ void ParticleExtrema::ComputeDiags (int step)
         Real xmin = ReduceMin( myspc,
         [=] AMREX_GPU_HOST_DEVICE (const PType& p)
         { return p.pos(0)*std::cos(p.rdata(PIdx::theta)); });
-        ParallelDescriptor::ReduceRealMin(xmin);
 #elif (defined WARPX_DIM_1D_Z)
         Real xmin = 0.0_rt;
 #else
         Real xmin = ReduceMin( myspc,
         [=] AMREX_GPU_HOST_DEVICE (const PType& p)
         { return p.pos(0); });
-        ParallelDescriptor::ReduceRealMin(xmin);
 #endif
 
         // xmax
@@ -227,14 +225,12 @@ void ParticleExtrema::ComputeDiags (int step)
         Real xmax = ReduceMax( myspc,
         [=] AMREX_GPU_HOST_DEVICE (const PType& p)
         { return p.pos(0)*std::cos(p.rdata(PIdx::theta)); });
-        ParallelDescriptor::ReduceRealMax(xmax);
 #elif (defined WARPX_DIM_1D_Z)
         Real xmax = 0.0_rt;
 #else
         Real xmax = ReduceMax( myspc,
         [=] AMREX_GPU_HOST_DEVICE (const PType& p)
         { return p.pos(0); });
-        ParallelDescriptor::ReduceRealMax(xmax);
 #endif
 
         // ymin
@@ -242,14 +238,12 @@ void ParticleExtrema::ComputeDiags (int step)
         Real ymin = ReduceMin( myspc,
         [=] AMREX_GPU_HOST_DEVICE (const PType& p)
         { return p.pos(0)*std::sin(p.rdata(PIdx::theta)); });
-        ParallelDescriptor::ReduceRealMin(ymin);
 #elif (defined WARPX_DIM_XZ || WARPX_DIM_1D_Z)
         Real ymin = 0.0_rt;
 #else
         Real ymin = ReduceMin( myspc,
         [=] AMREX_GPU_HOST_DEVICE (const PType& p)
         { return p.pos(1); });
-        ParallelDescriptor::ReduceRealMin(ymin);
 #endif
 
         // ymax
@@ -257,63 +251,53 @@ void ParticleExtrema::ComputeDiags (int step)
         Real ymax = ReduceMax( myspc,
         [=] AMREX_GPU_HOST_DEVICE (const PType& p)
         { return p.pos(0)*std::sin(p.rdata(PIdx::theta)); });
-        ParallelDescriptor::ReduceRealMax(ymax);
 #elif (defined WARPX_DIM_XZ || WARPX_DIM_1D_Z)
         Real ymax = 0.0_rt;
 #else
         Real ymax = ReduceMax( myspc,
         [=] AMREX_GPU_HOST_DEVICE (const PType& p)
         { return p.pos(1); });
-        ParallelDescriptor::ReduceRealMax(ymax);
 #endif
 
         // zmin
         Real zmin = ReduceMin( myspc,
         [=] AMREX_GPU_HOST_DEVICE (const PType& p)
         { return p.pos(index_z); });
-        ParallelDescriptor::ReduceRealMin(zmin);
 
         // zmax
         Real zmax = ReduceMax( myspc,
         [=] AMREX_GPU_HOST_DEVICE (const PType& p)
         { return p.pos(index_z); });
-        ParallelDescriptor::ReduceRealMax(zmax);
 
         // uxmin
         Real uxmin = ReduceMin( myspc,
         [=] AMREX_GPU_HOST_DEVICE (const PType& p)
         { return p.rdata(PIdx::ux); });
-        ParallelDescriptor::ReduceRealMin(uxmin);
 
         // uxmax
         Real uxmax = ReduceMax( myspc,
         [=] AMREX_GPU_HOST_DEVICE (const PType& p)
         { return p.rdata(PIdx::ux); });
-        ParallelDescriptor::ReduceRealMax(uxmax);
 
         // uymin
         Real uymin = ReduceMin( myspc,
         [=] AMREX_GPU_HOST_DEVICE (const PType& p)
         { return p.rdata(PIdx::uy); });
-        ParallelDescriptor::ReduceRealMin(uymin);
 
         // uymax
         Real uymax = ReduceMax( myspc,
         [=] AMREX_GPU_HOST_DEVICE (const PType& p)
         { return p.rdata(PIdx::uy); });
-        ParallelDescriptor::ReduceRealMax(uymax);
 
         // uzmin
         Real uzmin = ReduceMin( myspc,
         [=] AMREX_GPU_HOST_DEVICE (const PType& p)
         { return p.rdata(PIdx::uz); });
-        ParallelDescriptor::ReduceRealMin(uzmin);
 
         // uzmax
         Real uzmax = ReduceMax( myspc,
         [=] AMREX_GPU_HOST_DEVICE (const PType& p)
         { return p.rdata(PIdx::uz); });
-        ParallelDescriptor::ReduceRealMax(uzmax);
 
         // gmin
         Real gmin = 0.0_rt;
@@ -338,7 +322,6 @@ void ParticleExtrema::ComputeDiags (int step)
                 return std::sqrt(1.0_rt + us*inv_c2);
             });
         }
-        ParallelDescriptor::ReduceRealMin(gmin);
 
         // gmax
         Real gmax = 0.0_rt;
@@ -363,19 +346,16 @@ void ParticleExtrema::ComputeDiags (int step)
                 return std::sqrt(1.0_rt + us*inv_c2);
             });
         }
-        ParallelDescriptor::ReduceRealMax(gmax);
 
         // wmin
         Real wmin = ReduceMin( myspc,
         [=] AMREX_GPU_HOST_DEVICE (const PType& p)
         { return p.rdata(PIdx::w); });
-        ParallelDescriptor::ReduceRealMin(wmin);
 
         // wmax
         Real wmax = ReduceMax( myspc,
         [=] AMREX_GPU_HOST_DEVICE (const PType& p)
         { return p.rdata(PIdx::w); });
-        ParallelDescriptor::ReduceRealMax(wmax);
 
 #if (defined WARPX_QED)
         // get number of level (int)
@@ -483,8 +463,6 @@ void ParticleExtrema::ComputeDiags (int step)
                 chimin_f = *std::min_element(chimin.begin(), chimin.end());
                 chimax_f = *std::max_element(chimax.begin(), chimax.end());
             }
-            ParallelDescriptor::ReduceRealMin(chimin_f);
-            ParallelDescriptor::ReduceRealMax(chimax_f);
         }
 #endif
         m_data[0]  = xmin;
@@ -510,6 +488,14 @@ void ParticleExtrema::ComputeDiags (int step)
             m_data[17] = chimax_f;
         }
 #endif
+
+        // MPI reductions, deferred to MultiReducedDiags
+        // (m_data alternates minimum and maximum values)
+        for (int i = 0; i < static_cast<int>(m_data.size()); i += 2)
+        {
+            DeferReduction(&m_data[i], 1, ReduceOp::Min);
+            DeferReduction(&m_data[i+1], 1, ReduceOp::Max);
+        }
     }
     // end loop over species
 }
@@ -242,10 +242,13 @@ void ParticleHistogram::ComputeDiags (int step)
     amrex::Gpu::copy(amrex::Gpu::deviceToHost,
         d_data.begin(), d_data.end(), m_data.begin());
 
-    // reduced sum over mpi ranks
-    ParallelDescriptor::ReduceRealSum
-        (m_data.data(), m_data.size(), ParallelDescriptor::IOProcessorNumber());
+    // reduced sum over mpi ranks, deferred to MultiReducedDiags
+    DeferReduction(m_data.data(), static_cast<int>(m_data.size()), ReduceOp::Sum);
+}
+// end void ParticleHistogram::ComputeDiags
 
+void ParticleHistogram::FinalizeDiags (int /*step*/)
+{
     // normalize the maximum value to be one
     if ( m_norm == NormalizationType::max_to_unity )
     {
@@ -276,4 +279,4 @@ void ParticleHistogram::ComputeDiags (int step)
         return;
     }
 }
-// end void ParticleHistogram::ComputeDiags
+// end void ParticleHistogram::FinalizeDiags
@@ -47,6 +47,7 @@ ParticleMomentum::ParticleMomentum (std::string rd_name)
 
     // Resize data array
     m_data.resize(6*nSpecies+6, 0.0_rt);
+    m_weights.resize(nSpecies, 0.0_rt);
 
     // Get species names
     const std::vector<std::string> species_names = mypc.GetSpeciesNames();
@@ -128,11 +129,6 @@ void ParticleMomentum::ComputeDiags (int step)
     // Get number of species
     const int nSpecies = mypc.nSpecies();
 
-    // Some useful offsets to fill m_data below
-    int offset_total_species, offset_mean_species, offset_mean_all;
-
-    amrex::Real Wtot = 0.0_rt;
-
     // Loop over species
     for (int i_s = 0; i_s < nSpecies; ++i_s)
     {
@@ -167,11 +163,37 @@ void ParticleMomentum::ComputeDiags (int step)
         amrex::Real Pz = amrex::get<2>(r);
         amrex::Real Ws = amrex::get<3>(r);
 
-        // Reduced sum over MPI ranks
-        ParallelDescriptor::ReduceRealSum(Px, ParallelDescriptor::IOProcessorNumber());
-        ParallelDescriptor::ReduceRealSum(Py, ParallelDescriptor::IOProcessorNumber());
-        ParallelDescriptor::ReduceRealSum(Pz, ParallelDescriptor::IOProcessorNumber());
-        ParallelDescriptor::ReduceRealSum(Ws, ParallelDescriptor::IOProcessorNumber());
+        // Save local results for this species i_s into m_data and m_weights.
+        // Offset:
+        // 3 values of total momentum for all  species +
+        // 3 values of total momentum for each species
+        const int offset_total_species = 3 + i_s*3;
+        m_data[offset_total_species+0] = Px;
+        m_data[offset_total_species+1] = Py;
+        m_data[offset_total_species+2] = Pz;
+        m_weights[i_s] = Ws;
+    }
+
+    // Reduced sum over MPI ranks, deferred to MultiReducedDiags
+    DeferReduction(m_data.data() + 3, 3*nSpecies, ReduceOp::Sum);
+    DeferReduction(m_weights.data(), nSpecies, ReduceOp::Sum);
+}
+// end void ParticleMomentum::ComputeDiags
+
+void ParticleMomentum::FinalizeDiags (int /*step*/)
+{
+    // Get number of species
+    const int nSpecies = static_cast<int>(m_weights.size());
+
+    // Some useful offsets to fill m_data below
+    int offset_total_species, offset_mean_species, offset_mean_all;
+
+    amrex::Real Wtot = 0.0_rt;
+
+    // Loop over species
+    for (int i_s = 0; i_s < nSpecies; ++i_s)
+    {
+        const amrex::Real Ws = m_weights[i_s];
 
         // Accumulate sum of weights over all species (must come after MPI reduction of Ws)
         Wtot += Ws;
@@ -182,9 +204,6 @@ void ParticleMomentum::ComputeDiags (int step)
         // 3 values of total momentum for all  species +
         // 3 values of total momentum for each species
         offset_total_species = 3 + i_s*3;
-        m_data[offset_total_species+0] = Px;
-        m_data[offset_total_species+1] = Py;
-        m_data[offset_total_species+2] = Pz;
 
         // Offset:
         // 3 values of total momentum for all  species +
@@ -194,9 +213,9 @@ void ParticleMomentum::ComputeDiags (int step)
         offset_mean_species = 3 + nSpecies*3 + 3 + i_s*3;
         if (Ws > std::numeric_limits<Real>::min())
         {
-            m_data[offset_mean_species+0] = Px / Ws;
-            m_data[offset_mean_species+1] = Py / Ws;
-            m_data[offset_mean_species+2] = Pz / Ws;
+            m_data[offset_mean_species+0] = m_data[offset_total_species+0] / Ws;
+            m_data[offset_mean_species+1] = m_data[offset_total_species+1] / Ws;
+            m_data[offset_mean_species+2] = m_data[offset_total_species+2] / Ws;
         }
         else
         {
@@ -262,3 +281,4 @@ void ParticleMomentum::ComputeDiags (int step)
     //  mean  momentum along y (species n)
     //  mean  momentum along z (species n)]
 }
+// end void ParticleMomentum::FinalizeDiags
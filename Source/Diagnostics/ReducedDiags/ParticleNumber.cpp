@@ -115,8 +115,12 @@ void ParticleNumber::ComputeDiags (int step)
         // get WarpXParticleContainer class object
         const auto & myspc = mypc.GetParticleContainer(i_s);
 
-        // Save total number of macroparticles for this species
-        m_data[idx_first_species_macroparticles + i_s] = myspc.TotalNumberOfParticles();
+        // Save number of macroparticles for this species held by this MPI rank
+        // (the MPI reduction is deferred, see below)
+        constexpr bool only_valid = true;
+        constexpr bool only_local = true;
+        m_data[idx_first_species_macroparticles + i_s] =
+            static_cast<amrex::Real>(myspc.TotalNumberOfParticles(only_valid, only_local));
 
         using PType = typename WarpXParticleContainer::SuperParticleType;
 
@@ -127,10 +131,6 @@ void ParticleNumber::ComputeDiags (int step)
             return p.rdata(PIdx::w);
         });
 
-        // MPI reduction
-        amrex::ParallelDescriptor::ReduceRealSum
-            (Wtot, amrex::ParallelDescriptor::IOProcessorNumber());
-
         // Save sum of particles weight for this species
         m_data[idx_first_species_sum_weight + i_s] = Wtot;
 
@@ -141,7 +141,10 @@ void ParticleNumber::ComputeDiags (int step)
     }
     // end loop over species
 
-    /* m_data now contains up-to-date values for:
+    // MPI reduction, deferred to MultiReducedDiags
+    DeferReduction(m_data.data(), static_cast<int>(m_data.size()), ReduceOp::Sum);
+
+    /* once the reduction has completed, m_data contains up-to-date values for:
      *  [total number of macroparticles (all species),
      *   total number of macroparticles (species 1),
      *   ...,
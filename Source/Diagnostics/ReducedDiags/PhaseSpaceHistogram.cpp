@@ -0,0 +1,372 @@
+/* Copyright 2022 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+#include "PhaseSpaceHistogram.H"
+
+#include "Diagnostics/ReducedDiags/ReducedDiags.H"
+#include "Particles/MultiParticleContainer.H"
+#include "Particles/Pusher/GetAndSetPosition.H"
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/IntervalsParser.H"
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXConst.H"
+#include "Utils/WarpXUtil.H"
+#include "WarpX.H"
+
+#include <AMReX.H>
+#include <AMReX_Config.H>
+#include <AMReX_Extension.H>
+#include <AMReX_GpuAtomic.H>
+#include <AMReX_GpuContainers.H>
+#include <AMReX_GpuControl.H>
+#include <AMReX_GpuDevice.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_GpuMemory.H>
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_Math.H>
+#include <AMReX_OpenMP.H>
+#include <AMReX_PODVector.H>
+#include <AMReX_ParIter.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_REAL.H>
+
+#ifdef WARPX_USE_OPENPMD
+#   include <openPMD/openPMD.hpp>
+#endif
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+using namespace amrex;
+
+namespace
+{
+#ifdef AMREX_USE_GPU
+    /**
+     * Adds the contribution of np particles to the bins. get_bin(i, w) returns the
+     * bin of particle i (or -1 if the particle is discarded) and sets its weight w.
+     * On CUDA and HIP, each block of threads first accumulates into its own copy of
+     * the bins in shared memory, provided they fit in it, which avoids most of the
+     * contention of atomic operations in global memory.
+     */
+    template <typename F>
+    void FillBins (long const np, int const num_bins, F const& get_bin, Real* const p_bins)
+    {
+        if (np == 0) return;
+#if defined(AMREX_USE_CUDA) || defined(AMREX_USE_HIP)
+        constexpr int block_size = 256;
+        std::size_t const shared_mem_bytes = num_bins*sizeof(Real);
+        if (shared_mem_bytes <= Gpu::Device::sharedMemPerBlock())
+        {
+            int const nblocks = static_cast<int>(std::min<long>(
+                (np + block_size - 1) / block_size, Gpu::Device::maxBlocksPerLaunch()));
+            amrex::launch<block_size>(nblocks, shared_mem_bytes, Gpu::gpuStream(),
+            [=] AMREX_GPU_DEVICE () noexcept
+            {
+                Gpu::SharedMemory<Real> gsm;
+                Real* const s_bins = gsm.dataPtr();
+                for (int ibin = threadIdx.x; ibin < num_bins; ibin += blockDim.x) {
+                    s_bins[ibin] = 0.0_rt;
+                }
+                __syncthreads();
+                for (long i = blockIdx.x*long(blockDim.x) + threadIdx.x; i < np;
+                     i += long(blockDim.x)*gridDim.x)
+                {
+                    Real w;
+                    int const bin = get_bin(i, w);
+                    if (bin >= 0) Gpu::Atomic::AddNoRet(&s_bins[bin], w);
+                }
+                __syncthreads();
+                for (int ibin = threadIdx.x; ibin < num_bins; ibin += blockDim.x) {
+                    if (s_bins[ibin] != 0.0_rt) Gpu::Atomic::AddNoRet(&p_bins[ibin], s_bins[ibin]);
+                }
+            });
+            return;
+        }
+#endif
+        // otherwise, add directly to the bins in global memory
+        amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (long i)
+        {
+            Real w;
+            int const bin = get_bin(i, w);
+            if (bin >= 0) Gpu::Atomic::AddNoRet(&p_bins[bin], w);
+        });
+    }
+#endif
+}
+
+// constructor
+PhaseSpaceHistogram::PhaseSpaceHistogram (std::string rd_name)
+: ReducedDiags{rd_name}
+{
+#ifndef WARPX_USE_OPENPMD
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(false,
+        "PhaseSpaceHistogram reduced diagnostics requires WarpX to be compiled with openPMD support");
+#endif
+
+    ParmParse pp_rd_name(rd_name);
+
+    // the histogram is always written in openPMD format: the format may be openpmd
+    // (the default for this diagnostics) or hdf5, which selects the h5 backend
+    if (!pp_rd_name.contains("format")) { m_format = "openpmd"; }
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_format == "openpmd" || m_format == "hdf5",
+        "PhaseSpaceHistogram reduced diagnostics only supports the openpmd and hdf5 formats");
+
+    // read species
+    std::string selected_species_name;
+    pp_rd_name.get("species",selected_species_name);
+
+    // read number of axes
+    pp_rd_name.query("number_of_axes", m_num_axes);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_num_axes == 2 || m_num_axes == 3,
+        "PhaseSpaceHistogram: number_of_axes must be 2 or 3");
+
+    // read histogram function and bin parameters of each axis
+    for (int iaxis = 0; iaxis < m_num_axes; ++iaxis)
+    {
+        std::string const suffix = "_" + std::to_string(iaxis);
+        Store_parserString(pp_rd_name,"histogram_function" + suffix + "(t,x,y,z,ux,uy,uz)",
+                           m_function_strings[iaxis]);
+        m_parsers[iaxis] = std::make_unique<amrex::Parser>(
+            makeParser(m_function_strings[iaxis],{"t","x","y","z","ux","uy","uz"}));
+
+        Real bin_max = 0.0_rt;
+        getWithParser(pp_rd_name, ("bin_number" + suffix).c_str(), m_bin_num[iaxis]);
+        getWithParser(pp_rd_name, ("bin_max" + suffix).c_str(), bin_max);
+        getWithParser(pp_rd_name, ("bin_min" + suffix).c_str(), m_bin_min[iaxis]);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_bin_num[iaxis] > 0 && bin_max > m_bin_min[iaxis],
+            "PhaseSpaceHistogram: bin_number" + suffix + " must be positive and bin_max"
+            + suffix + " must be larger than bin_min" + suffix);
+        m_bin_size[iaxis] = (bin_max - m_bin_min[iaxis]) / m_bin_num[iaxis];
+    }
+
+    // read normalization type
+    std::string norm_string = "default";
+    pp_rd_name.query("normalization",norm_string);
+    if ( norm_string == "unity_particle_weight" ) {
+        m_unity_particle_weight = true;
+    } else if ( norm_string != "default" ) {
+        Abort("Unknown PhaseSpaceHistogram normalization type.");
+    }
+
+    // read openPMD backend
+    if (m_format == "hdf5") { m_openpmd_backend = "h5"; }
+    pp_rd_name.query("openpmd_backend", m_openpmd_backend);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_format != "hdf5" || m_openpmd_backend == "h5",
+        "PhaseSpaceHistogram: format = hdf5 requires openpmd_backend = h5");
+
+    // get MultiParticleContainer class object
+    const auto & mypc = WarpX::GetInstance().GetPartContainer();
+    // get species names (std::vector<std::string>)
+    auto const species_names = mypc.GetSpeciesNames();
+    // select species
+    for ( int i = 0; i < mypc.nSpecies(); ++i )
+    {
+        if ( selected_species_name == species_names[i] ){
+            m_selected_species_id = i;
+        }
+    }
+    // if m_selected_species_id is not modified
+    if ( m_selected_species_id == -1 ){
+        Abort("Unknown species for PhaseSpaceHistogram reduced diagnostic.");
+    }
+
+    // Read optional filter
+    std::string buf;
+    m_do_parser_filter = pp_rd_name.query("filter_function(t,x,y,z,ux,uy,uz)", buf);
+    if (m_do_parser_filter) {
+        std::string filter_string = "";
+        Store_parserString(pp_rd_name,"filter_function(t,x,y,z,ux,uy,uz)", filter_string);
+        m_parser_filter = std::make_unique<amrex::Parser>(
+                                     makeParser(filter_string,{"t","x","y","z","ux","uy","uz"}));
+    }
+
+    // resize data array (row-major, the last axis varies fastest)
+    m_data.resize(m_bin_num[0]*m_bin_num[1]*m_bin_num[2], 0.0_rt);
+}
+// end constructor
+
+// function that computes the histogram
+void PhaseSpaceHistogram::ComputeDiags (int step)
+{
+    // Judge if the diags should be done
+    if (!m_intervals.contains(step+1)) return;
+
+    // get a reference to WarpX instance
+    auto & warpx = WarpX::GetInstance();
+
+    // get time at level 0
+    auto const t = warpx.gett_new(0);
+
+    // get MultiParticleContainer class object
+    const auto & mypc = warpx.GetPartContainer();
+
+    // get WarpXParticleContainer class object
+    auto & myspc = mypc.GetParticleContainer(m_selected_species_id);
+
+    // get parsers (the parser of the third axis is empty for 2D histograms)
+    auto const fun0 = compileParser<m_nvars>(m_parsers[0].get());
+    auto const fun1 = compileParser<m_nvars>(m_parsers[1].get());
+    auto const fun2 = compileParser<m_nvars>(m_parsers[2].get());
+
+    // get filter parser
+    auto const fun_filterparser = compileParser<m_nvars>(m_parser_filter.get());
+
+    // declare local variables
+    bool const is_3d_histogram = (m_num_axes == 3);
+    int const n0 = m_bin_num[0];
+    int const n1 = m_bin_num[1];
+    int const n2 = m_bin_num[2];
+    Real const min0 = m_bin_min[0];
+    Real const min1 = m_bin_min[1];
+    Real const min2 = m_bin_min[2];
+    Real const size0 = m_bin_size[0];
+    Real const size1 = m_bin_size[1];
+    Real const size2 = m_bin_size[2];
+    int const num_bins = static_cast<int>(m_data.size());
+    bool const is_unity_particle_weight = m_unity_particle_weight;
+    bool const do_parser_filter = m_do_parser_filter;
+
+#ifdef AMREX_USE_GPU
+    amrex::Gpu::DeviceVector< amrex::Real > d_bins( num_bins, 0.0_rt );
+    amrex::Real* const AMREX_RESTRICT p_bins = d_bins.dataPtr();
+#else
+    // each OpenMP thread fills its own copy of the bins, so that no atomics are needed
+    int const nthreads = OpenMP::get_max_threads();
+    std::vector< std::vector< amrex::Real > > thread_bins(
+        nthreads, std::vector< amrex::Real >(num_bins, 0.0_rt));
+#endif
+
+    int const nlevs = std::max(0, myspc.finestLevel()+1);
+    for (int lev = 0; lev < nlevs; ++lev) {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+        {
+#ifndef AMREX_USE_GPU
+            amrex::Real* const AMREX_RESTRICT p_bins = thread_bins[OpenMP::get_thread_num()].data();
+#endif
+            for (WarpXParIter pti(myspc, lev); pti.isValid(); ++pti)
+            {
+                auto const GetPosition = GetParticlePosition(pti);
+
+                auto & attribs = pti.GetAttribs();
+                Real* const AMREX_RESTRICT d_w = attribs[PIdx::w].dataPtr();
+                Real* const AMREX_RESTRICT d_ux = attribs[PIdx::ux].dataPtr();
+                Real* const AMREX_RESTRICT d_uy = attribs[PIdx::uy].dataPtr();
+                Real* const AMREX_RESTRICT d_uz = attribs[PIdx::uz].dataPtr();
+
+                long const np = pti.numParticles();
+
+                // returns the linear bin index of particle i, or -1 if it is discarded
+                auto const get_bin = [=] AMREX_GPU_HOST_DEVICE (long i, Real& w) -> int
+                {
+                    amrex::ParticleReal x, y, z;
+                    GetPosition(i, x, y, z);
+                    auto const ux = d_ux[i] / PhysConst::c;
+                    auto const uy = d_uy[i] / PhysConst::c;
+                    auto const uz = d_uz[i] / PhysConst::c;
+
+                    // don't count a particle if it is filtered out
+                    if (do_parser_filter)
+                        if (!fun_filterparser(t, x, y, z, ux, uy, uz))
+                            return -1;
+
+                    // determine particle bin, discard if out-of-range
+                    int const b0 = int(Math::floor((fun0(t, x, y, z, ux, uy, uz)-min0)/size0));
+                    if ( b0<0 || b0>=n0 ) return -1;
+                    int const b1 = int(Math::floor((fun1(t, x, y, z, ux, uy, uz)-min1)/size1));
+                    if ( b1<0 || b1>=n1 ) return -1;
+                    int b2 = 0;
+                    if (is_3d_histogram) {
+                        b2 = int(Math::floor((fun2(t, x, y, z, ux, uy, uz)-min2)/size2));
+                        if ( b2<0 || b2>=n2 ) return -1;
+                    }
+
+                    w = is_unity_particle_weight ? 1.0_rt : d_w[i];
+                    return (b0*n1 + b1)*n2 + b2;
+                };
+
+#ifdef AMREX_USE_GPU
+                FillBins(np, num_bins, get_bin, p_bins);
+#else
+                for (long i = 0; i < np; ++i)
+                {
+                    Real w;
+                    int const bin = get_bin(i, w);
+                    if (bin >= 0) p_bins[bin] += w;
+                }
+#endif
+            }
+        }
+    }
+
+#ifdef AMREX_USE_GPU
+    // blocking copy from device to host
+    amrex::Gpu::copy(amrex::Gpu::deviceToHost,
+        d_bins.begin(), d_bins.end(), m_data.begin());
+#else
+    // merge the copies of the threads pairwise, in log2(nthreads) stages
+    for (int stride = 1; stride < nthreads; stride *= 2)
+    {
+        for (int ithread = 0; ithread + stride < nthreads; ithread += 2*stride)
+        {
+            amrex::Real* const AMREX_RESTRICT dst = thread_bins[ithread].data();
+            amrex::Real const* const AMREX_RESTRICT src = thread_bins[ithread+stride].data();
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for
+#endif
+            for (int ibin = 0; ibin < num_bins; ++ibin) {
+                dst[ibin] += src[ibin];
+            }
+        }
+    }
+    std::copy(thread_bins[0].begin(), thread_bins[0].end(), m_data.begin());
+#endif
+
+    // reduced sum over mpi ranks, deferred to MultiReducedDiags
+    DeferReduction(m_data.data(), num_bins, ReduceOp::Sum);
+}
+// end void PhaseSpaceHistogram::ComputeDiags
+
+void PhaseSpaceHistogram::WriteToFile (int step) const
+{
+#ifdef WARPX_USE_OPENPMD
+    // one file per output step
+    openPMD::Series series(m_path + m_rd_name + "/openpmd_%06T." + OpenPMDFileExtension(m_openpmd_backend),
+                           openPMD::Access::CREATE);
+    auto iteration = series.iterations[step + 1];
+    iteration.setTime(m_time);
+
+    std::vector< std::string > axis_labels;
+    std::vector< double > grid_offset;
+    std::vector< double > grid_spacing;
+    openPMD::Extent extent;
+    for (int iaxis = 0; iaxis < m_num_axes; ++iaxis) {
+        axis_labels.push_back(m_function_strings[iaxis]);
+        grid_offset.push_back(m_bin_min[iaxis]);
+        grid_spacing.push_back(m_bin_size[iaxis]);
+        extent.push_back(m_bin_num[iaxis]);
+    }
+
+    auto mesh = iteration.meshes["data"];
+    mesh.setDataOrder(openPMD::Mesh::DataOrder::C);
+    mesh.setAxisLabels(axis_labels);
+    mesh.setGridGlobalOffset(grid_offset);
+    mesh.setGridSpacing(grid_spacing);
+
+    auto data = mesh[openPMD::RecordComponent::SCALAR];
+    data.setPosition(std::vector< double >(m_num_axes, 0.5));
+    data.resetDataset(openPMD::Dataset(openPMD::determineDatatype<amrex::Real>(), extent));
+    data.storeChunk(openPMD::shareRaw(m_data.data()), openPMD::Offset(m_num_axes, 0), extent);
+    series.flush();
+#else
+    amrex::ignore_unused(step);
+#endif
+}
+// end void PhaseSpaceHistogram::WriteToFile
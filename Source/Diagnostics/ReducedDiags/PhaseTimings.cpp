@@ -0,0 +1,112 @@
+/* Copyright 2022 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "PhaseTimings.H"
+
+#include "Diagnostics/ReducedDiags/ReducedDiags.H"
+#include "Utils/IntervalsParser.H"
+#include "Utils/PhaseTimers.H"
+#include "WarpX.H"
+
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_REAL.H>
+
+#include <fstream>
+#include <vector>
+
+using namespace amrex;
+
+// constructor
+PhaseTimings::PhaseTimings (std::string rd_name)
+    : ReducedDiags{rd_name}
+{
+    // start timing the phases of the time step
+    PhaseTimers::Enable(WarpX::do_device_synchronize);
+
+    // number of phases, plus the total time of the step
+    constexpr int n = PhaseTimers::NumPhases + 1;
+
+    // resize data arrays
+    m_data.resize(3*n, 0.0_rt);
+    m_min.resize(n, 0.0_rt);
+    m_sum.resize(n, 0.0_rt);
+    m_max.resize(n, 0.0_rt);
+
+    if (ParallelDescriptor::IOProcessor())
+    {
+        if ( m_IsNotRestart )
+        {
+            // open file
+            std::ofstream ofs{m_path + m_rd_name + "." + m_extension, std::ofstream::out};
+
+            // write header row
+            int c = 0;
+            ofs << "#";
+            ofs << "[" << c++ << "]step()";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]time(s)";
+            for (int i = 0; i < n; ++i)
+            {
+                const std::string name = (i < PhaseTimers::NumPhases) ? PhaseTimers::names[i] : "total";
+                ofs << m_sep;
+                ofs << "[" << c++ << "]" + name + "_min(s)";
+                ofs << m_sep;
+                ofs << "[" << c++ << "]" + name + "_avg(s)";
+                ofs << m_sep;
+                ofs << "[" << c++ << "]" + name + "_max(s)";
+            }
+            ofs << std::endl;
+
+            // close file
+            ofs.close();
+        }
+    }
+}
+// end constructor
+
+// function that gets the times per step of the phases
+void PhaseTimings::ComputeDiags (int step)
+{
+    // Judge if the diags should be done
+    if (!m_intervals.contains(step+1)) { return; }
+
+    // times accumulated since the previous output
+    int num_steps = 0;
+    const auto times = PhaseTimers::GetAndReset(num_steps);
+
+    for (int i = 0; i < static_cast<int>(times.size()); ++i)
+    {
+        const Real t = (num_steps > 0) ? static_cast<Real>(times[i] / num_steps) : 0.0_rt;
+        m_min[i] = t;
+        m_sum[i] = t;
+        m_max[i] = t;
+    }
+
+    // reductions over mpi ranks, deferred to MultiReducedDiags
+    const int n = static_cast<int>(m_sum.size());
+    DeferReduction(m_min.data(), n, ReduceOp::Min);
+    DeferReduction(m_sum.data(), n, ReduceOp::Sum);
+    DeferReduction(m_max.data(), n, ReduceOp::Max);
+}
+// end void PhaseTimings::ComputeDiags
+
+void PhaseTimings::FinalizeDiags (int /*step*/)
+{
+    const Real nprocs = static_cast<Real>(ParallelDescriptor::NProcs());
+    for (int i = 0; i < static_cast<int>(m_sum.size()); ++i)
+    {
+        m_data[3*i  ] = m_min[i];
+        m_data[3*i+1] = m_sum[i] / nprocs;
+        m_data[3*i+2] = m_max[i];
+    }
+
+    /* m_data now contains up-to-date values for:
+     *  [push_deposit min, avg and max over the ranks,
+     *   field_solve min, avg and max over the ranks,
+     *   ......,
+     *   total min, avg and max over the ranks] */
+}
+// end void PhaseTimings::FinalizeDiags
@@ -0,0 +1,83 @@
+/* Copyright 2022 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "PoissonSolverStats.H"
+
+#include "Diagnostics/ReducedDiags/ReducedDiags.H"
+#include "FieldSolver/ElectrostaticSolver.H"
+#include "Utils/IntervalsParser.H"
+#include "WarpX.H"
+
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_REAL.H>
+
+#include <ostream>
+#include <vector>
+
+using namespace amrex;
+
+// constructor
+PoissonSolverStats::PoissonSolverStats (std::string rd_name)
+    : ReducedDiags{rd_name}
+{
+    // resize data array
+    m_data.resize(4, 0.0_rt);
+
+    if (ParallelDescriptor::IOProcessor())
+    {
+        if ( m_IsNotRestart )
+        {
+            // open file
+            std::ofstream ofs{m_path + m_rd_name + "." + m_extension, std::ofstream::out};
+
+            // write header row
+            int c = 0;
+            ofs << "#";
+            ofs << "[" << c++ << "]step()";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]time(s)";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]iterations()";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]setups()";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]setup_time(s)";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]solve_time(s)";
+            ofs << std::endl;
+
+            // close file
+            ofs.close();
+        }
+    }
+}
+
+// Get the statistics of the Poisson solver
+void PoissonSolverStats::ComputeDiags (int step)
+{
+    // Judge if the diags should be done
+    if (!m_intervals.contains(step+1)) { return; }
+
+    // get a reference to WarpX instance
+    auto & warpx = WarpX::GetInstance();
+
+    const ElectrostaticSolver::PoissonSolverStats& stats = warpx.getPoissonSolverStats();
+
+    // save data
+    m_data[0] = static_cast<Real>(stats.num_iters);
+    m_data[1] = static_cast<Real>(stats.num_setups);
+    m_data[2] = stats.setup_time;
+    m_data[3] = stats.solve_time;
+
+    // the times are the maximum over all ranks (reduction deferred to MultiReducedDiags)
+    DeferReduction(m_data.data() + 2, 2, ReduceOp::Max);
+
+    /* once the reduction has completed, m_data contains up-to-date values for:
+     *  [number of MLMG iterations,
+     *   number of linear operators that were (re)built,
+     *   setup time,
+     *   solve time] */
+}
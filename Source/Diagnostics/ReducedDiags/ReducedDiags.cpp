@@ -7,15 +7,22 @@
 
 #include "ReducedDiags.H"
 
-#include "WarpX.H"
+#include "Utils/TextMsg.H"
 
 #include <AMReX.H>
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_ParmParse.H>
 #include <AMReX_Utility.H>
 
+#ifdef WARPX_USE_OPENPMD
+#   include <openPMD/openPMD.hpp>
+#endif
+
+#include <cstdint>
 #include <fstream>
 #include <iomanip>
+#include <string>
+#include <vector>
 
 using namespace amrex;
 
@@ -61,9 +68,30 @@ ReducedDiags::ReducedDiags (std::string rd_name)
 
     // read separator
     pp_rd_name.query("separator", m_sep);
+
+    // read output format
+    pp_rd_name.query("format", m_format);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        m_format == "text" || m_format == "binary" || m_format == "hdf5" || m_format == "openpmd",
+        m_rd_name + ".format must be text, binary, hdf5 or openpmd");
+#ifndef WARPX_USE_OPENPMD
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_format != "hdf5" && m_format != "openpmd",
+        m_rd_name + ".format = " + m_format + " requires WarpX to be compiled with openPMD support");
+#elif openPMD_HAVE_HDF5==0
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_format != "hdf5",
+        m_rd_name + ".format = hdf5 requires openPMD to be compiled with HDF5 support");
+#endif
+    pp_rd_name.query("buffer_size", m_buffer_size);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_buffer_size > 0,
+        m_rd_name + ".buffer_size must be positive");
 }
 // end constructor
 
+ReducedDiags::~ReducedDiags ()
+{
+    FlushToFile();
+}
+
 void ReducedDiags::InitData ()
 {
     // Defines an empty function InitData() to be overwritten if needed.
@@ -78,6 +106,18 @@ void ReducedDiags::LoadBalance ()
     // load balancing operations
 }
 
+void ReducedDiags::FinalizeDiags (int /*step*/)
+{
+    // Defines an empty function FinalizeDiags() to be overwritten if needed.
+    // Function used to compute the output data once the MPI reductions
+    // deferred by ComputeDiags have completed
+}
+
+void ReducedDiags::DeferReduction (amrex::Real* data, int n, ReduceOp op)
+{
+    m_deferred_reductions.emplace_back(data, n, op);
+}
+
 void ReducedDiags::BackwardCompatibility ()
 {
     amrex::ParmParse pp_rd_name(m_rd_name);
@@ -88,9 +128,40 @@ void ReducedDiags::BackwardCompatibility ()
     }
 }
 
+std::string ReducedDiags::OpenPMDFileExtension (const std::string& backend)
+{
+    // pick first available backend if default is chosen
+    if (backend != "default") { return backend; }
+#if defined(WARPX_USE_OPENPMD) && openPMD_HAVE_ADIOS2==1
+    return "bp";
+#elif defined(WARPX_USE_OPENPMD) && openPMD_HAVE_ADIOS1==1
+    return "bp";
+#elif defined(WARPX_USE_OPENPMD) && openPMD_HAVE_HDF5==1
+    return "h5";
+#else
+    return "json";
+#endif
+}
+
 // write to file function
 void ReducedDiags::WriteToFile (int step) const
 {
+    // binary formats: buffer the row in memory, and write the rows by blocks
+    if (m_format != "text")
+    {
+        if (m_num_buffered_rows == 0)
+        {
+            m_first_buffered_step = step;
+            m_first_buffered_time = m_time;
+        }
+        m_row_buffer.push_back(step+1);
+        m_row_buffer.push_back(m_time);
+        m_row_buffer.insert(m_row_buffer.end(), m_data.begin(), m_data.end());
+        ++m_num_buffered_rows;
+        if (m_num_buffered_rows >= m_buffer_size) { FlushToFile(); }
+        return;
+    }
+
     // open file
     std::ofstream ofs{m_path + m_rd_name + "." + m_extension,
         std::ofstream::out | std::ofstream::app};
@@ -104,7 +175,7 @@ void ReducedDiags::WriteToFile (int step) const
     ofs << std::fixed << std::setprecision(14) << std::scientific;
 
     // write time
-    ofs << WarpX::GetInstance().gett_new(0);
+    ofs << m_time;
 
     // loop over data size and write
     for (const auto& item : m_data) ofs << m_sep << item;
@@ -118,3 +189,70 @@ void ReducedDiags::WriteToFile (int step) const
     ofs.close();
 }
 // end ReducedDiags::WriteToFile
+
+void ReducedDiags::FlushToFile () const
+{
+    if (m_num_buffered_rows == 0) { return; }
+
+    if (m_format == "binary")
+    {
+        // open the file at the first flush, and keep it open
+        if (!m_binary_file)
+        {
+            const auto mode = m_IsNotRestart ? std::ofstream::trunc : std::ofstream::app;
+            m_binary_file = std::make_unique<std::ofstream>(
+                m_path + m_rd_name + ".bin", std::ofstream::out | std::ofstream::binary | mode);
+        }
+        m_binary_file->write(reinterpret_cast<const char*>(m_row_buffer.data()),
+                             static_cast<std::streamsize>(m_row_buffer.size()*sizeof(double)));
+        m_binary_file->flush();
+    }
+#ifdef WARPX_USE_OPENPMD
+    else
+    {
+        const auto ncols = static_cast<std::uint64_t>(m_row_buffer.size() / m_num_buffered_rows);
+
+        // open the series at the first flush, and keep it open
+        if (!m_series)
+        {
+            const std::string backend = OpenPMDFileExtension(m_format == "hdf5" ? "h5" : "default");
+            m_series = std::make_unique<openPMD::Series>(
+                m_path + m_rd_name + "." + backend,
+                m_IsNotRestart ? openPMD::Access::CREATE : openPMD::Access::APPEND);
+        }
+
+        // the names of the columns are those of the header of the text file
+        std::vector<std::string> columns;
+        std::ifstream ifs{m_path + m_rd_name + "." + m_extension};
+        std::string header;
+        std::getline(ifs, header);
+        if (!header.empty() && header[0] == '#') { header.erase(0, 1); }
+        std::size_t pos = 0;
+        while (!header.empty() && pos != std::string::npos)
+        {
+            const std::size_t next = header.find(m_sep, pos);
+            columns.push_back(header.substr(pos, next == std::string::npos ? next : next - pos));
+            pos = (next == std::string::npos) ? next : next + m_sep.size();
+        }
+
+        // one iteration per block of rows, labeled by the first row
+        auto iteration = m_series->iterations[m_first_buffered_step + 1];
+        iteration.setTime(m_first_buffered_time);
+        auto mesh = iteration.meshes["data"];
+        mesh.setDataOrder(openPMD::Mesh::DataOrder::C);
+        mesh.setAxisLabels({"row", "column"});
+        mesh.setGridGlobalOffset({0.0, 0.0});
+        mesh.setGridSpacing(std::vector<double>{1.0, 1.0});
+        if (columns.size() == ncols) { mesh.setAttribute("columns", columns); }
+        auto data = mesh[openPMD::RecordComponent::SCALAR];
+        data.setPosition(std::vector<double>{0.0, 0.0});
+        const openPMD::Extent extent = {static_cast<std::uint64_t>(m_num_buffered_rows), ncols};
+        data.resetDataset(openPMD::Dataset(openPMD::Datatype::DOUBLE, extent));
+        data.storeChunk(openPMD::shareRaw(m_row_buffer.data()), {0, 0}, extent);
+        iteration.close();
+    }
+#endif
+
+    m_row_buffer.clear();
+    m_num_buffered_rows = 0;
+}
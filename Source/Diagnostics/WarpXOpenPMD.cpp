@@ -9,9 +9,11 @@
 #include "Diagnostics/ParticleDiag/ParticleDiag.H"
 #include "FieldIO.H"
 #include "Particles/Filter/FilterFunctors.H"
+#include "Particles/PhysicalParticleContainer.H"
 #include "Utils/TextMsg.H"
 #include "Utils/RelativeCellPosition.H"
 #include "Utils/WarpXAlgorithmSelection.H"
+#include "Utils/WarpXConst.H"
 #include "Utils/WarpXProfilerWrapper.H"
 #include "Utils/WarpXUtil.H"
 #include "WarpX.H"
@@ -24,6 +26,7 @@
 #include <AMReX_DataAllocator.H>
 #include <AMReX_FArrayBox.H>
 #include <AMReX_FabArray.H>
+#include <AMReX_GpuContainers.H>
 #include <AMReX_GpuQualifiers.H>
 #include <AMReX_IntVect.H>
 #include <AMReX_MFIter.H>
@@ -34,11 +37,14 @@
 #include <AMReX_Particle.H>
 #include <AMReX_Particles.H>
 #include <AMReX_Periodicity.H>
+#include <AMReX_Random.H>
+#include <AMReX_Scan.H>
 #include <AMReX_StructOfArrays.H>
 
 #include <algorithm>
 #include <cctype>
 #include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -47,6 +53,7 @@
 #include <string>
 #include <tuple>
 #include <utility>
+#include <variant>
 
 namespace detail
 {
@@ -385,6 +392,356 @@ namespace detail
                                   });
         }
     }
+
+    /** Allocate a host buffer of n elements
+     *
+     * On GPU, the buffer is allocated in pinned memory, so that it can be
+     * filled from a device kernel.
+     */
+    template< typename T >
+    std::shared_ptr< T >
+    makeHostBuffer (std::size_t const n)
+    {
+#ifdef AMREX_USE_GPU
+        return std::shared_ptr< T >(
+            static_cast< T* >(amrex::The_Pinned_Arena()->alloc(n * sizeof(T))),
+            [](T* p){ amrex::The_Pinned_Arena()->free(p); }
+        );
+#else
+        return std::shared_ptr< T >(
+            new T[n],
+            [](T const *p){ delete[] p; }
+        );
+#endif
+    }
+
+    /** Get a host buffer of n elements that is written to a record component
+     *  at the given offset when the series is flushed
+     *
+     * On CPU, the buffer is provided by openPMD-api itself (e.g., it points into the
+     * ADIOS2 serialization buffer), so that no intermediate copy is needed. It has to be
+     * filled before the next call to storeChunk. On GPU, the buffer is allocated in
+     * pinned memory, so that it can be filled from a device kernel; the stream has to be
+     * synchronized before the series is flushed.
+     *
+     * @param rc the record component to write to
+     * @param offset offset of the chunk in the record component
+     * @param n number of elements in the chunk
+     */
+    template< typename T >
+    T*
+    getChunkBuffer (openPMD::RecordComponent rc, uint64_t const offset, uint64_t const n)
+    {
+#ifdef AMREX_USE_GPU
+        auto buffer = makeHostBuffer< T >(n);
+        rc.storeChunk(buffer, {offset}, {n});
+        return buffer.get();
+#else
+        auto view = rc.storeChunk< T >({offset}, {n});
+        return view.currentBuffer().data();
+#endif
+    }
+
+    /** Chunk buffers of a particle tile, provided directly by the openPMD series */
+    struct SeriesChunkBuffers
+    {
+        openPMD::ParticleSpecies& species;
+        uint64_t offset;
+        uint64_t extent;
+
+        template< typename T >
+        T* get (std::string const& record_name, std::string const& component_name)
+        {
+            return getChunkBuffer< T >(species[record_name][component_name], offset, extent);
+        }
+    };
+
+    /** Chunk buffers of a particle tile, allocated on the host and kept in a snapshot */
+    struct SnapshotChunkBuffers
+    {
+        std::vector< OpenPMDSnapshot::ParticleChunk >& chunks;
+        uint64_t offset;
+        uint64_t extent;
+
+        template< typename T >
+        T* get (std::string const& record_name, std::string const& component_name)
+        {
+            auto buffer = makeHostBuffer< T >(extent);
+            chunks.push_back({record_name, component_name, offset, extent, buffer});
+            return buffer.get();
+        }
+    };
+
+    /** Names and output flags of the real and int particle attributes of a species
+     *
+     * @param[in] pc the particle container of the species
+     * @param[in] particle_diag the particle diagnostic
+     * @param[out] real_names names of the real attributes
+     * @param[out] int_names names of the int attributes
+     * @param[out] real_flags whether each real attribute is written
+     * @param[out] int_flags whether each int attribute is written
+     */
+    inline void
+    getParticleAttributes (WarpXParticleContainer const* pc,
+                           ParticleDiag const& particle_diag,
+                           amrex::Vector<std::string>& real_names,
+                           amrex::Vector<std::string>& int_names,
+                           amrex::Vector<int>& real_flags,
+                           amrex::Vector<int>& int_flags)
+    {
+        real_names.clear();
+        int_names.clear();
+
+        // see openPMD ED-PIC extension for namings
+        // note: an underscore separates the record name from its component
+        //       for non-scalar records
+        real_names.push_back("weighting");
+
+        real_names.push_back("momentum_x");
+        real_names.push_back("momentum_y");
+        real_names.push_back("momentum_z");
+
+#ifdef WARPX_DIM_RZ
+        real_names.push_back("theta");
+#endif
+
+        // get the names of the real comps
+        real_names.resize(pc->NumRealComps());
+        auto runtime_rnames = pc->getParticleRuntimeComps();
+        for (auto const& x : runtime_rnames)
+        {
+            real_names[x.second+PIdx::nattribs] = snakeToCamel(x.first);
+        }
+
+        // plot any "extra" fields by default
+        real_flags = particle_diag.plot_flags;
+        real_flags.resize(pc->NumRealComps(), 1);
+
+        // and the names
+        int_names.resize(pc->NumIntComps());
+        auto runtime_inames = pc->getParticleRuntimeiComps();
+        for (auto const& x : runtime_inames)
+        {
+            int_names[x.second+0] = snakeToCamel(x.first);
+        }
+
+        // plot by default
+        int_flags.assign(pc->NumIntComps(), 1);
+    }
+
+    /** Evaluate the particle diagnostic filters for all the particles of a tile
+     *
+     * On return, dst has np+1 entries: particle i is selected if dst[i+1] != dst[i],
+     * in which case dst[i] is its index in the output chunk of the tile.
+     *
+     * @return the number of selected particles in the tile
+     */
+    template< typename T_ParticleTile >
+    int
+    filterParticlesOfTile (T_ParticleTile const& ptile,
+                           RandomFilter const& random_filter,
+                           UniformFilter const& uniform_filter,
+                           ParserFilter const& parser_filter,
+                           GeometryFilter const& geometry_filter,
+                           amrex::Gpu::DeviceVector<int>& dst)
+    {
+        int const np = ptile.numParticles();
+        auto const ptd = ptile.getConstParticleTileData();
+
+        amrex::Gpu::DeviceVector<int> mask(np);
+        int* const AMREX_RESTRICT p_mask = mask.dataPtr();
+        amrex::ParallelForRNG(np,
+            [=] AMREX_GPU_DEVICE (int i, amrex::RandomEngine const& engine) noexcept
+        {
+            const SuperParticleType& p = ptd.getSuperParticle(i);
+            p_mask[i] = random_filter(p, engine) * uniform_filter(p, engine)
+                        * parser_filter(p, engine) * geometry_filter(p, engine);
+        });
+
+        dst.resize(np+1);
+        int* const AMREX_RESTRICT p_dst = dst.dataPtr();
+        return amrex::Scan::PrefixSum<int>(np+1,
+            [=] AMREX_GPU_DEVICE (int i) -> int { return (i < np) ? p_mask[i] : 0; },
+            [=] AMREX_GPU_DEVICE (int i, int const& s) { p_dst[i] = s; },
+            amrex::Scan::Type::exclusive, amrex::Scan::retSum);
+    }
+
+    /** Particles of a species selected by the filters of a particle diagnostic */
+    struct ParticleSelection
+    {
+        /** whether any filter is active (otherwise, all particles are selected) */
+        bool do_filter = false;
+        /** for each level and tile, destination indices (see filterParticlesOfTile) */
+        amrex::Vector< amrex::Vector< amrex::Gpu::DeviceVector<int> > > dst;
+        /** for each level and tile, number of selected particles */
+        amrex::Vector< amrex::Vector<int> > num_selected;
+        /** for each level, number of selected particles on this process */
+        std::vector<long> num_local_particles;
+        /** factor converting the momentum from WarpX units to SI (see particlesConvertUnits) */
+        amrex::ParticleReal momentum_factor = 1._prt;
+
+        int const* getDst (int lev, int itile) const
+        {
+            return do_filter ? dst[lev][itile].dataPtr() : nullptr;
+        }
+    };
+
+    /** Select the particles of a species that pass the filters of a particle diagnostic
+     *
+     * The particles stay in WarpX units, so that the parser filter is evaluated with WarpX momenta.
+     */
+    inline ParticleSelection
+    selectParticles (WarpXParticleContainer* pc, ParticleDiag const& particle_diag)
+    {
+        RandomFilter const random_filter(particle_diag.m_do_random_filter,
+                                         particle_diag.m_random_fraction);
+        UniformFilter const uniform_filter(particle_diag.m_do_uniform_filter,
+                                           particle_diag.m_uniform_stride);
+        ParserFilter const parser_filter(particle_diag.m_do_parser_filter,
+                                         compileParser<ParticleDiag::m_nvars>
+                                             (particle_diag.m_particle_filter_parser.get()),
+                                         pc->getMass());
+        GeometryFilter const geometry_filter(particle_diag.m_do_geom_filter,
+                                             particle_diag.m_diag_domain);
+
+        ParticleSelection selection;
+        selection.do_filter = particle_diag.m_do_random_filter || particle_diag.m_do_uniform_filter ||
+                              particle_diag.m_do_parser_filter || particle_diag.m_do_geom_filter;
+
+        if (auto const* phys_pc = dynamic_cast<PhysicalParticleContainer const*>(pc)) {
+            selection.momentum_factor =
+                phys_pc->AmIA<PhysicalSpecies::photon>() ? PhysConst::m_e : pc->getMass();
+        }
+
+        int const nlevs = pc->finestLevel() + 1;
+        selection.dst.resize(nlevs);
+        selection.num_selected.resize(nlevs);
+        selection.num_local_particles.assign(nlevs, 0);
+        for (int lev = 0; lev < nlevs; ++lev) {
+            for (WarpXParIter pti(*pc, lev); pti.isValid(); ++pti) {
+                auto const& ptile = pti.GetParticleTile();
+                selection.dst[lev].emplace_back();
+                int nsel = ptile.numParticles();
+                if (selection.do_filter && nsel > 0) {
+                    nsel = filterParticlesOfTile(ptile, random_filter, uniform_filter,
+                                                 parser_filter, geometry_filter,
+                                                 selection.dst[lev].back());
+                }
+                selection.num_selected[lev].push_back(nsel);
+                selection.num_local_particles[lev] += nsel;
+            }
+        }
+        return selection;
+    }
+
+    /** Copy one value per selected particle of a tile into a contiguous buffer
+     *
+     * @param[out] buffer output buffer, with one entry per selected particle
+     * @param[in] np number of particles in the tile
+     * @param[in] dst destination indices (see filterParticlesOfTile),
+     *                or nullptr if all particles are selected
+     * @param[in] f functor that returns the value to write for particle i
+     */
+    template< typename T, typename F >
+    void
+    gatherSelectedParticles (T* const AMREX_RESTRICT buffer, int const np,
+                             int const* const AMREX_RESTRICT dst, F const& f)
+    {
+        amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (int i) noexcept
+        {
+            if (dst == nullptr) {
+                buffer[i] = f(i);
+            } else if (dst[i+1] != dst[i]) {
+                buffer[dst[i]] = f(i);
+            }
+        });
+    }
+
+    /** Gather the selected particles of a tile into the chunk buffers of their records
+     *
+     * The attributes are gathered from the particle tile (possibly in device memory)
+     * directly into the chunk buffers; the momentum is converted to SI on the fly.
+     * Each buffer is filled before the next one is requested.
+     *
+     * @param[in] buffers provides the chunk buffer of a record (see SeriesChunkBuffers, SnapshotChunkBuffers)
+     * @param[in] ptile the particle tile
+     * @param[in] dst destination indices (see filterParticlesOfTile),
+     *                or nullptr if all particles are selected
+     * @param[in] write_real_comp whether each real attribute is written
+     * @param[in] real_comp_names the real attribute names
+     * @param[in] write_int_comp whether each int attribute is written
+     * @param[in] int_comp_names the int attribute names
+     * @param[in] momentum_factor factor converting the momentum from WarpX units to SI
+     */
+    template< typename T_ChunkBuffers, typename T_ParticleTile >
+    void
+    storeParticleTileChunks (T_ChunkBuffers& buffers,
+                             T_ParticleTile const& ptile,
+                             int const* const dst,
+                             amrex::Vector<int> const& write_real_comp,
+                             amrex::Vector<std::string> const& real_comp_names,
+                             amrex::Vector<int> const& write_int_comp,
+                             amrex::Vector<std::string> const& int_comp_names,
+                             amrex::ParticleReal const momentum_factor)
+    {
+        using ParticleType = typename T_ParticleTile::ParticleType;
+
+        int const np = ptile.numParticles();
+        ParticleType const* const AMREX_RESTRICT aos = ptile.GetArrayOfStructs()().dataPtr();
+        auto const& soa = ptile.GetStructOfArrays();
+
+        // positions
+#if defined(WARPX_DIM_RZ)
+        //   reconstruct x and y from polar coordinates r, theta
+        amrex::ParticleReal const* const AMREX_RESTRICT theta = soa.GetRealData(PIdx::theta).dataPtr();
+        gatherSelectedParticles(
+            buffers.template get<amrex::ParticleReal>("position", "x"), np, dst,
+            [=] AMREX_GPU_DEVICE (int i) { return aos[i].pos(0) * std::cos(theta[i]); });
+        gatherSelectedParticles(
+            buffers.template get<amrex::ParticleReal>("position", "y"), np, dst,
+            [=] AMREX_GPU_DEVICE (int i) { return aos[i].pos(0) * std::sin(theta[i]); });
+        gatherSelectedParticles(
+            buffers.template get<amrex::ParticleReal>("position", "z"), np, dst,
+            [=] AMREX_GPU_DEVICE (int i) { return aos[i].pos(1); });  // {0: "r", 1: "z"}
+#else
+        auto const positionComponents = getParticlePositionComponentLabels();
+        for (int currDim = 0; currDim < AMREX_SPACEDIM; currDim++) {
+            gatherSelectedParticles(
+                buffers.template get<amrex::ParticleReal>("position", positionComponents[currDim]), np, dst,
+                [=] AMREX_GPU_DEVICE (int i) { return aos[i].pos(currDim); });
+        }
+#endif
+
+        // particle ID, converted to a globally unique ID
+        gatherSelectedParticles(
+            buffers.template get<uint64_t>("id", openPMD::RecordComponent::SCALAR), np, dst,
+            [=] AMREX_GPU_DEVICE (int i) { return WarpXUtilIO::localIDtoGlobal(aos[i].id(), aos[i].cpu()); });
+
+        // SoA real attributes (note: WarpX does not use extra AoS real attributes)
+        int const real_counter = std::min(write_real_comp.size(), real_comp_names.size());
+        for (int idx = 0; idx < real_counter; idx++) {
+            if (!write_real_comp[idx]) continue;
+            amrex::ParticleReal const* const AMREX_RESTRICT data = soa.GetRealData(idx).dataPtr();
+            bool const is_momentum = (idx == PIdx::ux || idx == PIdx::uy || idx == PIdx::uz);
+            amrex::ParticleReal const factor = is_momentum ? momentum_factor : 1._prt;
+            // handle scalar and non-scalar records by name
+            const auto [record_name, component_name] = name2openPMD(real_comp_names[idx]);
+            gatherSelectedParticles(
+                buffers.template get<amrex::ParticleReal>(record_name, component_name), np, dst,
+                [=] AMREX_GPU_DEVICE (int i) { return data[i] * factor; });
+        }
+
+        // SoA int attributes
+        int const int_counter = std::min(write_int_comp.size(), int_comp_names.size());
+        for (int idx = 0; idx < int_counter; idx++) {
+            if (!write_int_comp[idx]) continue;
+            int const* const AMREX_RESTRICT data = soa.GetIntData(idx).dataPtr();
+            const auto [record_name, component_name] = name2openPMD(int_comp_names[idx]);
+            gatherSelectedParticles(
+                buffers.template get<int>(record_name, component_name), np, dst,
+                [=] AMREX_GPU_DEVICE (int i) { return data[i]; });
+        }
+    }
 #endif // WARPX_USE_OPENPMD
 } // namespace detail
 
@@ -396,8 +753,10 @@ WarpXOpenPMDPlot::WarpXOpenPMDPlot (
     std::map< std::string, std::string > operator_parameters,
     std::string engine_type,
     std::map< std::string, std::string > engine_parameters,
-    std::vector<bool> fieldPMLdirections)
+    std::vector<bool> fieldPMLdirections,
+    MPI_Comm comm)
   :m_Series(nullptr),
+   m_comm(comm),
    m_Encoding(ie),
    m_OpenPMDFileType(std::move(openPMDFileType)),
    m_fieldPMLdirections(std::move(fieldPMLdirections))
@@ -519,7 +878,7 @@ WarpXOpenPMDPlot::Init (openPMD::Access access, bool isBTD)
 #if defined(AMREX_USE_MPI)
         m_Series = std::make_unique<openPMD::Series>(
                 filepath, access,
-                amrex::ParallelDescriptor::Communicator(),
+                m_comm,
                 m_OpenPMDoptions
         );
         m_MPISize = amrex::ParallelDescriptor::NProcs();
@@ -555,112 +914,104 @@ WarpXOpenPMDPlot::WriteOpenPMDParticles (const amrex::Vector<ParticleDiag>& part
 
   for (unsigned i = 0, n = particle_diags.size(); i < n; ++i) {
     WarpXParticleContainer* pc = particle_diags[i].getParticleContainer();
-    auto tmp = pc->make_alike<amrex::PinnedArenaAllocator>();
     // names of amrex::Real and int particle attributes in SoA data
     amrex::Vector<std::string> real_names;
     amrex::Vector<std::string> int_names;
     amrex::Vector<int> int_flags;
     amrex::Vector<int> real_flags;
+    detail::getParticleAttributes(pc, particle_diags[i], real_names, int_names, real_flags, int_flags);
 
-    // see openPMD ED-PIC extension for namings
-    // note: an underscore separates the record name from its component
-    //       for non-scalar records
-    real_names.push_back("weighting");
+    // real_names contains a list of all real particle attributes.
+    // real_flags is 1 or 0, whether quantity is dumped or not.
 
-    real_names.push_back("momentum_x");
-    real_names.push_back("momentum_y");
-    real_names.push_back("momentum_z");
+    if (isBTD) {
+        // the BTD buffer is already a pinned-memory copy of the lab-frame particles
+        PinnedMemoryParticleContainer* pinned_pc = particle_diags[i].getPinnedParticleContainer();
+        auto tmp = pc->make_alike<amrex::PinnedArenaAllocator>();
+        tmp.SetParticleGeometry(0,pinned_pc->Geom(0));
+        tmp.SetParticleBoxArray(0,pinned_pc->ParticleBoxArray(0));
+        tmp.SetParticleDistributionMap(0, pinned_pc->ParticleDistributionMap(0));
+        tmp.copyParticles(*pinned_pc, true);
+
+        DumpToFile(&tmp,
+           particle_diags[i].getSpeciesName(),
+           m_CurrentStep,
+           real_flags,
+           int_flags,
+           real_names, int_names,
+           pc->getCharge(), pc->getMass(),
+           isBTD, isLastBTDFlush,
+           totalParticlesFlushedAlready[i]
+        );
+    } else {
+        // filter, convert to SI and write the particles directly from the simulation
+        // container, without modifying it or copying it as a whole
+        StreamToFile(pc,
+           particle_diags[i],
+           m_CurrentStep,
+           real_flags,
+           int_flags,
+           real_names, int_names
+        );
+    }
+  }
+}
 
-#ifdef WARPX_DIM_RZ
-    real_names.push_back("theta");
-#endif
+void
+WarpXOpenPMDPlot::StreamToFile (WarpXParticleContainer* pc,
+                    const ParticleDiag& particle_diag,
+                    int iteration,
+                    const amrex::Vector<int>& write_real_comp,
+                    const amrex::Vector<int>& write_int_comp,
+                    const amrex::Vector<std::string>& real_comp_names,
+                    const amrex::Vector<std::string>& int_comp_names)
+{
+    WARPX_PROFILE("WarpXOpenPMDPlot::StreamToFile()");
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_Series != nullptr, "openPMD: series must be initialized");
 
-    // get the names of the real comps
-    real_names.resize(pc->NumRealComps());
-    auto runtime_rnames = pc->getParticleRuntimeComps();
-    for (auto const& x : runtime_rnames)
-    {
-        real_names[x.second+PIdx::nattribs] = detail::snakeToCamel(x.first);
-    }
+    AMREX_ALWAYS_ASSERT(write_real_comp.size() == pc->NumRealComps());
+    AMREX_ALWAYS_ASSERT(write_int_comp.size() == pc->NumIntComps());
+    AMREX_ALWAYS_ASSERT(real_comp_names.size() == pc->NumRealComps());
+    AMREX_ALWAYS_ASSERT(int_comp_names.size() == pc->NumIntComps());
 
-    // plot any "extra" fields by default
-    real_flags = particle_diags[i].plot_flags;
-    real_flags.resize(pc->NumRealComps(), 1);
+    // first pass: select the particles that pass the filters and count them
+    auto const selection = detail::selectParticles(pc, particle_diag);
+    WarpXParticleCounter counter(selection.num_local_particles);
+    auto const num_dump_particles = counter.GetTotalNumParticles();
 
-    // and the names
-    int_names.resize(pc->NumIntComps());
-    auto runtime_inames = pc->getParticleRuntimeiComps();
-    for (auto const& x : runtime_inames)
-    {
-        int_names[x.second+0] = detail::snakeToCamel(x.first);
-    }
+    openPMD::Iteration currIteration = GetIteration(iteration, false);
+    openPMD::ParticleSpecies currSpecies = currIteration.particles[particle_diag.getSpeciesName()];
 
-    // plot by default
-    int_flags.resize(pc->NumIntComps(), 1);
-
-      pc->ConvertUnits(ConvertDirection::WarpX_to_SI);
-
-      RandomFilter const random_filter(particle_diags[i].m_do_random_filter,
-                                       particle_diags[i].m_random_fraction);
-      UniformFilter const uniform_filter(particle_diags[i].m_do_uniform_filter,
-                                         particle_diags[i].m_uniform_stride);
-      ParserFilter parser_filter(particle_diags[i].m_do_parser_filter,
-                                 compileParser<ParticleDiag::m_nvars>
-                                     (particle_diags[i].m_particle_filter_parser.get()),
-                                 pc->getMass());
-      parser_filter.m_units = InputUnits::SI;
-      GeometryFilter const geometry_filter(particle_diags[i].m_do_geom_filter,
-                                           particle_diags[i].m_diag_domain);
-
-      if (! isBTD) {
-          using SrcData = WarpXParticleContainer::ParticleTileType::ConstParticleTileDataType;
-          tmp.copyParticles(*pc,
-                            [=] AMREX_GPU_HOST_DEVICE (const SrcData& src, int ip, const amrex::RandomEngine& engine)
-          {
-              const SuperParticleType& p = src.getSuperParticle(ip);
-              return random_filter(p, engine) * uniform_filter(p, engine)
-                     * parser_filter(p, engine) * geometry_filter(p, engine);
-          }, true);
-      } else if (isBTD) {
-          PinnedMemoryParticleContainer* pinned_pc = particle_diags[i].getPinnedParticleContainer();
-          tmp.SetParticleGeometry(0,pinned_pc->Geom(0));
-          tmp.SetParticleBoxArray(0,pinned_pc->ParticleBoxArray(0));
-          tmp.SetParticleDistributionMap(0, pinned_pc->ParticleDistributionMap(0));
-          tmp.copyParticles(*pinned_pc, true);
-      }
+    SetupPos(currSpecies, num_dump_particles);
+    SetupRealProperties(pc->NumRealComps(), currSpecies, write_real_comp, real_comp_names,
+                        write_int_comp, int_comp_names, num_dump_particles);
+    SetConstParticleRecordsEDPIC(currSpecies, num_dump_particles, pc->getCharge(), pc->getMass());
 
-    // real_names contains a list of all real particle attributes.
-    // real_flags is 1 or 0, whether quantity is dumped or not.
+    // open files from all processors, in case some will not contribute below
+    m_Series->flush();
 
-    {
-      if (isBTD) {
-          DumpToFile(&tmp,
-             particle_diags[i].getSpeciesName(),
-             m_CurrentStep,
-             real_flags,
-             int_flags,
-             real_names, int_names,
-             pc->getCharge(), pc->getMass(),
-             isBTD, isLastBTDFlush,
-             totalParticlesFlushedAlready[i]
-          );
-      } else {
-          DumpToFile(&tmp,
-             particle_diags[i].getSpeciesName(),
-             m_CurrentStep,
-             real_flags,
-             int_flags,
-             real_names, int_names,
-             pc->getCharge(), pc->getMass(),
-             isBTD, isLastBTDFlush,
-             0
-          );
-      }
-    }
+    // second pass: gather the selected particles into the openPMD chunks
+    for (int lev = 0; lev <= pc->finestLevel(); ++lev) {
+        uint64_t offset = static_cast<uint64_t>( counter.m_ParticleOffsetAtRank[lev] );
+        int itile = 0;
+        for (WarpXParIter pti(*pc, lev); pti.isValid(); ++pti, ++itile) {
+            uint64_t const nsel = static_cast<uint64_t>( selection.num_selected[lev][itile] );
 
-    // Convert momentum back to WarpX units
-    pc->ConvertUnits(ConvertDirection::SI_to_WarpX);
-  }
+            // Do not call storeChunk() with zero-sized particle tiles:
+            //   https://github.com/openPMD/openPMD-api/issues/1147
+            if (nsel == 0) continue;
+
+            detail::SeriesChunkBuffers buffers{currSpecies, offset, nsel};
+            detail::storeParticleTileChunks(buffers, pti.GetParticleTile(), selection.getDst(lev, itile),
+                                            write_real_comp, real_comp_names,
+                                            write_int_comp, int_comp_names,
+                                            selection.momentum_factor);
+            offset += nsel;
+        }
+    }
+    // the chunk buffers are filled asynchronously on GPU
+    amrex::Gpu::streamSynchronize();
+    m_Series->flush();
 }
 
 void
@@ -720,7 +1071,7 @@ WarpXOpenPMDPlot::DumpToFile (ParticleContainer* pc,
     //   for BTD, we call this multiple times as we may resize in subsequent dumps if number of particles in the buffer > 0
     if (doParticleSetup || is_resizing_flush) {
         SetupPos(currSpecies, NewParticleVectorSize, isBTD);
-        SetupRealProperties(pc, currSpecies, write_real_comp, real_comp_names, write_int_comp, int_comp_names,
+        SetupRealProperties(pc->NumRealComps(), currSpecies, write_real_comp, real_comp_names, write_int_comp, int_comp_names,
                             NewParticleVectorSize, isBTD);
     }
 
@@ -827,7 +1178,7 @@ WarpXOpenPMDPlot::DumpToFile (ParticleContainer* pc,
 }
 
 void
-WarpXOpenPMDPlot::SetupRealProperties (ParticleContainer const * pc,
+WarpXOpenPMDPlot::SetupRealProperties (int const num_real_comps,
                       openPMD::ParticleSpecies& currSpecies,
                       const amrex::Vector<int>& write_real_comp,
                       const amrex::Vector<std::string>& real_comp_names,
@@ -862,7 +1213,7 @@ WarpXOpenPMDPlot::SetupRealProperties (ParticleContainer const * pc,
     }
 
     std::set< std::string > addedRecords; // add meta-data per record only once
-    for (auto idx=0; idx<pc->NumRealComps(); idx++) {
+    for (auto idx=0; idx<num_real_comps; idx++) {
         auto ii = ParticleContainer::NStructReal + idx; // jump over extra AoS names
         if (write_real_comp[ii]) {
             // handle scalar and non-scalar records by name
@@ -1171,7 +1522,7 @@ WarpXOpenPMDPlot::SetupMeshComp (openPMD::Mesh& mesh,
                                  amrex::Geometry& full_geom,
                                  std::string comp_name,
                                  std::string field_name,
-                                 amrex::MultiFab const& mf,
+                                 amrex::IndexType const ixtype,
                                  bool var_in_theta_mode) const
 {
     auto mesh_comp = mesh[comp_name];
@@ -1205,7 +1556,7 @@ WarpXOpenPMDPlot::SetupMeshComp (openPMD::Mesh& mesh,
     mesh_comp.resetDataset(dataset);
 
     detail::setOpenPMDUnit( mesh, field_name );
-    auto relative_cell_pos = utils::getRelativeCellPosition(mf);     // AMReX Fortran index order
+    auto relative_cell_pos = utils::getRelativeCellPosition(ixtype); // AMReX Fortran index order
     std::reverse( relative_cell_pos.begin(), relative_cell_pos.end() ); // now in C order
     mesh_comp.setPosition( relative_cell_pos );
 }
@@ -1284,6 +1635,91 @@ GetFieldNameModeInt (const std::string& varname)
     }
 }
 
+/** Store the data of one box of a field component as a chunk of an openPMD mesh record component
+ *
+ * @param[in] mesh_comp the openPMD mesh record component
+ * @param[in] global_box the box of the whole domain
+ * @param[in] local_box the box of the chunk
+ * @param[in] mode_index index of the RZ azimuthal mode (see GetFieldNameModeInt), or -1
+ * @param[in] data host data of the chunk
+ */
+void
+StoreMeshChunk (openPMD::MeshRecordComponent& mesh_comp,
+                amrex::Box const& global_box,
+                amrex::Box const& local_box,
+                int const mode_index,
+                std::shared_ptr<amrex::Real> const& data)
+{
+    // Determine the offset and size of this chunk
+    amrex::IntVect const box_offset = local_box.smallEnd() - global_box.smallEnd();
+    auto chunk_offset = getReversedVec( box_offset );
+    auto chunk_size = getReversedVec( local_box.size() );
+
+    if (mode_index != -1) {
+        chunk_offset.emplace(chunk_offset.begin(), mode_index);
+        chunk_size.emplace(chunk_size.begin(), 1);
+    }
+
+    mesh_comp.storeChunk(data, chunk_offset, chunk_size);
+}
+
+void
+WarpXOpenPMDPlot::SetupMeshComps (openPMD::Container< openPMD::Mesh >& meshes,
+                                  const std::vector<std::string>& varnames,
+                                  int lev,
+                                  amrex::Geometry& full_geom,
+                                  amrex::IndexType const ixtype) const
+{
+    for ( std::string const & varname : varnames ) {
+        auto [varname_no_mode, mode_index] = GetFieldNameModeInt(varname);
+        bool var_in_theta_mode = mode_index != -1; // thetaMode or reconstructed Cartesian 2D slice
+        std::string field_name = varname_no_mode;
+        std::string comp_name = openPMD::MeshRecordComponent::SCALAR;
+        // assume fields are scalar unless they match the following match of known vector fields
+        GetMeshCompNames( lev, varname_no_mode, field_name, comp_name, var_in_theta_mode );
+        if (comp_name == openPMD::MeshRecordComponent::SCALAR) {
+            if ( ! meshes.contains(field_name) ) {
+                auto mesh = meshes[field_name];
+                SetupMeshComp(  mesh,
+                                full_geom,
+                                comp_name,
+                                field_name,
+                                ixtype,
+                                var_in_theta_mode );
+            }
+        } else {
+            auto mesh = meshes[field_name];
+            if ( ! mesh.contains(comp_name) ) {
+                SetupMeshComp(  mesh,
+                                full_geom,
+                                comp_name,
+                                field_name,
+                                ixtype,
+                                var_in_theta_mode );
+            }
+        }
+    }
+}
+
+openPMD::MeshRecordComponent
+WarpXOpenPMDPlot::GetMeshComp (openPMD::Container< openPMD::Mesh >& meshes,
+                               const std::string& varname,
+                               int lev,
+                               int& mode_index) const
+{
+    auto [varname_no_mode, varname_mode_index] = GetFieldNameModeInt(varname);
+    mode_index = varname_mode_index;
+    bool var_in_theta_mode = mode_index != -1;
+
+    std::string field_name(varname_no_mode);
+    std::string comp_name = openPMD::MeshRecordComponent::SCALAR;
+    // assume fields are scalar unless they match the following match of known vector fields
+    GetMeshCompNames( lev, varname_no_mode, field_name, comp_name, var_in_theta_mode );
+
+    auto mesh = meshes[field_name];
+    return mesh[comp_name];
+}
+
 /** Write Field with all mesh levels
  *
  */
@@ -1333,55 +1769,13 @@ WarpXOpenPMDPlot::WriteOpenPMDFieldsAll ( //const std::string& filename,
 
         amrex::Box const & global_box = full_geom.Domain();
 
-        int const ncomp = mf[lev].nComp();
-        for ( int icomp=0; icomp<ncomp; icomp++ ) {
-            std::string const & varname = varnames[icomp];
-
-            auto [varname_no_mode, mode_index] = GetFieldNameModeInt(varname);
-            bool var_in_theta_mode = mode_index != -1; // thetaMode or reconstructed Cartesian 2D slice
-            std::string field_name = varname_no_mode;
-            std::string comp_name = openPMD::MeshRecordComponent::SCALAR;
-            // assume fields are scalar unless they match the following match of known vector fields
-            GetMeshCompNames( lev, varname_no_mode, field_name, comp_name, var_in_theta_mode );
-            if ( first_write_to_iteration )
-            {
-                if (comp_name == openPMD::MeshRecordComponent::SCALAR) {
-                    if ( ! meshes.contains(field_name) ) {
-                        auto mesh = meshes[field_name];
-                        SetupMeshComp(  mesh,
-                                        full_geom,
-                                        comp_name,
-                                        field_name,
-                                        mf[lev],
-                                        var_in_theta_mode );
-                    }
-                } else {
-                    auto mesh = meshes[field_name];
-                    if ( ! mesh.contains(comp_name) ) {
-                        SetupMeshComp(  mesh,
-                                        full_geom,
-                                        comp_name,
-                                        field_name,
-                                        mf[lev],
-                                        var_in_theta_mode );
-                    }
-                }
-            }
-        } // icomp setup loop
+        if ( first_write_to_iteration )
+            SetupMeshComps(meshes, varnames, lev, full_geom, mf[lev].ixType());
 
+        int const ncomp = mf[lev].nComp();
         for ( int icomp=0; icomp<ncomp; icomp++ ) {
-            std::string const & varname = varnames[icomp];
-
-            auto [varname_no_mode, mode_index] = GetFieldNameModeInt(varname);
-            [[maybe_unused]] bool var_in_theta_mode = mode_index != -1;
-
-            std::string field_name(varname_no_mode);
-            std::string comp_name = openPMD::MeshRecordComponent::SCALAR;
-            // assume fields are scalar unless they match the following match of known vector fields
-            GetMeshCompNames( lev, varname_no_mode, field_name, comp_name, var_in_theta_mode );
-
-            auto mesh = meshes[field_name];
-            auto mesh_comp = mesh[comp_name];
+            int mode_index = -1;
+            auto mesh_comp = GetMeshComp(meshes, varnames[icomp], lev, mode_index);
 
             // Loop through the multifab, and store each box as a chunk,
             // in the openPMD file.
@@ -1390,16 +1784,6 @@ WarpXOpenPMDPlot::WriteOpenPMDFieldsAll ( //const std::string& filename,
                 amrex::FArrayBox const& fab = mf[lev][mfi];
                 amrex::Box const& local_box = fab.box();
 
-                // Determine the offset and size of this chunk
-                amrex::IntVect const box_offset = local_box.smallEnd() - global_box.smallEnd();
-                auto chunk_offset = getReversedVec( box_offset );
-                auto chunk_size = getReversedVec( local_box.size() );
-
-                if (var_in_theta_mode) {
-                    chunk_offset.emplace(chunk_offset.begin(), mode_index);
-                    chunk_size.emplace(chunk_size.begin(), 1);
-                }
-
                 // we avoid relying on managed memory by copying explicitly to host
                 //   remove the copies and "streamSynchronize" if you like to pass
                 //   GPU pointers to the I/O library
@@ -1409,13 +1793,13 @@ WarpXOpenPMDPlot::WriteOpenPMDFieldsAll ( //const std::string& filename,
                     std::shared_ptr<amrex::Real> data_pinned(foo.release());
                     amrex::Gpu::dtoh_memcpy_async(data_pinned.get(), fab.dataPtr(icomp), local_box.numPts()*sizeof(amrex::Real));
                     // intentionally delayed until before we .flush(): amrex::Gpu::streamSynchronize();
-                    mesh_comp.storeChunk(data_pinned, chunk_offset, chunk_size);
+                    StoreMeshChunk(mesh_comp, global_box, local_box, mode_index, data_pinned);
                 } else
 #endif
                 {
                     amrex::Real const *local_data = fab.dataPtr(icomp);
-                    mesh_comp.storeChunk(openPMD::shareRaw(local_data),
-                                         chunk_offset, chunk_size);
+                    StoreMeshChunk(mesh_comp, global_box, local_box, mode_index,
+                                   openPMD::shareRaw(local_data));
                 }
             }
         } // icomp store loop
@@ -1427,6 +1811,144 @@ WarpXOpenPMDPlot::WriteOpenPMDFieldsAll ( //const std::string& filename,
         m_Series->flush();
     } // levels loop (i)
 }
+
+OpenPMDSnapshot
+WarpXOpenPMDPlot::TakeSnapshot (const std::vector<std::string>& varnames,
+                                const amrex::Vector<amrex::MultiFab>& mf,
+                                const amrex::Vector<amrex::Geometry>& geom,
+                                int output_levels,
+                                const int iteration,
+                                const double time,
+                                const amrex::Vector<ParticleDiag>& particle_diags,
+                                const std::string& prefix,
+                                int file_min_digits) const
+{
+    WARPX_PROFILE("WarpXOpenPMDPlot::TakeSnapshot()");
+
+    OpenPMDSnapshot snapshot;
+    snapshot.iteration = iteration;
+    snapshot.time = time;
+    snapshot.prefix = prefix;
+    snapshot.file_min_digits = file_min_digits;
+    snapshot.varnames = varnames;
+
+    // fields: copy each box of each component to a host buffer
+    for (int lev=0; lev < output_levels; lev++) {
+        snapshot.geom.push_back(geom[lev]);
+        snapshot.ixtype.push_back(mf[lev].ixType());
+        int const ncomp = mf[lev].nComp();
+        for ( int icomp=0; icomp<ncomp; icomp++ ) {
+            for( amrex::MFIter mfi(mf[lev]); mfi.isValid(); ++mfi )
+            {
+                amrex::FArrayBox const& fab = mf[lev][mfi];
+                amrex::Box const& local_box = fab.box();
+                auto const npts = static_cast<std::size_t>(local_box.numPts());
+                auto data = detail::makeHostBuffer<amrex::Real>(npts);
+#ifdef AMREX_USE_GPU
+                if (fab.arena()->isManaged() || fab.arena()->isDevice()) {
+                    amrex::Gpu::dtoh_memcpy_async(data.get(), fab.dataPtr(icomp), npts*sizeof(amrex::Real));
+                } else
+#endif
+                {
+                    std::memcpy(data.get(), fab.dataPtr(icomp), npts*sizeof(amrex::Real));
+                }
+                snapshot.field_chunks.push_back({lev, icomp, local_box, data});
+            }
+        }
+    }
+
+    // particles: filter, convert to SI and copy to host buffers
+    for (auto const& particle_diag : particle_diags) {
+        WarpXParticleContainer* pc = particle_diag.getParticleContainer();
+        OpenPMDSnapshot::Species species;
+        species.name = particle_diag.getSpeciesName();
+        species.charge = pc->getCharge();
+        species.mass = pc->getMass();
+        species.num_real_comps = pc->NumRealComps();
+        detail::getParticleAttributes(pc, particle_diag, species.real_names, species.int_names,
+                                      species.real_flags, species.int_flags);
+
+        auto const selection = detail::selectParticles(pc, particle_diag);
+        WarpXParticleCounter counter(selection.num_local_particles);
+        species.np = counter.GetTotalNumParticles();
+
+        for (int lev = 0; lev <= pc->finestLevel(); ++lev) {
+            uint64_t offset = static_cast<uint64_t>( counter.m_ParticleOffsetAtRank[lev] );
+            int itile = 0;
+            for (WarpXParIter pti(*pc, lev); pti.isValid(); ++pti, ++itile) {
+                uint64_t const nsel = static_cast<uint64_t>( selection.num_selected[lev][itile] );
+                if (nsel == 0) continue;
+
+                detail::SnapshotChunkBuffers buffers{species.chunks, offset, nsel};
+                detail::storeParticleTileChunks(buffers, pti.GetParticleTile(), selection.getDst(lev, itile),
+                                                species.real_flags, species.real_names,
+                                                species.int_flags, species.int_names,
+                                                selection.momentum_factor);
+                offset += nsel;
+            }
+        }
+        snapshot.species.push_back(std::move(species));
+    }
+
+    // the host buffers are filled asynchronously on GPU
+    amrex::Gpu::streamSynchronize();
+
+    return snapshot;
+}
+
+void
+WarpXOpenPMDPlot::WriteSnapshot (OpenPMDSnapshot const& snapshot)
+{
+    // note: this can run on a background I/O thread, so it must not use
+    //       AMReX data containers, the AMReX profiler or the main MPI communicator
+    SetStep(snapshot.iteration, snapshot.prefix, snapshot.file_min_digits);
+
+    openPMD::Iteration series_iteration = GetIteration(m_CurrentStep, false);
+    series_iteration.open();
+    series_iteration.setTime( snapshot.time );
+
+    // fields
+    auto meshes = series_iteration.meshes;
+    int const output_levels = snapshot.geom.size();
+    for (int lev=0; lev < output_levels; lev++) {
+        amrex::Geometry full_geom = snapshot.geom[lev];
+        if (0 == lev)
+            SetupFields(meshes, full_geom);
+        SetupMeshComps(meshes, snapshot.varnames, lev, full_geom, snapshot.ixtype[lev]);
+
+        amrex::Box const & global_box = full_geom.Domain();
+        for (auto const& chunk : snapshot.field_chunks) {
+            if (chunk.lev != lev) continue;
+            int mode_index = -1;
+            auto mesh_comp = GetMeshComp(meshes, snapshot.varnames[chunk.icomp], lev, mode_index);
+            StoreMeshChunk(mesh_comp, global_box, chunk.box, mode_index, chunk.data);
+        }
+        m_Series->flush();
+    }
+
+    // particles
+    for (auto const& species : snapshot.species) {
+        openPMD::ParticleSpecies currSpecies = series_iteration.particles[species.name];
+        SetupPos(currSpecies, species.np);
+        SetupRealProperties(species.num_real_comps, currSpecies, species.real_flags, species.real_names,
+                            species.int_flags, species.int_names, species.np);
+        SetConstParticleRecordsEDPIC(currSpecies, species.np, species.charge, species.mass);
+
+        // open files from all processors, in case some will not contribute below
+        m_Series->flush();
+
+        for (auto const& chunk : species.chunks) {
+            auto record_comp = currSpecies[chunk.record_name][chunk.component_name];
+            std::visit([&](auto const& data) {
+                record_comp.storeChunk(data, {chunk.offset}, {chunk.extent});
+            }, chunk.data);
+        }
+        m_Series->flush();
+    }
+
+    // signal that no further updates will be written to this iteration
+    CloseStep();
+}
 #endif // WARPX_USE_OPENPMD
 
 
@@ -1436,21 +1958,38 @@ WarpXOpenPMDPlot::WriteOpenPMDFieldsAll ( //const std::string& filename,
 //
 WarpXParticleCounter::WarpXParticleCounter (ParticleContainer* pc)
 {
-  m_MPISize = amrex::ParallelDescriptor::NProcs();
-  m_MPIRank = amrex::ParallelDescriptor::MyProc();
-
-  m_ParticleCounterByLevel.resize(pc->finestLevel()+1);
-  m_ParticleOffsetAtRank.resize(pc->finestLevel()+1);
-  m_ParticleSizeAtRank.resize(pc->finestLevel()+1);
+  std::vector<long> numParticlesByLevel(pc->finestLevel()+1, 0);
 
   for (auto currentLevel = 0; currentLevel <= pc->finestLevel(); currentLevel++)
     {
-      long numParticles = 0; // numParticles in this processor
-
       for (ParticleIter pti(*pc, currentLevel); pti.isValid(); ++pti) {
           auto numParticleOnTile = pti.numParticles();
-          numParticles += numParticleOnTile;
+          numParticlesByLevel[currentLevel] += numParticleOnTile;
       }
+    }
+
+  CountParticles(numParticlesByLevel);
+}
+
+WarpXParticleCounter::WarpXParticleCounter (std::vector<long> const& numParticlesByLevel)
+{
+  CountParticles(numParticlesByLevel);
+}
+
+void
+WarpXParticleCounter::CountParticles (std::vector<long> const& numParticlesByLevel)
+{
+  m_MPISize = amrex::ParallelDescriptor::NProcs();
+  m_MPIRank = amrex::ParallelDescriptor::MyProc();
+
+  auto const nLevels = numParticlesByLevel.size();
+  m_ParticleCounterByLevel.resize(nLevels);
+  m_ParticleOffsetAtRank.resize(nLevels);
+  m_ParticleSizeAtRank.resize(nLevels);
+
+  for (std::size_t currentLevel = 0; currentLevel < nLevels; currentLevel++)
+    {
+      long const numParticles = numParticlesByLevel[currentLevel]; // numParticles in this processor
 
       unsigned long long offset=0; // offset of this level
       unsigned long long sum=0; // numParticles in this level (sum from all processors)
@@ -1462,7 +2001,7 @@ WarpXParticleCounter::WarpXParticleCounter (ParticleContainer* pc)
       m_ParticleSizeAtRank[currentLevel] = numParticles;
 
       // adjust offset, it should be numbered after particles from previous levels
-      for (auto lv=0; lv<currentLevel; lv++)
+      for (std::size_t lv=0; lv<currentLevel; lv++)
     m_ParticleOffsetAtRank[currentLevel] += m_ParticleCounterByLevel[lv];
 
       m_Total += sum;
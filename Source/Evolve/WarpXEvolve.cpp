@@ -23,10 +23,14 @@
 #   endif
 #endif
 #include "Parallelization/GuardCellManager.H"
+#include "Parallelization/WarpXCommUtil.H"
+#include "Parallelization/WarpXSumGuardCells.H"
 #include "Particles/MultiParticleContainer.H"
 #include "Particles/ParticleBoundaryBuffer.H"
+#include "Particles/WarpXParticleContainer.H"
 #include "Python/WarpX_py.H"
 #include "Utils/IntervalsParser.H"
+#include "Utils/PhaseTimers.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXConst.H"
@@ -81,6 +85,7 @@ WarpX::Evolve (int numsteps)
     {
         WARPX_PROFILE("WarpX::Evolve::step");
         Real evolve_time_beg_step = amrex::second();
+        PhaseTimers::BeginStep();
 
         CheckSignals();
 
@@ -126,6 +131,7 @@ WarpX::Evolve (int numsteps)
                 // Not called at each iteration, so exchange all guard cells
                 FillBoundaryE(guard_cells.ng_alloc_EB);
                 FillBoundaryB(guard_cells.ng_alloc_EB);
+                m_fdtd_blocking_substeps = 0;
                 UpdateAuxilaryData();
                 FillBoundaryAux(guard_cells.ng_UpdateAux);
             }
@@ -143,8 +149,13 @@ WarpX::Evolve (int numsteps)
                 // Particles have p^{n-1/2} and x^{n}.
 
                 // E and B are up-to-date inside the domain only
-                FillBoundaryE(guard_cells.ng_FieldGather);
-                FillBoundaryB(guard_cells.ng_FieldGather);
+                // (with temporal blocking, also in enough guard cells for
+                // a few steps, and these are then exchanged only when outdated)
+                if (FDTDBlockingNeedsExchange()) {
+                    FillBoundaryE(guard_cells.ng_FieldGather);
+                    FillBoundaryB(guard_cells.ng_FieldGather);
+                    m_fdtd_blocking_substeps = 0;
+                }
                 // E and B: enough guard cells to update Aux or call Field Gather in fp and cp
                 // Need to update Aux on lower levels, to interpolate to higher levels.
                 if (fft_do_time_averaging)
@@ -162,6 +173,7 @@ WarpX::Evolve (int numsteps)
 
         // Run multi-physics modules:
         // ionization, Coulomb collisions, QED
+        PhaseTimers::Start(PhaseTimers::Collisions);
         doFieldIonization();
         ExecutePythonCallback("beforecollisions");
         mypc->doCollisions( cur_time, dt[0] );
@@ -170,6 +182,7 @@ WarpX::Evolve (int numsteps)
         doQEDEvents();
         mypc->doQEDSchwinger();
 #endif
+        PhaseTimers::Stop();
 
         // Main PIC operation:
         // gather fields, push particles, deposit sources, update fields
@@ -222,6 +235,7 @@ WarpX::Evolve (int numsteps)
             // At the end of last step, push p by 0.5*dt to synchronize
             FillBoundaryE(guard_cells.ng_FieldGather);
             FillBoundaryB(guard_cells.ng_FieldGather);
+            m_fdtd_blocking_substeps = 0;
             if (fft_do_time_averaging)
             {
                 FillBoundaryE_avg(guard_cells.ng_FieldGather);
@@ -248,6 +262,7 @@ WarpX::Evolve (int numsteps)
         ShiftGalileanBoundary();
 
         if (do_back_transformed_diagnostics) {
+            PhaseTimers::Scope phase_timer(PhaseTimers::Diagnostics);
             std::unique_ptr<MultiFab> cell_centered_data = nullptr;
             if (WarpX::do_back_transformed_fields) {
                 cell_centered_data = GetCellCenteredData();
@@ -260,7 +275,9 @@ WarpX::Evolve (int numsteps)
         for (int i = 0; i <= max_level; ++i) {
             t_new[i] = cur_time;
         }
+        PhaseTimers::Start(PhaseTimers::Diagnostics);
         multi_diags->FilterComputePackFlush( step, false, true );
+        PhaseTimers::Stop();
 
         bool move_j = is_synchronized;
         // If is_synchronized we need to shift j too so that next step we can evolve E by dt/2.
@@ -269,6 +286,7 @@ WarpX::Evolve (int numsteps)
 
         mypc->ContinuousFluxInjection(cur_time, dt[0]);
 
+        PhaseTimers::Start(PhaseTimers::Redistribute);
         mypc->ApplyBoundaryConditions();
 
         // interact the particles with EB walls (if present)
@@ -308,6 +326,7 @@ WarpX::Evolve (int numsteps)
             }
             mypc->SortParticlesByBin(sort_bin_size);
         }
+        PhaseTimers::Stop();
 
         if( do_electrostatic != ElectrostaticSolverAlgo::None ) {
             ExecutePythonCallback("beforeEsolve");
@@ -326,14 +345,22 @@ WarpX::Evolve (int numsteps)
         // in the evolve timing.
         ExecutePythonCallback("afterstep");
 
+        PhaseTimers::Start(PhaseTimers::Diagnostics);
         /// reduced diags
         if (reduced_diags->m_plot_rd != 0)
         {
             reduced_diags->LoadBalance();
             reduced_diags->ComputeDiags(step);
             reduced_diags->WriteToFile(step);
+            // write the buffered rows before a checkpoint, so that the reduced diags
+            // files are complete up to the checkpoint when restarting from it
+            if (multi_diags->DoCheckpoint(step)) {
+                reduced_diags->CompleteDeferredReductions();
+                reduced_diags->FlushToFile();
+            }
         }
         multi_diags->FilterComputePackFlush( step );
+        PhaseTimers::Stop();
 
         // execute afterdiagnostic callbacks
         ExecutePythonCallback("afterdiagnostics");
@@ -348,6 +375,7 @@ WarpX::Evolve (int numsteps)
 
         // create ending time stamp for calculating elapsed time each iteration
         Real evolve_time_end_step = amrex::second();
+        PhaseTimers::EndStep();
         evolve_time += evolve_time_end_step - evolve_time_beg_step;
 
         HandleSignals();
@@ -366,6 +394,10 @@ WarpX::Evolve (int numsteps)
 
         // End loop on time steps
     }
+    if (reduced_diags->m_plot_rd != 0) {
+        reduced_diags->CompleteDeferredReductions();
+        reduced_diags->FlushToFile();
+    }
     multi_diags->FilterComputePackFlushLastTimestep( istep[0] );
 
     if (do_back_transformed_diagnostics) {
@@ -453,6 +485,13 @@ WarpX::OneStep_nosub (Real cur_time)
         if (do_pml) {
             NodalSyncPML();
         }
+    } else if (use_fused_maxwell_kernel) {
+        // B and E are updated in one sweep, without guard-cell exchange
+        // in between (with temporal blocking)
+        EvolveBEBFused(dt[0]); // We now have E^{n+1} and B^{n+1}
+
+        NodalSync(Efield_fp, Efield_cp);
+        NodalSync(Bfield_fp, Bfield_cp);
     } else {
         EvolveF(0.5_rt * dt[0], DtType::FirstHalf);
         EvolveG(0.5_rt * dt[0], DtType::FirstHalf);
@@ -460,7 +499,9 @@ WarpX::OneStep_nosub (Real cur_time)
         FillBoundaryG(guard_cells.ng_FieldSolverG);
         EvolveB(0.5_rt * dt[0], DtType::FirstHalf); // We now have B^{n+1/2}
 
-        FillBoundaryB(guard_cells.ng_FieldSolver);
+        // With temporal blocking, the guard cells needed by the next update
+        // were updated as well
+        if (!fdtd_temporal_blocking) FillBoundaryB(guard_cells.ng_FieldSolver);
 
         if (WarpX::em_solver_medium == MediumForEM::Vacuum) {
             // vacuum medium
@@ -472,7 +513,7 @@ WarpX::OneStep_nosub (Real cur_time)
             amrex::Abort(" Medium for EM is unknown \n");
         }
 
-        FillBoundaryE(guard_cells.ng_FieldSolver);
+        if (!fdtd_temporal_blocking) FillBoundaryE(guard_cells.ng_FieldSolver);
         EvolveF(0.5_rt * dt[0], DtType::SecondHalf);
         EvolveG(0.5_rt * dt[0], DtType::SecondHalf);
         EvolveB(0.5_rt * dt[0], DtType::SecondHalf); // We now have B^{n+1}
@@ -856,6 +897,8 @@ WarpX::PushParticlesandDepose (amrex::Real cur_time, bool skip_deposition)
 void
 WarpX::PushParticlesandDepose (int lev, amrex::Real cur_time, DtType a_dt_type, bool skip_deposition)
 {
+    PhaseTimers::Scope phase_timer(PhaseTimers::PushDeposit);
+
     amrex::MultiFab* current_x = nullptr;
     amrex::MultiFab* current_y = nullptr;
     amrex::MultiFab* current_z = nullptr;
@@ -879,15 +922,53 @@ WarpX::PushParticlesandDepose (int lev, amrex::Real cur_time, DtType a_dt_type,
         current_z = current_fp[lev][2].get();
     }
 
-    mypc->Evolve(lev,
-                 *Efield_aux[lev][0],*Efield_aux[lev][1],*Efield_aux[lev][2],
-                 *Bfield_aux[lev][0],*Bfield_aux[lev][1],*Bfield_aux[lev][2],
-                 *current_x, *current_y, *current_z,
-                 current_buf[lev][0].get(), current_buf[lev][1].get(), current_buf[lev][2].get(),
-                 rho_fp[lev].get(), charge_buf[lev].get(),
-                 Efield_cax[lev][0].get(), Efield_cax[lev][1].get(), Efield_cax[lev][2].get(),
-                 Bfield_cax[lev][0].get(), Bfield_cax[lev][1].get(), Bfield_cax[lev][2].get(),
-                 cur_time, dt[lev], a_dt_type, skip_deposition);
+    auto evolve = [&] () {
+        mypc->Evolve(lev,
+                     *Efield_aux[lev][0],*Efield_aux[lev][1],*Efield_aux[lev][2],
+                     *Bfield_aux[lev][0],*Bfield_aux[lev][1],*Bfield_aux[lev][2],
+                     *current_x, *current_y, *current_z,
+                     current_buf[lev][0].get(), current_buf[lev][1].get(), current_buf[lev][2].get(),
+                     rho_fp[lev].get(), charge_buf[lev].get(),
+                     Efield_cax[lev][0].get(), Efield_cax[lev][1].get(), Efield_cax[lev][2].get(),
+                     Bfield_cax[lev][0].get(), Bfield_cax[lev][1].get(), Bfield_cax[lev][2].get(),
+                     cur_time, dt[lev], a_dt_type, skip_deposition);
+    };
+
+    if (do_overlap_current_sum && !skip_deposition)
+    {
+        // The tiles whose deposition reaches the cells that are exchanged with the
+        // neighboring boxes (the cells within ng_depos_J of the edges of the box and,
+        // with PSATD, the guard cells of the neighboring boxes) deposit first
+        amrex::Vector<amrex::MultiFab*> mf_J(3);
+        amrex::Vector<amrex::IntVect> ng_depos_J(3);
+        amrex::IntVect reach = amrex::IntVect::TheZeroVector();
+        for (int idim = 0; idim < 3; ++idim) {
+            mf_J[idim] = current_fp[lev][idim].get();
+            ng_depos_J[idim] = amrex::min(get_ng_depos_J(), mf_J[idim]->nGrowVect());
+            const amrex::IntVect ng_updated = (WarpX::maxwell_solver_id == MaxwellSolverAlgo::PSATD ||
+                                               WarpX::fdtd_temporal_blocking > 0) ?
+                mf_J[idim]->nGrowVect() : amrex::IntVect::TheZeroVector();
+            reach.max(get_ng_depos_J() + amrex::max(ng_depos_J[idim], ng_updated));
+        }
+        WarpXParticleContainer::tile_selection_reach = reach;
+        WarpXParticleContainer::tile_selection = WarpXParticleContainer::TileSelection::Boundary;
+        evolve();
+
+        // The summation of the guard cells is started, and completed in SyncCurrent,
+        // while the other tiles deposit in the cells that are not exchanged
+        {
+            PhaseTimers::Scope comm_timer(PhaseTimers::Communication);
+            WarpXSumGuardCells_nowait(*m_pending_current_sum, mf_J, Geom(lev).periodicity(),
+                                      ng_depos_J, 0, mf_J[0]->nComp());
+        }
+        WarpXParticleContainer::tile_selection = WarpXParticleContainer::TileSelection::Interior;
+        evolve();
+        WarpXParticleContainer::tile_selection = WarpXParticleContainer::TileSelection::All;
+    }
+    else
+    {
+        evolve();
+    }
 #ifdef WARPX_DIM_RZ
     if (! skip_deposition) {
         // This is called after all particles have deposited their current and charge.
@@ -977,6 +1058,10 @@ WarpX::HandleSignals()
     // SIGNAL_REQUESTS_BREAK is handled directly in WarpX::Evolve
 
     if (SignalHandling::TestAndResetActionRequestFlag(SignalHandling::SIGNAL_REQUESTS_CHECKPOINT)) {
+        if (reduced_diags->m_plot_rd != 0) {
+            reduced_diags->CompleteDeferredReductions();
+            reduced_diags->FlushToFile();
+        }
         multi_diags->FilterComputePackFlushLastTimestep( istep[0] );
     }
 }
@@ -7,6 +7,9 @@
 #include "WarpX.H"
 
 #include "FieldSolver/ElectrostaticSolver.H"
+#ifdef WARPX_USE_PSATD
+#   include "FieldSolver/SpectralSolver/IntegratedGreenFunctionSolver.H"
+#endif
 #include "Parallelization/GuardCellManager.H"
 #include "Particles/MultiParticleContainer.H"
 #include "Particles/WarpXParticleContainer.H"
@@ -52,6 +55,7 @@ void
 WarpX::ComputeSpaceChargeField (bool const reset_fields)
 {
     WARPX_PROFILE("WarpX::ComputeSpaceChargeField");
+    m_poisson_solver_stats = ElectrostaticSolver::PoissonSolverStats();
     if (reset_fields) {
         // Reset all E and B fields to 0, before calculating space-charge fields
         WARPX_PROFILE("WarpX::ComputeSpaceChargeField::reset_fields");
@@ -81,6 +85,11 @@ WarpX::ComputeSpaceChargeField (bool const reset_fields)
         // Add the field due to the boundary potentials
         if (do_electrostatic == ElectrostaticSolverAlgo::Relativistic){
             AddBoundaryField();
+        } else {
+            // The self fields are only computed at initialization:
+            // the potentials do not need to be kept
+            m_rho_relativistic.clear();
+            m_phi_relativistic.clear();
         }
     }
     // Transfer fields from 'fp' array to 'aux' array.
@@ -104,19 +113,14 @@ WarpX::AddBoundaryField ()
     // stored yet
     if (!field_boundary_handler.bcs_set) field_boundary_handler.definePhiBCs();
 
-    // Allocate fields for charge and potential
-    const int num_levels = max_level + 1;
-    Vector<std::unique_ptr<MultiFab> > rho(num_levels);
-    Vector<std::unique_ptr<MultiFab> > phi(num_levels);
-    // Use number of guard cells used for local deposition of rho
-    const amrex::IntVect ng = guard_cells.ng_depos_rho;
+    // Get the fields for charge and potential (the potential of the boundaries
+    // is in the last slot, and starts from its value at the last step)
+    const int slot = mypc->nSpecies();
+    AllocRelativisticFields(slot);
+    Vector<std::unique_ptr<MultiFab> >& rho = m_rho_relativistic;
+    Vector<std::unique_ptr<MultiFab> >& phi = m_phi_relativistic[slot];
     for (int lev = 0; lev <= max_level; lev++) {
-        BoxArray nba = boxArray(lev);
-        nba.surroundingNodes();
-        rho[lev] = std::make_unique<MultiFab>(nba, DistributionMap(lev), 1, ng);
         rho[lev]->setVal(0.);
-        phi[lev] = std::make_unique<MultiFab>(nba, DistributionMap(lev), 1, 1);
-        phi[lev]->setVal(0.);
     }
 
     // Set the boundary potentials appropriately
@@ -149,19 +153,13 @@ WarpX::AddSpaceChargeField (WarpXParticleContainer& pc)
                                      "Error: RZ electrostatic only implemented for a single mode");
 #endif
 
-    // Allocate fields for charge and potential
-    const int num_levels = max_level + 1;
-    Vector<std::unique_ptr<MultiFab> > rho(num_levels);
-    Vector<std::unique_ptr<MultiFab> > phi(num_levels);
-    // Use number of guard cells used for local deposition of rho
-    const amrex::IntVect ng = guard_cells.ng_depos_rho;
-    for (int lev = 0; lev <= max_level; lev++) {
-        BoxArray nba = boxArray(lev);
-        nba.surroundingNodes();
-        rho[lev] = std::make_unique<MultiFab>(nba, DistributionMap(lev), 1, ng);
-        phi[lev] = std::make_unique<MultiFab>(nba, DistributionMap(lev), 1, 1);
-        phi[lev]->setVal(0.);
-    }
+    // Get the fields for charge and potential (the potential of this species
+    // starts from its value at the last step)
+    int slot = 0;
+    while (slot < mypc->nSpecies() && &mypc->GetParticleContainer(slot) != &pc) ++slot;
+    AllocRelativisticFields(slot);
+    Vector<std::unique_ptr<MultiFab> >& rho = m_rho_relativistic;
+    Vector<std::unique_ptr<MultiFab> >& phi = m_phi_relativistic[slot];
 
     // Deposit particle charge density (source of Poisson solver)
     bool const local = false;
@@ -175,9 +173,13 @@ WarpX::AddSpaceChargeField (WarpXParticleContainer& pc)
     for (Real& beta_comp : beta) beta_comp /= PhysConst::c; // Normalize
 
     // Compute the potential phi, by solving the Poisson equation
-    computePhi( rho, phi, beta, pc.self_fields_required_precision,
-                pc.self_fields_absolute_tolerance, pc.self_fields_max_iters,
-                pc.self_fields_verbosity );
+    if (pc.self_fields_solver == SelfFieldsSolverAlgo::FFTIGF) {
+        computePhiIGF( rho, phi, beta );
+    } else {
+        computePhi( rho, phi, beta, pc.self_fields_required_precision,
+                    pc.self_fields_absolute_tolerance, pc.self_fields_max_iters,
+                    pc.self_fields_verbosity );
+    }
 
     // Compute the corresponding electric and magnetic field, from the potential phi
     computeE( Efield_fp, phi, beta );
@@ -247,6 +249,36 @@ WarpX::AddSpaceChargeFieldLabFrame ()
     computeB( Bfield_fp, phi_fp, beta );
 }
 
+void
+WarpX::AllocRelativisticFields (int slot)
+{
+    const int num_levels = max_level + 1;
+    if (static_cast<int>(m_phi_relativistic.size()) <= slot) {
+        m_phi_relativistic.resize(slot+1);
+    }
+    m_rho_relativistic.resize(num_levels);
+    m_phi_relativistic[slot].resize(num_levels);
+
+    // Use number of guard cells used for local deposition of rho
+    const amrex::IntVect ng = guard_cells.ng_depos_rho;
+    for (int lev = 0; lev < num_levels; lev++) {
+        BoxArray nba = boxArray(lev);
+        nba.surroundingNodes();
+        auto& rho = m_rho_relativistic[lev];
+        if (!rho || rho->boxArray() != nba || rho->DistributionMap() != DistributionMap(lev)) {
+            rho = std::make_unique<MultiFab>(nba, DistributionMap(lev), 1, ng);
+        }
+        auto& phi = m_phi_relativistic[slot][lev];
+        if (!phi || phi->boxArray() != nba || phi->DistributionMap() != DistributionMap(lev)) {
+            phi = std::make_unique<MultiFab>(nba, DistributionMap(lev), 1, 1);
+            phi->setVal(0.);
+        } else if (!self_fields_reuse_solver) {
+            // Start from a zero potential, as if the fields were allocated again
+            phi->setVal(0.);
+        }
+    }
+}
+
 /* Compute the potential `phi` by solving the Poisson equation with `rho` as
    a source, assuming that the source moves at a constant speed \f$\vec{\beta}\f$.
    This uses the amrex solver.
@@ -271,7 +303,7 @@ WarpX::computePhi (const amrex::Vector<std::unique_ptr<amrex::MultiFab> >& rho,
                    Real const required_precision,
                    Real absolute_tolerance,
                    int const max_iters,
-                   int const verbosity) const
+                   int const verbosity)
 {
 #ifdef WARPX_DIM_RZ
     // Create a new geometry with the z coordinate scaled by gamma
@@ -311,95 +343,125 @@ WarpX::computePhi (const amrex::Vector<std::unique_ptr<amrex::MultiFab> >& rho,
 
     LPInfo info;
 
+    if (static_cast<int>(m_poisson_solvers.size()) < finest_level+1) {
+        m_poisson_solvers.resize(finest_level+1);
+    }
+
     for (int lev=0; lev<=finest_level; lev++) {
 
+        // Reuse the linear operator and the MLMG solver of the last solve if the grids,
+        // the geometry and beta did not change; otherwise, (re)build them
+        auto& solver = m_poisson_solvers[lev];
+        const amrex::Real setup_start = amrex::second();
+        if (!self_fields_reuse_solver
+            || !solver.isValid(boxArray(lev), DistributionMap(lev), Geom(lev), beta))
+        {
+            solver.clear();
+
 #ifndef AMREX_USE_EB
 #ifdef WARPX_DIM_RZ
-        Real const dx = geom_scaled[lev].CellSize(0);
-        Real const dz_scaled = geom_scaled[lev].CellSize(1);
-        int max_semicoarsening_level = 0;
-        int semicoarsening_direction = -1;
-        if (dz_scaled > dx) {
-            semicoarsening_direction = 1;
-            max_semicoarsening_level = static_cast<int>(std::log2(dz_scaled/dx));
-        } else if (dz_scaled < dx) {
-            semicoarsening_direction = 0;
-            max_semicoarsening_level = static_cast<int>(std::log2(dx/dz_scaled));
-        }
-        if (max_semicoarsening_level > 0) {
-            info.setSemicoarsening(true);
-            info.setMaxSemicoarseningLevel(max_semicoarsening_level);
-            info.setSemicoarseningDirection(semicoarsening_direction);
-        }
-        // Define the linear operator (Poisson operator)
-        MLEBNodeFDLaplacian linop( {geom_scaled[lev]}, {boxArray(lev)}, {DistributionMap(lev)}, info );
+            Real const dx = geom_scaled[lev].CellSize(0);
+            Real const dz_scaled = geom_scaled[lev].CellSize(1);
+            int max_semicoarsening_level = 0;
+            int semicoarsening_direction = -1;
+            if (dz_scaled > dx) {
+                semicoarsening_direction = 1;
+                max_semicoarsening_level = static_cast<int>(std::log2(dz_scaled/dx));
+            } else if (dz_scaled < dx) {
+                semicoarsening_direction = 0;
+                max_semicoarsening_level = static_cast<int>(std::log2(dx/dz_scaled));
+            }
+            if (max_semicoarsening_level > 0) {
+                info.setSemicoarsening(true);
+                info.setMaxSemicoarseningLevel(max_semicoarsening_level);
+                info.setSemicoarseningDirection(semicoarsening_direction);
+            }
+            // Define the linear operator (Poisson operator)
+            solver.linop = std::make_unique<ElectrostaticSolver::PoissonLinOp>(
+                Vector<Geometry>{geom_scaled[lev]}, Vector<BoxArray>{boxArray(lev)},
+                Vector<DistributionMapping>{DistributionMap(lev)}, info );
 #else
-        // Set the value of beta
-        amrex::Array<amrex::Real,AMREX_SPACEDIM> beta_solver =
+            // Set the value of beta
+            amrex::Array<amrex::Real,AMREX_SPACEDIM> beta_solver =
 #if defined(WARPX_DIM_1D_Z)
-            {{ beta[2] }};  // beta_x and beta_z
+                {{ beta[2] }};  // beta_x and beta_z
 #elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-            {{ beta[0], beta[2] }};  // beta_x and beta_z
+                {{ beta[0], beta[2] }};  // beta_x and beta_z
 #else
-            {{ beta[0], beta[1], beta[2] }};
+                {{ beta[0], beta[1], beta[2] }};
 #endif
-        Array<Real,AMREX_SPACEDIM> dx_scaled
-            {AMREX_D_DECL(Geom(lev).CellSize(0)/std::sqrt(1._rt-beta_solver[0]*beta_solver[0]),
-                          Geom(lev).CellSize(1)/std::sqrt(1._rt-beta_solver[1]*beta_solver[1]),
-                          Geom(lev).CellSize(2)/std::sqrt(1._rt-beta_solver[2]*beta_solver[2]))};
-        int max_semicoarsening_level = 0;
-        int semicoarsening_direction = -1;
-        int min_dir = std::distance(dx_scaled.begin(),
-                                    std::min_element(dx_scaled.begin(),dx_scaled.end()));
-        int max_dir = std::distance(dx_scaled.begin(),
-                                    std::max_element(dx_scaled.begin(),dx_scaled.end()));
-        if (dx_scaled[max_dir] > dx_scaled[min_dir]) {
-            semicoarsening_direction = max_dir;
-            max_semicoarsening_level = static_cast<int>
-                (std::log2(dx_scaled[max_dir]/dx_scaled[min_dir]));
-        }
-        if (max_semicoarsening_level > 0) {
-            info.setSemicoarsening(true);
-            info.setMaxSemicoarseningLevel(max_semicoarsening_level);
-            info.setSemicoarseningDirection(semicoarsening_direction);
-        }
-        MLNodeTensorLaplacian linop( {Geom(lev)}, {boxArray(lev)}, {DistributionMap(lev)}, info );
-        linop.setBeta( beta_solver );
+            Array<Real,AMREX_SPACEDIM> dx_scaled
+                {AMREX_D_DECL(Geom(lev).CellSize(0)/std::sqrt(1._rt-beta_solver[0]*beta_solver[0]),
+                              Geom(lev).CellSize(1)/std::sqrt(1._rt-beta_solver[1]*beta_solver[1]),
+                              Geom(lev).CellSize(2)/std::sqrt(1._rt-beta_solver[2]*beta_solver[2]))};
+            int max_semicoarsening_level = 0;
+            int semicoarsening_direction = -1;
+            int min_dir = std::distance(dx_scaled.begin(),
+                                        std::min_element(dx_scaled.begin(),dx_scaled.end()));
+            int max_dir = std::distance(dx_scaled.begin(),
+                                        std::max_element(dx_scaled.begin(),dx_scaled.end()));
+            if (dx_scaled[max_dir] > dx_scaled[min_dir]) {
+                semicoarsening_direction = max_dir;
+                max_semicoarsening_level = static_cast<int>
+                    (std::log2(dx_scaled[max_dir]/dx_scaled[min_dir]));
+            }
+            if (max_semicoarsening_level > 0) {
+                info.setSemicoarsening(true);
+                info.setMaxSemicoarseningLevel(max_semicoarsening_level);
+                info.setSemicoarseningDirection(semicoarsening_direction);
+            }
+            solver.linop = std::make_unique<ElectrostaticSolver::PoissonLinOp>(
+                Vector<Geometry>{Geom(lev)}, Vector<BoxArray>{boxArray(lev)},
+                Vector<DistributionMapping>{DistributionMap(lev)}, info );
+            solver.linop->setBeta( beta_solver );
 #endif
 #else
-        // With embedded boundary: extract EB info
-        MLEBNodeFDLaplacian linop( {Geom(lev)}, {boxArray(lev)}, {DistributionMap(lev)}, info, {&WarpX::fieldEBFactory(lev)});
+            // With embedded boundary: extract EB info
+            solver.linop = std::make_unique<ElectrostaticSolver::PoissonLinOp>(
+                Vector<Geometry>{Geom(lev)}, Vector<BoxArray>{boxArray(lev)},
+                Vector<DistributionMapping>{DistributionMap(lev)}, info,
+                Vector<EBFArrayBoxFactory const*>{&WarpX::fieldEBFactory(lev)});
 
 #ifndef WARPX_DIM_RZ
-            // Note: this assumes that the beam is propagating along
-            // one of the axes of the grid, i.e. that only *one* of the Cartesian
-            // components of `beta` is non-negligible.
-            linop.setSigma({AMREX_D_DECL(
-                1._rt-beta[0]*beta[0], 1._rt-beta[1]*beta[1], 1._rt-beta[2]*beta[2])});
+                // Note: this assumes that the beam is propagating along
+                // one of the axes of the grid, i.e. that only *one* of the Cartesian
+                // components of `beta` is non-negligible.
+                solver.linop->setSigma({AMREX_D_DECL(
+                    1._rt-beta[0]*beta[0], 1._rt-beta[1]*beta[1], 1._rt-beta[2]*beta[2])});
+#endif
+#endif
+
+            solver.linop->setDomainBC( field_boundary_handler.lobc, field_boundary_handler.hibc );
+#ifdef WARPX_DIM_RZ
+            solver.linop->setRZ(true);
 #endif
+            solver.setSolver(boxArray(lev), DistributionMap(lev), Geom(lev), beta);
+            m_poisson_solver_stats.num_setups += 1;
+        }
+        auto& linop = *solver.linop;
+        auto& mlmg = *solver.mlmg;
 
+#ifdef AMREX_USE_EB
         // if the EB potential only depends on time, the potential can be passed
         // as a float instead of a callable
         if (field_boundary_handler.phi_EB_only_t) {
             linop.setEBDirichlet(field_boundary_handler.potential_eb_t(gett_new(0)));
         }
         else linop.setEBDirichlet(field_boundary_handler.getPhiEB(gett_new(0)));
-
 #endif
 
         // Solve the Poisson equation
-        linop.setDomainBC( field_boundary_handler.lobc, field_boundary_handler.hibc );
-#ifdef WARPX_DIM_RZ
-        linop.setRZ(true);
-#endif
-        MLMG mlmg(linop);
         mlmg.setVerbose(verbosity);
         mlmg.setMaxIter(max_iters);
         mlmg.setAlwaysUseBNorm(always_use_bnorm);
+        const amrex::Real solve_start = amrex::second();
+        m_poisson_solver_stats.setup_time += solve_start - setup_start;
 
-        // Solve Poisson equation at lev
+        // Solve Poisson equation at lev (phi[lev] is the initial guess)
         mlmg.solve( {phi[lev].get()}, {rho[lev].get()},
                     required_precision, absolute_tolerance );
+        m_poisson_solver_stats.solve_time += amrex::second() - solve_start;
+        m_poisson_solver_stats.num_iters += mlmg.getNumIters();
 
         // Interpolation from phi[lev] to phi[lev+1]
         // (This provides both the boundary conditions and initial guess for phi[lev+1])
@@ -471,6 +533,56 @@ WarpX::computePhi (const amrex::Vector<std::unique_ptr<amrex::MultiFab> >& rho,
 
 }
 
+void
+WarpX::computePhiIGF (const amrex::Vector<std::unique_ptr<amrex::MultiFab> >& rho,
+                      amrex::Vector<std::unique_ptr<amrex::MultiFab> >& phi,
+                      std::array<Real, 3> const beta) const
+{
+    WARPX_PROFILE("WarpX::computePhiIGF");
+
+#if defined(WARPX_DIM_3D) || defined(WARPX_DIM_XZ)
+#   ifdef WARPX_USE_PSATD
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(max_level == 0,
+        "The FFT integrated Green function solver (self_fields_solver = fft_igf) "
+        "does not support mesh refinement.");
+
+    // In the frame of the particles, the Poisson equation is solved with the cell
+    // size stretched by gamma along the direction of the mean particle velocity.
+    // Stretching the cell along one axis is only the Lorentz transform of the grid
+    // when the velocity is along this axis.
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        (beta[0] != 0._rt) + (beta[1] != 0._rt) + (beta[2] != 0._rt) <= 1,
+        "The FFT integrated Green function solver (self_fields_solver = fft_igf) "
+        "requires the mean velocity of the species to be along one axis.");
+    const Real* dx = Geom(0).CellSize();
+#       if defined(WARPX_DIM_3D)
+    const std::array<Real, AMREX_SPACEDIM> beta_dir = {beta[0], beta[1], beta[2]};
+#       else
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(beta[1] == 0._rt,
+        "The FFT integrated Green function solver (self_fields_solver = fft_igf) "
+        "requires the mean velocity of the species to be in the x-z plane in 2D.");
+    const std::array<Real, AMREX_SPACEDIM> beta_dir = {beta[0], beta[2]};
+#       endif
+    amrex::GpuArray<Real, AMREX_SPACEDIM> dx_stretched;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        dx_stretched[idim] = dx[idim]/std::sqrt(1._rt - beta_dir[idim]*beta_dir[idim]);
+    }
+
+    IntegratedGreenFunctionSolver::computePhiIGF(*rho[0], *phi[0], dx_stretched);
+#   else
+    amrex::ignore_unused(rho, phi, beta);
+    amrex::Abort(Utils::TextMsg::Err(
+        "The FFT integrated Green function solver (self_fields_solver = fft_igf) "
+        "requires WarpX to be compiled with FFT support (WarpX_PSATD=ON)."));
+#   endif
+#else
+    amrex::ignore_unused(rho, phi, beta);
+    amrex::Abort(Utils::TextMsg::Err(
+        "The FFT integrated Green function solver (self_fields_solver = fft_igf) "
+        "is only implemented in 3D and 2D Cartesian geometry."));
+#endif
+}
+
 
 /* \brief Set Dirichlet boundary conditions for the electrostatic solver.
 
@@ -55,7 +55,7 @@ void FiniteDifferenceSolver::EvolveB (
     std::array< std::unique_ptr<amrex::MultiFab>, 3 >& Venl,
     std::array< std::unique_ptr<amrex::iMultiFab>, 3 >& flag_info_cell,
     std::array< std::unique_ptr<amrex::LayoutData<FaceInfoBox> >, 3 >& borrowing,
-    int lev, amrex::Real const dt ) {
+    int lev, amrex::Real const dt, amrex::IntVect const& ng_update ) {
 
 #ifndef AMREX_USE_EB
     amrex::ignore_unused(area_mod, ECTRhofield, Venl, flag_info_cell, borrowing);
@@ -65,7 +65,7 @@ void FiniteDifferenceSolver::EvolveB (
    // but we compile code for each algorithm, using templates)
 #ifdef WARPX_DIM_RZ
     if (m_fdtd_algo == MaxwellSolverAlgo::Yee){
-        ignore_unused(Gfield, face_areas);
+        ignore_unused(Gfield, face_areas, ng_update);
         EvolveBCylindrical <CylindricalYeeAlgorithm> ( Bfield, Efield, lev, dt );
 #else
     if(m_do_nodal or m_fdtd_algo != MaxwellSolverAlgo::ECT){
@@ -74,18 +74,19 @@ void FiniteDifferenceSolver::EvolveB (
 
     if (m_do_nodal) {
 
-        EvolveBCartesian <CartesianNodalAlgorithm> ( Bfield, Efield, Gfield, lev, dt );
+        EvolveBCartesian <CartesianNodalAlgorithm> ( Bfield, Efield, Gfield, lev, dt, ng_update );
 
     } else if (m_fdtd_algo == MaxwellSolverAlgo::Yee) {
 
-        EvolveBCartesian <CartesianYeeAlgorithm> ( Bfield, Efield, Gfield, lev, dt );
+        EvolveBCartesian <CartesianYeeAlgorithm> ( Bfield, Efield, Gfield, lev, dt, ng_update );
 
     } else if (m_fdtd_algo == MaxwellSolverAlgo::CKC) {
 
-        EvolveBCartesian <CartesianCKCAlgorithm> ( Bfield, Efield, Gfield, lev, dt );
+        EvolveBCartesian <CartesianCKCAlgorithm> ( Bfield, Efield, Gfield, lev, dt, ng_update );
 #ifdef AMREX_USE_EB
     } else if (m_fdtd_algo == MaxwellSolverAlgo::ECT) {
 
+        amrex::ignore_unused(ng_update);
         EvolveBCartesianECT(Bfield, face_areas, area_mod, ECTRhofield, Venl, flag_info_cell,
                             borrowing, lev, dt);
 #endif
@@ -103,7 +104,7 @@ void FiniteDifferenceSolver::EvolveBCartesian (
     std::array< std::unique_ptr<amrex::MultiFab>, 3 >& Bfield,
     std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Efield,
     std::unique_ptr<amrex::MultiFab> const& Gfield,
-    int lev, amrex::Real const dt ) {
+    int lev, amrex::Real const dt, amrex::IntVect const& ng_update ) {
 
     amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
 
@@ -135,9 +136,10 @@ void FiniteDifferenceSolver::EvolveBCartesian (
         int const n_coefs_z = m_stencil_coefs_z.size();
 
         // Extract tileboxes for which to loop
-        Box const& tbx  = mfi.tilebox(Bfield[0]->ixType().toIntVect());
-        Box const& tby  = mfi.tilebox(Bfield[1]->ixType().toIntVect());
-        Box const& tbz  = mfi.tilebox(Bfield[2]->ixType().toIntVect());
+        // (grown by ng_update at the edges of the box)
+        Box const& tbx  = mfi.tilebox(Bfield[0]->ixType().toIntVect(), ng_update);
+        Box const& tby  = mfi.tilebox(Bfield[1]->ixType().toIntVect(), ng_update);
+        Box const& tbz  = mfi.tilebox(Bfield[2]->ixType().toIntVect(), ng_update);
 
         // Loop over the cells and update the fields
         amrex::ParallelFor(tbx, tby, tbz,
@@ -0,0 +1,351 @@
+/* Copyright 2022 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "FiniteDifferenceSolver.H"
+
+#include "BoundaryConditions/WarpX_PEC.H"
+#ifndef WARPX_DIM_RZ
+#   include "FiniteDifferenceAlgorithms/CartesianYeeAlgorithm.H"
+#   include "FiniteDifferenceAlgorithms/CartesianCKCAlgorithm.H"
+#endif
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXAlgorithmSelection.H"
+#include "Utils/WarpXConst.H"
+#include "WarpX.H"
+
+#include <AMReX.H>
+#include <AMReX_Array4.H>
+#include <AMReX_Box.H>
+#include <AMReX_Config.H>
+#include <AMReX_Extension.H>
+#include <AMReX_GpuAtomic.H>
+#include <AMReX_GpuControl.H>
+#include <AMReX_GpuDevice.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_IntVect.H>
+#include <AMReX_LayoutData.H>
+#include <AMReX_MFIter.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_OpenMP.H>
+#include <AMReX_REAL.H>
+#include <AMReX_Utility.H>
+#include <AMReX_Vector.H>
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <memory>
+
+using namespace amrex;
+
+/**
+ * \brief Update B over half a timestep, E over a timestep, and B over half
+ * a timestep again, in one sweep over the fields
+ */
+void FiniteDifferenceSolver::EvolveBEBFused (
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 >& Bfield,
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 >& Efield,
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Jfield,
+    int lev, amrex::Real const dt, amrex::IntVect const& ng_update ) {
+
+#ifdef WARPX_DIM_RZ
+    amrex::ignore_unused(Bfield, Efield, Jfield, lev, dt, ng_update);
+    amrex::Abort("EvolveBEBFused: not implemented in RZ geometry");
+#else
+    if (m_do_nodal) {
+        amrex::Abort("EvolveBEBFused: not implemented with the nodal solver");
+    } else if (m_fdtd_algo == MaxwellSolverAlgo::Yee) {
+        EvolveBEBFusedCartesian <CartesianYeeAlgorithm> ( Bfield, Efield, Jfield, lev, dt, ng_update );
+    } else if (m_fdtd_algo == MaxwellSolverAlgo::CKC) {
+        EvolveBEBFusedCartesian <CartesianCKCAlgorithm> ( Bfield, Efield, Jfield, lev, dt, ng_update );
+    } else {
+        amrex::Abort("EvolveBEBFused: Unknown algorithm");
+    }
+#endif
+}
+
+
+#ifndef WARPX_DIM_RZ
+
+template<typename T_Algo>
+void FiniteDifferenceSolver::EvolveBEBFusedCartesian (
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 >& Bfield,
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 >& Efield,
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Jfield,
+    int lev, amrex::Real const dt, amrex::IntVect const& ng_update ) {
+
+    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
+    Real constexpr c2 = PhysConst::c * PhysConst::c;
+    Real const half_dt = 0.5_rt * dt;
+
+    // The box is swept along its last (slowest) direction, by slabs of planes.
+    // For each slab, B is pushed over the first half step, E is pushed one plane
+    // behind, and B is pushed over the second half step one more plane behind.
+    // Since the stencils reach one plane in each direction, each stage then only
+    // reads values that are at the right time level, and the planes of the
+    // three stages stay in cache between the stages.
+    int constexpr dir = AMREX_SPACEDIM-1;
+    // Approximate size of the cache the planes of a slab should fit in
+    Long constexpr slab_bytes = 256*1024;
+
+    // PEC boundary conditions, applied to each slab after each stage
+    bool const has_pec = PEC::isAnyBoundaryPEC();
+    Box const& domain_box = WarpX::GetInstance().Geom(lev).Domain();
+    IntVect const domain_lo = domain_box.smallEnd();
+    IntVect const domain_hi = domain_box.bigEnd();
+    GpuArray<int, 3> fbndry_lo;
+    GpuArray<int, 3> fbndry_hi;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        fbndry_lo[idim] = WarpX::field_boundary_lo[idim];
+        fbndry_hi[idim] = WarpX::field_boundary_hi[idim];
+    }
+    IntVect const Ex_nodal = Efield[0]->ixType().toIntVect();
+    IntVect const Ey_nodal = Efield[1]->ixType().toIntVect();
+    IntVect const Ez_nodal = Efield[2]->ixType().toIntVect();
+    IntVect const Bx_nodal = Bfield[0]->ixType().toIntVect();
+    IntVect const By_nodal = Bfield[1]->ixType().toIntVect();
+    IntVect const Bz_nodal = Bfield[2]->ixType().toIntVect();
+
+    // The guard planes beyond a PEC boundary along the sweep direction are mirrored
+    // from planes up to ng_update planes inside the domain. No slab starts within
+    // this distance (plus the lag of the stages) of these boundaries, so that the
+    // mirrored planes are in the same slab, at the same time level.
+    int const pec_margin = ng_update[dir] + 3;
+    std::array<int, 2> pec_planes = {INT_MIN, INT_MIN};
+    if (fbndry_lo[dir] == FieldBoundaryType::PEC) pec_planes[0] = domain_lo[dir];
+    if (fbndry_hi[dir] == FieldBoundaryType::PEC) pec_planes[1] = domain_hi[dir] + 1;
+
+    // Loop through the grids. The slabs of each box are split into tiles along a
+    // transverse direction, which are updated by the OpenMP threads; the threads
+    // synchronize between the stages, since the stages of neighboring tiles read
+    // each other's values.
+    for ( MFIter mfi(*Bfield[0], false); mfi.isValid(); ++mfi ) {
+        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        {
+            amrex::Gpu::synchronize();
+        }
+        Real wt = amrex::second();
+
+        // Extract field data for this grid
+        Array4<Real> const& Bx = Bfield[0]->array(mfi);
+        Array4<Real> const& By = Bfield[1]->array(mfi);
+        Array4<Real> const& Bz = Bfield[2]->array(mfi);
+        Array4<Real> const& Ex = Efield[0]->array(mfi);
+        Array4<Real> const& Ey = Efield[1]->array(mfi);
+        Array4<Real> const& Ez = Efield[2]->array(mfi);
+        Array4<Real const> const& jx = Jfield[0]->const_array(mfi);
+        Array4<Real const> const& jy = Jfield[1]->const_array(mfi);
+        Array4<Real const> const& jz = Jfield[2]->const_array(mfi);
+
+        // Extract stencil coefficients
+        Real const * const AMREX_RESTRICT coefs_x = m_stencil_coefs_x.dataPtr();
+        int const n_coefs_x = m_stencil_coefs_x.size();
+        Real const * const AMREX_RESTRICT coefs_y = m_stencil_coefs_y.dataPtr();
+        int const n_coefs_y = m_stencil_coefs_y.size();
+        Real const * const AMREX_RESTRICT coefs_z = m_stencil_coefs_z.dataPtr();
+        int const n_coefs_z = m_stencil_coefs_z.size();
+
+        // Boxes updated by each stage: each stage needs the values of the previous
+        // stage one cell around, so it is updated in one guard cell less
+        IntVect const ng_B1 = ng_update;
+        IntVect const ng_E = ng_update - 1;
+        IntVect const ng_B2 = ng_update - 2;
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(ng_B2.allGE(IntVect::TheZeroVector()),
+            "EvolveBEBFused: not enough valid guard cells");
+        std::array<Box, 3> b1, be, b2;
+        for (int idim = 0; idim < 3; ++idim) {
+            b1[idim] = mfi.tilebox(Bfield[idim]->ixType().toIntVect(), ng_B1);
+            be[idim] = mfi.tilebox(Efield[idim]->ixType().toIntVect(), ng_E);
+            b2[idim] = mfi.tilebox(Bfield[idim]->ixType().toIntVect(), ng_B2);
+        }
+
+        // Number of planes per slab, such that the 9 components fit in the cache
+        Box const& fullbox = b1[0];
+        Long const plane_bytes = Long(9 * sizeof(Real)) * (fullbox.numPts() / fullbox.length(dir));
+        int const nplanes = static_cast<int>(std::max(Long(1), slab_bytes / plane_bytes));
+
+        // Planes swept by the first B stage (the largest boxes)
+        int plane_begin = b1[0].smallEnd(dir);
+        int plane_end = b1[0].bigEnd(dir);
+        for (int idim = 1; idim < 3; ++idim) {
+            plane_begin = std::min(plane_begin, b1[idim].smallEnd(dir));
+            plane_end = std::max(plane_end, b1[idim].bigEnd(dir));
+        }
+
+        // First plane of each slab of the first B stage. The E slabs lag by one
+        // plane, and the second B slabs by two planes, behind the first B slabs.
+        Vector<int> slab_begin;
+        for (int p = plane_begin; p <= plane_end + 2; p += nplanes) {
+            for (int const pec_plane : pec_planes) {
+                if (pec_plane != INT_MIN && p > plane_begin &&
+                    p > pec_plane - pec_margin && p <= pec_plane + pec_margin) {
+                    p = pec_plane + pec_margin + 1;
+                }
+            }
+            if (p > plane_end + 2) break;
+            slab_begin.push_back(p);
+        }
+        int const nslabs = static_cast<int>(slab_begin.size());
+
+        // Part of a box in the planes [plo, phi] along the sweep direction
+        auto slab = [=] (Box bx, int plo, int phi) {
+            bx.setSmall(dir, std::max(bx.smallEnd(dir), plo));
+            bx.setBig(dir, std::min(bx.bigEnd(dir), phi));
+            return bx;
+        };
+
+        // Number of transverse tiles (one per OpenMP thread), and part of a box in
+        // the tile it. The tiles are cut along the second slowest direction.
+        int ntiles = 1;
+#if (AMREX_SPACEDIM > 1)
+        int constexpr tdir = AMREX_SPACEDIM-2;
+        int const tile_lo = fullbox.smallEnd(tdir);
+        int const tile_len = fullbox.length(tdir);
+        if (amrex::Gpu::notInLaunchRegion()) {
+            ntiles = std::max(1, std::min(amrex::OpenMP::get_max_threads(), tile_len));
+        }
+#endif
+        auto tile = [=] (Box bx, int it) {
+#if (AMREX_SPACEDIM > 1)
+            if (it > 0) {
+                bx.setSmall(tdir, std::max(bx.smallEnd(tdir), tile_lo + (it*tile_len)/ntiles));
+            }
+            if (it < ntiles-1) {
+                bx.setBig(tdir, std::min(bx.bigEnd(tdir), tile_lo + ((it+1)*tile_len)/ntiles - 1));
+            }
+#else
+            amrex::ignore_unused(it);
+#endif
+            return bx;
+        };
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (ntiles > 1)
+#endif
+        for (int islab = 0; islab < nslabs; ++islab) {
+            int const slab_end = (islab+1 < nslabs) ? slab_begin[islab+1] - 1 : plane_end + 2;
+            for (int stage = 0; stage < 3; ++stage) {
+                int const plo = slab_begin[islab] - stage;
+                int const phi = slab_end - stage;
+                std::array<Box, 3> const& bb = (stage == 0) ? b1 : ((stage == 1) ? be : b2);
+
+#ifdef AMREX_USE_OMP
+#pragma omp for
+#endif
+                for (int it = 0; it < ntiles; ++it) {
+                    Box const t0 = tile(slab(bb[0], plo, phi), it);
+                    Box const t1 = tile(slab(bb[1], plo, phi), it);
+                    Box const t2 = tile(slab(bb[2], plo, phi), it);
+
+                    if (stage == 1) {
+                        amrex::ParallelFor(t0, t1, t2,
+
+                            [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                                Ex(i, j, k) += c2 * dt * (
+                                    - T_Algo::DownwardDz(By, coefs_z, n_coefs_z, i, j, k)
+                                    + T_Algo::DownwardDy(Bz, coefs_y, n_coefs_y, i, j, k)
+                                    - PhysConst::mu0 * jx(i, j, k) );
+                            },
+
+                            [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                                Ey(i, j, k) += c2 * dt * (
+                                    - T_Algo::DownwardDx(Bz, coefs_x, n_coefs_x, i, j, k)
+                                    + T_Algo::DownwardDz(Bx, coefs_z, n_coefs_z, i, j, k)
+                                    - PhysConst::mu0 * jy(i, j, k) );
+                            },
+
+                            [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                                Ez(i, j, k) += c2 * dt * (
+                                    - T_Algo::DownwardDy(Bx, coefs_y, n_coefs_y, i, j, k)
+                                    + T_Algo::DownwardDx(By, coefs_x, n_coefs_x, i, j, k)
+                                    - PhysConst::mu0 * jz(i, j, k) );
+                            }
+                        );
+                    } else {
+                        amrex::ParallelFor(t0, t1, t2,
+
+                            [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                                Bx(i, j, k) += half_dt * T_Algo::UpwardDz(Ey, coefs_z, n_coefs_z, i, j, k)
+                                             - half_dt * T_Algo::UpwardDy(Ez, coefs_y, n_coefs_y, i, j, k);
+                            },
+
+                            [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                                By(i, j, k) += half_dt * T_Algo::UpwardDx(Ez, coefs_x, n_coefs_x, i, j, k)
+                                             - half_dt * T_Algo::UpwardDz(Ex, coefs_z, n_coefs_z, i, j, k);
+                            },
+
+                            [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                                Bz(i, j, k) += half_dt * T_Algo::UpwardDy(Ex, coefs_y, n_coefs_y, i, j, k)
+                                             - half_dt * T_Algo::UpwardDx(Ey, coefs_x, n_coefs_x, i, j, k);
+                            }
+                        );
+                    }
+                }
+
+                if (!has_pec) continue;
+
+                // Boundary conditions on the slab, as in PEC::ApplyPECtoEfield and
+                // PEC::ApplyPECtoBfield, once all the tiles have been updated
+#ifdef AMREX_USE_OMP
+#pragma omp for
+#endif
+                for (int it = 0; it < ntiles; ++it) {
+                    Box const t0 = tile(slab(bb[0], plo, phi), it);
+                    Box const t1 = tile(slab(bb[1], plo, phi), it);
+                    Box const t2 = tile(slab(bb[2], plo, phi), it);
+
+                    if (stage == 1) {
+                        amrex::ParallelFor(t0, t1, t2,
+                            [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                                amrex::ignore_unused(j, k);
+                                PEC::SetEfieldOnPEC(0, domain_lo, domain_hi, IntVect(AMREX_D_DECL(i,j,k)), 0,
+                                                    Ex, Ex_nodal, fbndry_lo, fbndry_hi);
+                            },
+                            [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                                amrex::ignore_unused(j, k);
+                                PEC::SetEfieldOnPEC(1, domain_lo, domain_hi, IntVect(AMREX_D_DECL(i,j,k)), 0,
+                                                    Ey, Ey_nodal, fbndry_lo, fbndry_hi);
+                            },
+                            [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                                amrex::ignore_unused(j, k);
+                                PEC::SetEfieldOnPEC(2, domain_lo, domain_hi, IntVect(AMREX_D_DECL(i,j,k)), 0,
+                                                    Ez, Ez_nodal, fbndry_lo, fbndry_hi);
+                            }
+                        );
+                    } else {
+                        amrex::ParallelFor(t0, t1, t2,
+                            [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                                amrex::ignore_unused(j, k);
+                                PEC::SetBfieldOnPEC(0, domain_lo, domain_hi, IntVect(AMREX_D_DECL(i,j,k)), 0,
+                                                    Bx, Bx_nodal, fbndry_lo, fbndry_hi);
+                            },
+                            [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                                amrex::ignore_unused(j, k);
+                                PEC::SetBfieldOnPEC(1, domain_lo, domain_hi, IntVect(AMREX_D_DECL(i,j,k)), 0,
+                                                    By, By_nodal, fbndry_lo, fbndry_hi);
+                            },
+                            [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                                amrex::ignore_unused(j, k);
+                                PEC::SetBfieldOnPEC(2, domain_lo, domain_hi, IntVect(AMREX_D_DECL(i,j,k)), 0,
+                                                    Bz, Bz_nodal, fbndry_lo, fbndry_hi);
+                            }
+                        );
+                    }
+                }
+            }
+        }
+
+        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        {
+            amrex::Gpu::synchronize();
+            wt = amrex::second() - wt;
+            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+        }
+    }
+}
+
+#endif // ifndef WARPX_DIM_RZ
@@ -52,7 +52,7 @@ void FiniteDifferenceSolver::EvolveE (
     std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& face_areas,
     std::array< std::unique_ptr<amrex::MultiFab>, 3 >& ECTRhofield,
     std::unique_ptr<amrex::MultiFab> const& Ffield,
-    int lev, amrex::Real const dt ) {
+    int lev, amrex::Real const dt, amrex::IntVect const& ng_update ) {
 
 #ifdef AMREX_USE_EB
     if (m_fdtd_algo != MaxwellSolverAlgo::ECT) {
@@ -66,20 +66,20 @@ void FiniteDifferenceSolver::EvolveE (
     // but we compile code for each algorithm, using templates)
 #ifdef WARPX_DIM_RZ
     if (m_fdtd_algo == MaxwellSolverAlgo::Yee){
-        ignore_unused(edge_lengths);
+        ignore_unused(edge_lengths, ng_update);
         EvolveECylindrical <CylindricalYeeAlgorithm> ( Efield, Bfield, Jfield, Ffield, lev, dt );
 #else
     if (m_do_nodal) {
 
-        EvolveECartesian <CartesianNodalAlgorithm> ( Efield, Bfield, Jfield, edge_lengths, Ffield, lev, dt );
+        EvolveECartesian <CartesianNodalAlgorithm> ( Efield, Bfield, Jfield, edge_lengths, Ffield, lev, dt, ng_update );
 
     } else if (m_fdtd_algo == MaxwellSolverAlgo::Yee || m_fdtd_algo == MaxwellSolverAlgo::ECT) {
 
-        EvolveECartesian <CartesianYeeAlgorithm> ( Efield, Bfield, Jfield, edge_lengths, Ffield, lev, dt );
+        EvolveECartesian <CartesianYeeAlgorithm> ( Efield, Bfield, Jfield, edge_lengths, Ffield, lev, dt, ng_update );
 
     } else if (m_fdtd_algo == MaxwellSolverAlgo::CKC) {
 
-        EvolveECartesian <CartesianCKCAlgorithm> ( Efield, Bfield, Jfield, edge_lengths, Ffield, lev, dt );
+        EvolveECartesian <CartesianCKCAlgorithm> ( Efield, Bfield, Jfield, edge_lengths, Ffield, lev, dt, ng_update );
 
 #endif
     } else {
@@ -98,7 +98,7 @@ void FiniteDifferenceSolver::EvolveECartesian (
     std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Jfield,
     std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& edge_lengths,
     std::unique_ptr<amrex::MultiFab> const& Ffield,
-    int lev, amrex::Real const dt ) {
+    int lev, amrex::Real const dt, amrex::IntVect const& ng_update ) {
 
 #ifndef AMREX_USE_EB
     amrex::ignore_unused(edge_lengths);
@@ -144,9 +144,10 @@ void FiniteDifferenceSolver::EvolveECartesian (
         int const n_coefs_z = m_stencil_coefs_z.size();
 
         // Extract tileboxes for which to loop
-        Box const& tex  = mfi.tilebox(Efield[0]->ixType().toIntVect());
-        Box const& tey  = mfi.tilebox(Efield[1]->ixType().toIntVect());
-        Box const& tez  = mfi.tilebox(Efield[2]->ixType().toIntVect());
+        // (grown by ng_update at the edges of the box)
+        Box const& tex  = mfi.tilebox(Efield[0]->ixType().toIntVect(), ng_update);
+        Box const& tey  = mfi.tilebox(Efield[1]->ixType().toIntVect(), ng_update);
+        Box const& tez  = mfi.tilebox(Efield[2]->ixType().toIntVect(), ng_update);
 
         // Loop over the cells and update the fields
         amrex::ParallelFor(tex, tey, tez,
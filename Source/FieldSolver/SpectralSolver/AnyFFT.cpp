@@ -0,0 +1,52 @@
+/* Copyright 2022 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+#include "AnyFFT.H"
+
+#include <string>
+
+namespace AnyFFT
+{
+    namespace
+    {
+        // Options of the FFT planner
+        plan_effort s_plan_effort = plan_effort::estimate;
+        std::string s_wisdom_dir;
+
+        // Statistics of the FFT plans created by the local MPI rank
+        int s_num_plans = 0;
+        double s_planning_time = 0.;
+    }
+
+    void SetPlannerOptions (const plan_effort effort, const std::string& wisdom_dir)
+    {
+        s_plan_effort = effort;
+        s_wisdom_dir = wisdom_dir;
+    }
+
+    plan_effort GetPlanEffort ()
+    {
+        return s_plan_effort;
+    }
+
+    const std::string& GetWisdomDirectory ()
+    {
+        return s_wisdom_dir;
+    }
+
+    void RecordPlanning (const int num_plans, const double seconds)
+    {
+        s_num_plans += num_plans;
+        s_planning_time += seconds;
+    }
+
+    void GetPlanningStats (int& num_plans, double& seconds)
+    {
+        num_plans = s_num_plans;
+        seconds = s_planning_time;
+    }
+}
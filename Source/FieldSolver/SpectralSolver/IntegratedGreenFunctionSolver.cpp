@@ -0,0 +1,226 @@
+/* Copyright 2022 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "IntegratedGreenFunctionSolver.H"
+
+#include "AnyFFT.H"
+#include "Utils/WarpXConst.H"
+#include "Utils/WarpX_Complex.H"
+
+#include <AMReX_BaseFab.H>
+#include <AMReX_Box.H>
+#include <AMReX_BoxArray.H>
+#include <AMReX_BoxList.H>
+#include <AMReX_DistributionMapping.H>
+#include <AMReX_FabArray.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_IndexType.H>
+#include <AMReX_IntVect.H>
+#include <AMReX_MFIter.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Vector.H>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+using namespace amrex;
+
+namespace
+{
+    using SpectralSlabs = FabArray<BaseFab<Complex>>;
+
+    /* Chop `bx` along the dimension `dir` into (at most) `nboxes` boxes
+     * of nearly equal length, and assign the box number n to the MPI rank n */
+    void ChopIntoSlabs (const Box& bx, const int dir, const int nboxes,
+                        BoxArray& ba, DistributionMapping& dm)
+    {
+        const int nslabs = std::min(nboxes, bx.length(dir));
+        BoxList bl(bx.ixType());
+        Vector<int> pmap;
+        for (int n = 0; n < nslabs; ++n) {
+            Box slab = bx;
+            slab.setSmall(dir, bx.smallEnd(dir) + (n*bx.length(dir))/nslabs);
+            slab.setBig(dir, bx.smallEnd(dir) + ((n+1)*bx.length(dir))/nslabs - 1);
+            bl.push_back(slab);
+            pmap.push_back(n);
+        }
+        ba.define(bl);
+        dm.define(pmap);
+    }
+
+    /* Distributed FFT of the real array `real`, which is decomposed in slabs along
+     * the last dimension. The FFTs along all the dimensions but the last one are done
+     * on these slabs (into `spectral_slab`), and the FFTs along the last dimension
+     * after a global transpose to slabs along the second-to-last dimension (`spectral`).
+     * The plans are created before the arrays are filled, since the FFTW planner can
+     * overwrite them. */
+    struct DistributedFFT
+    {
+        DistributedFFT (MultiFab& real, SpectralSlabs& spectral_slab, SpectralSlabs& spectral)
+            : m_real(real), m_spectral_slab(spectral_slab), m_spectral(spectral),
+              m_slab_forward(real.boxArray(), real.DistributionMap()),
+              m_slab_backward(real.boxArray(), real.DistributionMap()),
+              m_last_dim_forward(spectral.boxArray(), spectral.DistributionMap()),
+              m_last_dim_backward(spectral.boxArray(), spectral.DistributionMap())
+        {
+            constexpr int last_dim = AMREX_SPACEDIM-1;
+            for (MFIter mfi(m_real); mfi.isValid(); ++mfi) {
+                const IntVect fft_size = m_real[mfi].box().length();
+                auto* const complex_array =
+                    reinterpret_cast<AnyFFT::Complex*>(m_spectral_slab[mfi].dataPtr());
+                m_slab_forward[mfi] = AnyFFT::CreatePlan(fft_size, m_real[mfi].dataPtr(),
+                    complex_array, AnyFFT::direction::R2C, AMREX_SPACEDIM-1, fft_size[last_dim]);
+                m_slab_backward[mfi] = AnyFFT::CreatePlan(fft_size, m_real[mfi].dataPtr(),
+                    complex_array, AnyFFT::direction::C2R, AMREX_SPACEDIM-1, fft_size[last_dim]);
+            }
+            for (MFIter mfi(m_spectral); mfi.isValid(); ++mfi) {
+                const Box& bx = m_spectral[mfi].box();
+                const int npts = bx.length(last_dim);
+                const int plane_npts = static_cast<int>(bx.numPts()/npts);
+                auto* const complex_array =
+                    reinterpret_cast<AnyFFT::Complex*>(m_spectral[mfi].dataPtr());
+                m_last_dim_forward[mfi] = AnyFFT::CreateC2CPlan(npts, plane_npts, plane_npts,
+                    complex_array, AnyFFT::direction::C2C_FORWARD);
+                m_last_dim_backward[mfi] = AnyFFT::CreateC2CPlan(npts, plane_npts, plane_npts,
+                    complex_array, AnyFFT::direction::C2C_BACKWARD);
+            }
+        }
+
+        ~DistributedFFT ()
+        {
+            for (MFIter mfi(m_real); mfi.isValid(); ++mfi) {
+                AnyFFT::DestroyPlan(m_slab_forward[mfi]);
+                AnyFFT::DestroyPlan(m_slab_backward[mfi]);
+            }
+            for (MFIter mfi(m_spectral); mfi.isValid(); ++mfi) {
+                AnyFFT::DestroyPlan(m_last_dim_forward[mfi]);
+                AnyFFT::DestroyPlan(m_last_dim_backward[mfi]);
+            }
+        }
+
+        DistributedFFT (DistributedFFT const&) = delete;
+        DistributedFFT& operator= (DistributedFFT const&) = delete;
+
+        void Forward ()
+        {
+            for (MFIter mfi(m_real); mfi.isValid(); ++mfi) AnyFFT::Execute(m_slab_forward[mfi]);
+            m_spectral.ParallelCopy(m_spectral_slab, 0, 0, 1);
+            for (MFIter mfi(m_spectral); mfi.isValid(); ++mfi) AnyFFT::Execute(m_last_dim_forward[mfi]);
+        }
+
+        void Backward ()
+        {
+            for (MFIter mfi(m_spectral); mfi.isValid(); ++mfi) AnyFFT::Execute(m_last_dim_backward[mfi]);
+            m_spectral_slab.ParallelCopy(m_spectral, 0, 0, 1);
+            for (MFIter mfi(m_real); mfi.isValid(); ++mfi) AnyFFT::Execute(m_slab_backward[mfi]);
+        }
+
+        MultiFab& m_real;
+        SpectralSlabs& m_spectral_slab;
+        SpectralSlabs& m_spectral;
+        AnyFFT::FFTplans m_slab_forward, m_slab_backward;
+        AnyFFT::FFTplans m_last_dim_forward, m_last_dim_backward;
+    };
+}
+
+void
+IntegratedGreenFunctionSolver::computePhiIGF (MultiFab const& rho, MultiFab& phi,
+                                              GpuArray<Real, AMREX_SPACEDIM> const& dx)
+{
+    using namespace amrex::literals;
+    constexpr int last_dim = AMREX_SPACEDIM-1;
+    const int nprocs = ParallelDescriptor::NProcs();
+
+    // Doubled grid, in the index space of rho: the charge density is padded with zeros,
+    // so that the periodic convolution computed with FFTs is the convolution with
+    // open boundaries
+    const Box domain = rho.boxArray().minimalBox();
+    const IntVect lo = domain.smallEnd();
+    const IntVect n = domain.length();
+    const IntVect n2 = 2*n;
+    const Box real_box(lo, lo + n2 - IntVect::TheUnitVector(), domain.ixType());
+    IntVect complex_hi = n2 - IntVect::TheUnitVector();
+    complex_hi[0] = n2[0]/2; // only the non-redundant half of the real-to-complex FFT
+    const Box complex_box(IntVect::TheZeroVector(), complex_hi);
+    const Real inv_ntot = 1._rt/real_box.d_numPts();
+
+#if defined(WARPX_DIM_3D)
+    const Real green_norm = 1._rt/(4._rt*MathConst::pi*PhysConst::ep0);
+#else
+    const Real green_norm = -1._rt/(2._rt*MathConst::pi*PhysConst::ep0);
+#endif
+
+    // The FFTs are distributed over all the MPI ranks, as in the PSATD solver with
+    // psatd.distributed_fft (see SpectralKSpace): the doubled grid is decomposed in
+    // slabs along the last dimension, and the spectral space in slabs along the
+    // second-to-last dimension. Boxes in spectral space start at 0.
+    BoxArray slab_ba, spectral_ba;
+    DistributionMapping slab_dm, spectral_dm;
+    ChopIntoSlabs(real_box, last_dim, nprocs, slab_ba, slab_dm);
+    ChopIntoSlabs(complex_box, last_dim-1, nprocs, spectral_ba, spectral_dm);
+    BoxList slab_spectral_bl;
+    for (int i = 0; i < slab_ba.size(); ++i) {
+        Box slab = complex_box;
+        slab.setSmall(last_dim, slab_ba[i].smallEnd(last_dim) - lo[last_dim]);
+        slab.setBig(last_dim, slab_ba[i].bigEnd(last_dim) - lo[last_dim]);
+        slab_spectral_bl.push_back(slab);
+    }
+    const BoxArray slab_spectral_ba(std::move(slab_spectral_bl));
+
+    MultiFab rho_slab(slab_ba, slab_dm, 1, 0);
+    MultiFab green_slab(slab_ba, slab_dm, 1, 0);
+    SpectralSlabs rho_hat_slab(slab_spectral_ba, slab_dm, 1, 0);
+    SpectralSlabs green_hat_slab(slab_spectral_ba, slab_dm, 1, 0);
+    SpectralSlabs rho_hat(spectral_ba, spectral_dm, 1, 0);
+    SpectralSlabs green_hat(spectral_ba, spectral_dm, 1, 0);
+    DistributedFFT rho_fft(rho_slab, rho_hat_slab, rho_hat);
+    DistributedFFT green_fft(green_slab, green_hat_slab, green_hat);
+
+    // Zero-padded charge density
+    rho_slab.setVal(0._rt);
+    rho_slab.ParallelCopy(rho, 0, 0, 1);
+
+    // Green's function for the offsets between -n and n-1 (periodic images);
+    // it is even along each dimension
+    for (MFIter mfi(green_slab); mfi.isValid(); ++mfi)
+    {
+        Array4<Real> const green_arr = green_slab.array(mfi);
+        ParallelFor(mfi.validbox(), [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            const IntVect iv = IntVect(AMREX_D_DECL(i,j,k)) - lo;
+            Real d[AMREX_SPACEDIM];
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                const int offset = (iv[idim] < n[idim]) ? iv[idim] : iv[idim] - n2[idim];
+                d[idim] = std::abs(offset*dx[idim]);
+            }
+#if defined(WARPX_DIM_3D)
+            green_arr(i,j,k) = IntegratedGreenFunction(d[0], d[1], d[2], dx);
+#else
+            green_arr(i,j,k) = IntegratedGreenFunction(d[0], 0._rt, d[1], dx);
+#endif
+        });
+    }
+
+    // Convolution: product of the Fourier transforms
+    rho_fft.Forward();
+    green_fft.Forward();
+    for (MFIter mfi(rho_hat); mfi.isValid(); ++mfi)
+    {
+        Array4<Complex> const rho_hat_arr = rho_hat.array(mfi);
+        Array4<Complex const> const green_hat_arr = green_hat.const_array(mfi);
+        ParallelFor(mfi.validbox(), [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            rho_hat_arr(i,j,k) = rho_hat_arr(i,j,k)*green_hat_arr(i,j,k)*(green_norm*inv_ntot);
+        });
+    }
+    rho_fft.Backward();
+
+    // Scatter the potential to the grids of phi (this only copies the part
+    // of the doubled grid that covers the domain)
+    phi.setVal(0._rt);
+    phi.ParallelCopy(rho_slab, 0, 0, 1);
+}
@@ -26,13 +26,40 @@
 #include <AMReX_LayoutData.H>
 #include <AMReX_MFIter.H>
 #include <AMReX_PODVector.H>
+#include <AMReX_Periodicity.H>
 #include <AMReX_REAL.H>
 #include <AMReX_Utility.H>
 
+#include <algorithm>
+
 #if WARPX_USE_PSATD
 
 using namespace amrex;
 
+namespace
+{
+    /** Source of the copy to the temporary real-space array, for one component of a batch */
+    struct ForwardCopyComp
+    {
+        Array4<const Real> arr; // real-space field
+        int i_comp; // component of the real-space field
+        int field_index; // index of the spectral field
+        IntVect is_nodal; // index type of the real-space field
+    };
+
+    /** Destination of the copy from the temporary real-space array, for one component of a batch */
+    struct BackwardCopyComp
+    {
+        Array4<Real> arr; // real-space field
+        int i_comp; // component of the real-space field
+        int field_index; // index of the spectral field
+        IntVect is_nodal; // index type of the real-space field
+        Box box; // cells that are filled
+        IntVect lo; // lower bound of the full box
+        IntVect wrap; // last point along a nodal direction, which is set equal to the first one
+    };
+}
+
 SpectralFieldIndex::SpectralFieldIndex (const bool update_with_rho,
                                         const bool time_averaging,
                                         const bool do_multi_J,
@@ -110,92 +137,269 @@ SpectralFieldData::SpectralFieldData( const int lev,
                                       const SpectralKSpace& k_space,
                                       const amrex::DistributionMapping& dm,
                                       const int n_field_required,
-                                      const bool periodic_single_box)
+                                      const bool periodic_single_box,
+                                      const bool distributed_fft)
 {
-    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
-    bool do_costs = WarpXUtilLoadBalance::doCosts(cost, realspace_ba, dm);
-
     m_periodic_single_box = periodic_single_box;
+    m_distributed_fft = distributed_fft;
+
+    // Transform up to psatd.fft_batch_size fields at once,
+    // but not more than the number of fields in spectral space
+    m_fft_batch_size = std::max(1, std::min({WarpX::fft_batch_size, n_field_required,
+                                             max_fft_batch_size}));
 
     const BoxArray& spectralspace_ba = k_space.spectralspace_ba;
+    // Same as dm, unless the FFTs are distributed over the whole domain
+    const DistributionMapping& spectralspace_dm = k_space.spectralspace_dm;
 
     // Allocate the arrays that contain the fields in spectral space
     // (one component per field)
-    fields = SpectralField(spectralspace_ba, dm, n_field_required, 0);
+    fields = SpectralField(spectralspace_ba, spectralspace_dm, n_field_required, 0);
 
     // Allocate temporary arrays - in real space and spectral space
     // These arrays will store the data just before/after the FFT
-    tmpRealField = MultiFab(realspace_ba, dm, 1, 0);
-    tmpSpectralField = SpectralField(spectralspace_ba, dm, 1, 0);
+    // (one component per field transformed in the same batch)
+    if (m_distributed_fft) {
+        // With distributed FFTs, the guard cell of the real-space array receives
+        // the periodic image of the first cell, which gives the last point along
+        // nodal directions
+        tmpRealField = MultiFab(realspace_ba, dm, m_fft_batch_size, 1);
+        tmpSpectralField = SpectralField(spectralspace_ba, spectralspace_dm, m_fft_batch_size, 0);
+    } else {
+        tmpRealField = MultiFab(realspace_ba, dm, m_fft_batch_size, 0);
+        tmpSpectralField = SpectralField(spectralspace_ba, spectralspace_dm, m_fft_batch_size, 0);
+    }
 
     // By default, we assume the FFT is done from/to a nodal grid in real space
     // It the FFT is performed from/to a cell-centered grid in real space,
     // a correcting "shift" factor must be applied in spectral space.
-    xshift_FFTfromCell = k_space.getSpectralShiftFactor(dm, 0,
+    xshift_FFTfromCell = k_space.getSpectralShiftFactor(spectralspace_dm, 0,
                                     ShiftType::TransformFromCellCentered);
-    xshift_FFTtoCell = k_space.getSpectralShiftFactor(dm, 0,
+    xshift_FFTtoCell = k_space.getSpectralShiftFactor(spectralspace_dm, 0,
                                     ShiftType::TransformToCellCentered);
 #if defined(WARPX_DIM_3D)
-    yshift_FFTfromCell = k_space.getSpectralShiftFactor(dm, 1,
+    yshift_FFTfromCell = k_space.getSpectralShiftFactor(spectralspace_dm, 1,
                                     ShiftType::TransformFromCellCentered);
-    yshift_FFTtoCell = k_space.getSpectralShiftFactor(dm, 1,
+    yshift_FFTtoCell = k_space.getSpectralShiftFactor(spectralspace_dm, 1,
                                     ShiftType::TransformToCellCentered);
-    zshift_FFTfromCell = k_space.getSpectralShiftFactor(dm, 2,
+    zshift_FFTfromCell = k_space.getSpectralShiftFactor(spectralspace_dm, 2,
                                     ShiftType::TransformFromCellCentered);
-    zshift_FFTtoCell = k_space.getSpectralShiftFactor(dm, 2,
+    zshift_FFTtoCell = k_space.getSpectralShiftFactor(spectralspace_dm, 2,
                                     ShiftType::TransformToCellCentered);
 #else
-    zshift_FFTfromCell = k_space.getSpectralShiftFactor(dm, 1,
+    zshift_FFTfromCell = k_space.getSpectralShiftFactor(spectralspace_dm, 1,
                                     ShiftType::TransformFromCellCentered);
-    zshift_FFTtoCell = k_space.getSpectralShiftFactor(dm, 1,
+    zshift_FFTtoCell = k_space.getSpectralShiftFactor(spectralspace_dm, 1,
                                     ShiftType::TransformToCellCentered);
 #endif
 
-    // Allocate and initialize the FFT plans
-    forward_plan = AnyFFT::FFTplans(spectralspace_ba, dm);
-    backward_plan = AnyFFT::FFTplans(spectralspace_ba, dm);
-    // Loop over boxes and allocate the corresponding plan
-    // for each box owned by the local MPI proc
-    for ( MFIter mfi(spectralspace_ba, dm); mfi.isValid(); ++mfi ){
-        if (do_costs)
-        {
-            amrex::Gpu::synchronize();
-        }
-        Real wt = amrex::second();
+    if (m_distributed_fft) {
+        InitDistributedFFT(k_space);
+        return;
+    }
 
-        // Note: the size of the real-space box and spectral-space box
-        // differ when using real-to-complex FFT. When initializing
-        // the FFT plan, the valid dimensions are those of the real-space box.
-        IntVect fft_size = realspace_ba[mfi].length();
+    // Allocate and initialize the FFT plans for single fields and for full batches
+    // (the plans for the remainder of a list of fields are created on first use)
+    GetFFTPlans(lev, 1, AnyFFT::direction::R2C);
+    GetFFTPlans(lev, 1, AnyFFT::direction::C2R);
+    GetFFTPlans(lev, m_fft_batch_size, AnyFFT::direction::R2C);
+    GetFFTPlans(lev, m_fft_batch_size, AnyFFT::direction::C2R);
+}
 
-        forward_plan[mfi] = AnyFFT::CreatePlan(
-            fft_size, tmpRealField[mfi].dataPtr(),
-            reinterpret_cast<AnyFFT::Complex*>( tmpSpectralField[mfi].dataPtr()),
-            AnyFFT::direction::R2C, AMREX_SPACEDIM);
 
-        backward_plan[mfi] = AnyFFT::CreatePlan(
-            fft_size, tmpRealField[mfi].dataPtr(),
-            reinterpret_cast<AnyFFT::Complex*>( tmpSpectralField[mfi].dataPtr()),
-            AnyFFT::direction::C2R, AMREX_SPACEDIM);
+SpectralFieldData::~SpectralFieldData()
+{
+    if (!tmpRealField.empty()){
+        for (auto& plans : {&forward_plan, &backward_plan}) {
+            for (auto& batch_plans : *plans) {
+                for ( MFIter mfi(tmpRealField); mfi.isValid(); ++mfi ){
+                    AnyFFT::DestroyPlan(batch_plans.second[mfi]);
+                }
+            }
+        }
+    }
+    if (m_distributed_fft && !m_slab_real.empty()){
+        for (auto& plans : {&m_slab_forward_plans, &m_slab_backward_plans}) {
+            for (auto& batch_plans : *plans) {
+                for ( MFIter mfi(m_slab_real); mfi.isValid(); ++mfi ){
+                    AnyFFT::DestroyPlan(batch_plans.second[mfi]);
+                }
+            }
+        }
+        for (auto& plans : {&m_last_dim_forward_plan, &m_last_dim_backward_plan}) {
+            for (auto& comp_plans : *plans) {
+                for ( MFIter mfi(tmpSpectralField); mfi.isValid(); ++mfi ){
+                    AnyFFT::DestroyPlan(comp_plans[mfi]);
+                }
+            }
+        }
+    }
+}
 
-        if (do_costs)
-        {
-            amrex::Gpu::synchronize();
-            wt = amrex::second() - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+void
+SpectralFieldData::InitDistributedFFT (const SpectralKSpace& k_space)
+{
+    constexpr int last_dim = AMREX_SPACEDIM-1;
+    const BoxArray& slab_ba = k_space.realspace_slab_ba;
+    const Box domain = slab_ba.minimalBox();
+    m_domain_periodicity = Periodicity(domain.length());
+    m_domain_npts = domain.numPts();
+
+    // Real-space slabs along the last dimension
+    // (one component per field transformed in the same batch)
+    m_slab_real = MultiFab(slab_ba, k_space.realspace_slab_dm, m_fft_batch_size, 0);
+
+    // Same slabs after the real-to-complex FFTs along all the dimensions but the last
+    // one: only the positive k are kept along the first axis, and the indices start
+    // at 0, as the global indices of the spectral domain (see SpectralKSpace)
+    BoxList slab_spectral_bl;
+    for (int i = 0; i < slab_ba.size(); ++i) {
+        IntVect lo = IntVect::TheZeroVector();
+        IntVect hi = domain.length() - IntVect::TheUnitVector();
+        hi[0] = domain.length(0)/2;
+        lo[last_dim] = slab_ba[i].smallEnd(last_dim) - domain.smallEnd(last_dim);
+        hi[last_dim] = slab_ba[i].bigEnd(last_dim) - domain.smallEnd(last_dim);
+        slab_spectral_bl.push_back(Box(lo, hi));
+    }
+    m_slab_spectral = SpectralField(BoxArray(slab_spectral_bl), k_space.realspace_slab_dm,
+                                    m_fft_batch_size, 0);
+
+    int num_plans = 0;
+    const Real planning_start = amrex::second();
+    AnyFFT::ImportWisdom(domain.length(), AMREX_SPACEDIM);
+
+    // FFTs along the last dimension, which is the slowest dimension of the
+    // spectral-space slabs: one FFT for each point of a plane. The components
+    // of a batch are not evenly strided along the last dimension, so there is
+    // one plan per component of the batch.
+    m_last_dim_forward_plan.resize(m_fft_batch_size);
+    m_last_dim_backward_plan.resize(m_fft_batch_size);
+    for (int n = 0; n < m_fft_batch_size; ++n) {
+        m_last_dim_forward_plan[n] = AnyFFT::FFTplans(tmpSpectralField.boxArray(),
+                                                      tmpSpectralField.DistributionMap());
+        m_last_dim_backward_plan[n] = AnyFFT::FFTplans(tmpSpectralField.boxArray(),
+                                                       tmpSpectralField.DistributionMap());
+        for ( MFIter mfi(tmpSpectralField); mfi.isValid(); ++mfi ){
+            const Box& bx = tmpSpectralField[mfi].box();
+            const int npts = bx.length(last_dim);
+            const int plane_npts = static_cast<int>(bx.numPts()/npts);
+            auto* const complex_array =
+                reinterpret_cast<AnyFFT::Complex*>( tmpSpectralField[mfi].dataPtr(n));
+            m_last_dim_forward_plan[n][mfi] = AnyFFT::CreateC2CPlan(
+                npts, plane_npts, plane_npts, complex_array, AnyFFT::direction::C2C_FORWARD);
+            m_last_dim_backward_plan[n][mfi] = AnyFFT::CreateC2CPlan(
+                npts, plane_npts, plane_npts, complex_array, AnyFFT::direction::C2C_BACKWARD);
+            num_plans += 2;
         }
     }
+
+    AnyFFT::ExportWisdom(domain.length(), AMREX_SPACEDIM);
+    AnyFFT::RecordPlanning(num_plans, amrex::second() - planning_start);
+
+    // FFTs on the slabs, for single fields and for full batches
+    // (the plans for the remainder of a list of fields are created on first use)
+    GetSlabFFTPlans(1, AnyFFT::direction::R2C);
+    GetSlabFFTPlans(1, AnyFFT::direction::C2R);
+    GetSlabFFTPlans(m_fft_batch_size, AnyFFT::direction::R2C);
+    GetSlabFFTPlans(m_fft_batch_size, AnyFFT::direction::C2R);
 }
 
+AnyFFT::FFTplans&
+SpectralFieldData::GetSlabFFTPlans (const int batch, const AnyFFT::direction dir)
+{
+    auto& plans = (dir == AnyFFT::direction::R2C) ? m_slab_forward_plans : m_slab_backward_plans;
+    auto it = plans.find(batch);
+    if (it != plans.end()) return it->second;
+
+    constexpr int last_dim = AMREX_SPACEDIM-1;
+    const IntVect domain_size = m_slab_real.boxArray().minimalBox().length();
+
+    int num_plans = 0;
+    const Real planning_start = amrex::second();
+    AnyFFT::ImportWisdom(domain_size, AMREX_SPACEDIM);
+
+    // FFTs along all the dimensions but the last one, batched over the planes of each
+    // slab and over the components: the planes of successive components are contiguous
+    AnyFFT::FFTplans& batch_plans = plans[batch];
+    batch_plans = AnyFFT::FFTplans(m_slab_real.boxArray(), m_slab_real.DistributionMap());
+    for ( MFIter mfi(m_slab_real); mfi.isValid(); ++mfi ){
+        const IntVect fft_size = m_slab_real[mfi].box().length();
+        batch_plans[mfi] = AnyFFT::CreatePlan(
+            fft_size, m_slab_real[mfi].dataPtr(),
+            reinterpret_cast<AnyFFT::Complex*>( m_slab_spectral[mfi].dataPtr()),
+            dir, AMREX_SPACEDIM-1, fft_size[last_dim]*batch);
+        ++num_plans;
+    }
 
-SpectralFieldData::~SpectralFieldData()
+    AnyFFT::ExportWisdom(domain_size, AMREX_SPACEDIM);
+    AnyFFT::RecordPlanning(num_plans, amrex::second() - planning_start);
+
+    return batch_plans;
+}
+
+AnyFFT::FFTplans&
+SpectralFieldData::GetFFTPlans (const int lev, const int batch, const AnyFFT::direction dir)
 {
-    if (!tmpRealField.empty()){
-        for ( MFIter mfi(tmpRealField); mfi.isValid(); ++mfi ){
-            AnyFFT::DestroyPlan(forward_plan[mfi]);
-            AnyFFT::DestroyPlan(backward_plan[mfi]);
+    auto& plans = (dir == AnyFFT::direction::R2C) ? forward_plan : backward_plan;
+    auto it = plans.find(batch);
+    if (it != plans.end()) return it->second;
+
+    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
+    bool do_costs = WarpXUtilLoadBalance::doCosts(cost, tmpRealField.boxArray(),
+                                                  tmpRealField.DistributionMap());
+
+    AnyFFT::FFTplans& batch_plans = plans[batch];
+    batch_plans = AnyFFT::FFTplans(tmpSpectralField.boxArray(), tmpSpectralField.DistributionMap());
+
+    // Sizes of the FFTs on the local MPI rank: the FFTW wisdom is loaded and saved
+    // for each size, so that plans that were already tuned are not planned again
+    amrex::Vector<IntVect> fft_sizes;
+    for ( MFIter mfi(tmpSpectralField); mfi.isValid(); ++mfi ){
+        // Note: the size of the real-space box and spectral-space box
+        // differ when using real-to-complex FFT. When initializing
+        // the FFT plan, the valid dimensions are those of the real-space box.
+        const IntVect fft_size = tmpRealField[mfi].box().length();
+        if (std::find(fft_sizes.begin(), fft_sizes.end(), fft_size) == fft_sizes.end()) {
+            fft_sizes.push_back(fft_size);
+        }
+    }
+
+    int num_plans = 0;
+    const Real planning_start = amrex::second();
+    for (const IntVect& fft_size : fft_sizes)
+    {
+        AnyFFT::ImportWisdom(fft_size, AMREX_SPACEDIM);
+
+        // Loop over boxes and allocate the corresponding plan
+        // for each box owned by the local MPI proc
+        for ( MFIter mfi(tmpSpectralField); mfi.isValid(); ++mfi ){
+            if (tmpRealField[mfi].box().length() != fft_size) continue;
+
+            if (do_costs)
+            {
+                amrex::Gpu::synchronize();
+            }
+            Real wt = amrex::second();
+
+            batch_plans[mfi] = AnyFFT::CreatePlan(
+                fft_size, tmpRealField[mfi].dataPtr(),
+                reinterpret_cast<AnyFFT::Complex*>( tmpSpectralField[mfi].dataPtr()),
+                dir, AMREX_SPACEDIM, batch);
+            ++num_plans;
+
+            if (do_costs)
+            {
+                amrex::Gpu::synchronize();
+                wt = amrex::second() - wt;
+                amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+            }
         }
+
+        AnyFFT::ExportWisdom(fft_size, AMREX_SPACEDIM);
     }
+    AnyFFT::RecordPlanning(num_plans, amrex::second() - planning_start);
+
+    return batch_plans;
 }
 
 /* \brief Transform the component `i_comp` of MultiFab `mf`
@@ -206,92 +410,120 @@ SpectralFieldData::ForwardTransform (const int lev,
                                      const MultiFab& mf, const int field_index,
                                      const int i_comp)
 {
-    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
-    bool do_costs = WarpXUtilLoadBalance::doCosts(cost, mf.boxArray(), mf.DistributionMap());
+    ForwardTransform(lev, ForwardTransformComps{{&mf, field_index, i_comp}});
+}
 
-    // Check field index type, in order to apply proper shift in spectral space
-#if (AMREX_SPACEDIM >= 2)
-    const bool is_nodal_x = mf.is_nodal(0);
-#endif
-#if defined(WARPX_DIM_3D)
-    const bool is_nodal_y = mf.is_nodal(1);
-    const bool is_nodal_z = mf.is_nodal(2);
-#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-    const bool is_nodal_z = mf.is_nodal(1);
-#elif defined(WARPX_DIM_1D_Z)
-    const bool is_nodal_z = mf.is_nodal(0);
-#endif
+/* \brief Transform the components `comps` of the real-space MultiFabs to spectral
+ *  space, by batches of m_fft_batch_size components, and store the corresponding
+ *  results internally (in the spectral fields specified by `field_index`) */
+void
+SpectralFieldData::ForwardTransform (const int lev, const ForwardTransformComps& comps)
+{
+    if (comps.empty()) return;
+
+    if (m_distributed_fft) {
+        ForwardTransformDistributed(comps);
+        return;
+    }
+
+    const MultiFab& mf0 = *comps[0].mf;
+    for (const auto& comp : comps) {
+        AMREX_ALWAYS_ASSERT(comp.mf->DistributionMap() == mf0.DistributionMap());
+    }
+
+    const int ncomps = static_cast<int>(comps.size());
+    const int batch_size = m_fft_batch_size;
+
+    // Make sure that the plans exist for all batch sizes used below
+    AnyFFT::FFTplans& full_plans = GetFFTPlans(lev, std::min(batch_size, ncomps),
+                                               AnyFFT::direction::R2C);
+    AnyFFT::FFTplans& last_plans = GetFFTPlans(lev, (ncomps-1) % batch_size + 1,
+                                               AnyFFT::direction::R2C);
+
+    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
+    bool do_costs = WarpXUtilLoadBalance::doCosts(cost, mf0.boxArray(), mf0.DistributionMap());
 
     // Loop over boxes
     // Note: we do NOT OpenMP parallelize here, since we use OpenMP threads for
     //       the FFTs on each box!
-    for ( MFIter mfi(mf); mfi.isValid(); ++mfi ){
+    for ( MFIter mfi(mf0); mfi.isValid(); ++mfi ){
         if (do_costs)
         {
             amrex::Gpu::synchronize();
         }
         Real wt = amrex::second();
 
-        // Copy the real-space field `mf` to the temporary field `tmpRealField`
-        // This ensures that all fields have the same number of points
-        // before the Fourier transform.
-        // As a consequence, the copy discards the *last* point of `mf`
-        // in any direction that has *nodal* index type.
+        // Correcting shift factors along each dimension
+        GpuArray<const Complex*, AMREX_SPACEDIM> shift_arr = {
+#if defined(WARPX_DIM_3D)
+            xshift_FFTfromCell[mfi].dataPtr(), yshift_FFTfromCell[mfi].dataPtr(),
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+            xshift_FFTfromCell[mfi].dataPtr(),
+#endif
+            zshift_FFTfromCell[mfi].dataPtr()};
+
+        // Loop over batches of components
+        for (int first = 0; first < ncomps; first += batch_size)
         {
-            Box realspace_bx;
-            if (m_periodic_single_box) {
-                realspace_bx = mfi.validbox(); // Discard guard cells
-            } else {
-                realspace_bx = mf[mfi].box(); // Keep guard cells
+            const int batch = std::min(batch_size, ncomps - first);
+
+            GpuArray<ForwardCopyComp, max_fft_batch_size> copy_comps;
+            for (int n = 0; n < batch; ++n) {
+                const auto& comp = comps[first+n];
+                const MultiFab& mf = *comp.mf;
+                // The copy to `tmpRealField` discards the *last* point of `mf`
+                // in any direction that has *nodal* index type.
+                Box realspace_bx;
+                if (m_periodic_single_box) {
+                    realspace_bx = mf.boxArray()[mfi.index()]; // Discard guard cells
+                } else {
+                    realspace_bx = mf[mfi].box(); // Keep guard cells
+                }
+                realspace_bx.enclosedCells(); // Discard last point in nodal direction
+                AMREX_ALWAYS_ASSERT( realspace_bx.contains(tmpRealField[mfi].box()) );
+                copy_comps[n] = ForwardCopyComp{mf[mfi].const_array(), comp.i_comp,
+                                                comp.field_index, mf.ixType().toIntVect()};
             }
-            realspace_bx.enclosedCells(); // Discard last point in nodal direction
-            AMREX_ALWAYS_ASSERT( realspace_bx.contains(tmpRealField[mfi].box()) );
-            Array4<const Real> mf_arr = mf[mfi].array();
-            Array4<Real> tmp_arr = tmpRealField[mfi].array();
-            ParallelFor( tmpRealField[mfi].box(),
-            [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-                tmp_arr(i,j,k) = mf_arr(i,j,k,i_comp);
-            });
-        }
 
-        // Perform Fourier transform from `tmpRealField` to `tmpSpectralField`
-        AnyFFT::Execute(forward_plan[mfi]);
+            // Copy the real-space fields to the temporary field `tmpRealField`
+            // (one component per field of the batch)
+            // This ensures that all fields have the same number of points
+            // before the Fourier transform.
+            {
+                Array4<Real> tmp_arr = tmpRealField[mfi].array();
+                ParallelFor( tmpRealField[mfi].box(), batch,
+                [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept {
+                    tmp_arr(i,j,k,n) = copy_comps[n].arr(i,j,k,copy_comps[n].i_comp);
+                });
+            }
 
-        // Copy the spectral-space field `tmpSpectralField` to the appropriate
-        // index of the FabArray `fields` (specified by `field_index`)
-        // and apply correcting shift factor if the real space data comes
-        // from a cell-centered grid in real space instead of a nodal grid.
-        {
-            Array4<Complex> fields_arr = SpectralFieldData::fields[mfi].array();
-            Array4<const Complex> tmp_arr = tmpSpectralField[mfi].array();
-#if (AMREX_SPACEDIM >= 2)
-            const Complex* xshift_arr = xshift_FFTfromCell[mfi].dataPtr();
-#endif
-#if defined(WARPX_DIM_3D)
-            const Complex* yshift_arr = yshift_FFTfromCell[mfi].dataPtr();
-#endif
-            const Complex* zshift_arr = zshift_FFTfromCell[mfi].dataPtr();
-            // Loop over indices within one box
-            const Box spectralspace_bx = tmpSpectralField[mfi].box();
+            // Perform batched Fourier transform from `tmpRealField` to `tmpSpectralField`
+            AnyFFT::Execute((batch == batch_size) ? full_plans[mfi] : last_plans[mfi]);
 
-            ParallelFor( spectralspace_bx,
-            [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-                Complex spectral_field_value = tmp_arr(i,j,k);
-                // Apply proper shift in each dimension
-#if (AMREX_SPACEDIM >= 2)
-                if (is_nodal_x==false) spectral_field_value *= xshift_arr[i];
-#endif
-#if defined(WARPX_DIM_3D)
-                if (is_nodal_y==false) spectral_field_value *= yshift_arr[j];
-                if (is_nodal_z==false) spectral_field_value *= zshift_arr[k];
-#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-                if (is_nodal_z==false) spectral_field_value *= zshift_arr[j];
-#elif defined(WARPX_DIM_1D_Z)
-                if (is_nodal_z==false) spectral_field_value *= zshift_arr[i];
-#endif
-                // Copy field into the right index
-                fields_arr(i,j,k,field_index) = spectral_field_value;
-            });
+            // Copy the spectral-space field `tmpSpectralField` to the appropriate
+            // index of the FabArray `fields` (specified by `field_index`)
+            // and apply correcting shift factor if the real space data comes
+            // from a cell-centered grid in real space instead of a nodal grid.
+            {
+                Array4<Complex> fields_arr = SpectralFieldData::fields[mfi].array();
+                Array4<const Complex> tmp_arr = tmpSpectralField[mfi].const_array();
+                // Loop over indices within one box
+                const Box spectralspace_bx = tmpSpectralField[mfi].box();
+
+                ParallelFor( spectralspace_bx, batch,
+                [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept {
+                    Complex spectral_field_value = tmp_arr(i,j,k,n);
+                    // Apply proper shift in each dimension
+                    const int ijk[3] = {i, j, k};
+                    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                        if (copy_comps[n].is_nodal[idim] == 0) {
+                            spectral_field_value *= shift_arr[idim][ijk[idim]];
+                        }
+                    }
+                    // Copy field into the right index
+                    fields_arr(i,j,k,copy_comps[n].field_index) = spectral_field_value;
+                });
+            }
         }
 
         if (do_costs)
@@ -313,146 +545,152 @@ SpectralFieldData::BackwardTransform (const int lev,
                                       const int i_comp,
                                       const amrex::IntVect& fill_guards)
 {
-    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
-    bool do_costs = WarpXUtilLoadBalance::doCosts(cost, mf.boxArray(), mf.DistributionMap());
+    BackwardTransform(lev, BackwardTransformComps{{&mf, field_index, i_comp}}, fill_guards);
+}
 
-    // Check field index type, in order to apply proper shift in spectral space
-#if (AMREX_SPACEDIM >= 2)
-    const bool is_nodal_x = mf.is_nodal(0);
-#endif
-#if defined(WARPX_DIM_3D)
-    const bool is_nodal_y = mf.is_nodal(1);
-    const bool is_nodal_z = mf.is_nodal(2);
-#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-    const bool is_nodal_z = mf.is_nodal(1);
-#elif defined(WARPX_DIM_1D_Z)
-    const bool is_nodal_z = mf.is_nodal(0);
-#endif
+/* \brief Transform the spectral fields specified by `field_index` back to real
+ * space, by batches of m_fft_batch_size components, and store them in the
+ * components `i_comp` of the real-space MultiFabs */
+void
+SpectralFieldData::BackwardTransform (const int lev,
+                                      const BackwardTransformComps& comps,
+                                      const amrex::IntVect& fill_guards)
+{
+    if (comps.empty()) return;
 
-#if (AMREX_SPACEDIM >= 2)
-    const int si = (is_nodal_x) ? 1 : 0;
-#endif
-#if   defined(WARPX_DIM_1D_Z)
-    const int si = (is_nodal_z) ? 1 : 0;
-    const int sj = 0;
-    const int sk = 0;
-#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-    const int sj = (is_nodal_z) ? 1 : 0;
-    const int sk = 0;
-#elif defined(WARPX_DIM_3D)
-    const int sj = (is_nodal_y) ? 1 : 0;
-    const int sk = (is_nodal_z) ? 1 : 0;
-#endif
+    if (m_distributed_fft) {
+        BackwardTransformDistributed(comps);
+        return;
+    }
+
+    const MultiFab& mf0 = *comps[0].mf;
+    for (const auto& comp : comps) {
+        AMREX_ALWAYS_ASSERT(comp.mf->DistributionMap() == mf0.DistributionMap());
+    }
 
-    // Numbers of guard cells
-    const amrex::IntVect& mf_ng = mf.nGrowVect();
+    const int ncomps = static_cast<int>(comps.size());
+    const int batch_size = m_fft_batch_size;
+
+    // Make sure that the plans exist for all batch sizes used below
+    AnyFFT::FFTplans& full_plans = GetFFTPlans(lev, std::min(batch_size, ncomps),
+                                               AnyFFT::direction::C2R);
+    AnyFFT::FFTplans& last_plans = GetFFTPlans(lev, (ncomps-1) % batch_size + 1,
+                                               AnyFFT::direction::C2R);
+
+    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
+    bool do_costs = WarpXUtilLoadBalance::doCosts(cost, mf0.boxArray(), mf0.DistributionMap());
 
     // Loop over boxes
     // Note: we do NOT OpenMP parallelize here, since we use OpenMP threads for
     //       the iFFTs on each box!
-    for ( MFIter mfi(mf); mfi.isValid(); ++mfi ){
+    for ( MFIter mfi(mf0); mfi.isValid(); ++mfi ){
         if (do_costs)
         {
             amrex::Gpu::synchronize();
         }
         Real wt = amrex::second();
 
-        // Copy the spectral-space field `tmpSpectralField` to the appropriate
-        // field (specified by the input argument field_index)
-        // and apply correcting shift factor if the field is to be transformed
-        // to a cell-centered grid in real space instead of a nodal grid.
-        {
-            Array4<const Complex> field_arr = SpectralFieldData::fields[mfi].array();
-            Array4<Complex> tmp_arr = tmpSpectralField[mfi].array();
-#if (AMREX_SPACEDIM >= 2)
-            const Complex* xshift_arr = xshift_FFTtoCell[mfi].dataPtr();
-#endif
-#if defined(WARPX_DIM_3D)
-            const Complex* yshift_arr = yshift_FFTtoCell[mfi].dataPtr();
-#endif
-            const Complex* zshift_arr = zshift_FFTtoCell[mfi].dataPtr();
-            // Loop over indices within one box
-            const Box spectralspace_bx = tmpSpectralField[mfi].box();
-
-            ParallelFor( spectralspace_bx,
-            [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-                Complex spectral_field_value = field_arr(i,j,k,field_index);
-                // Apply proper shift in each dimension
-#if (AMREX_SPACEDIM >= 2)
-                if (is_nodal_x==false) spectral_field_value *= xshift_arr[i];
-#endif
+        // Correcting shift factors along each dimension
+        GpuArray<const Complex*, AMREX_SPACEDIM> shift_arr = {
 #if defined(WARPX_DIM_3D)
-                if (is_nodal_y==false) spectral_field_value *= yshift_arr[j];
-                if (is_nodal_z==false) spectral_field_value *= zshift_arr[k];
+            xshift_FFTtoCell[mfi].dataPtr(), yshift_FFTtoCell[mfi].dataPtr(),
 #elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-                if (is_nodal_z==false) spectral_field_value *= zshift_arr[j];
-#elif defined(WARPX_DIM_1D_Z)
-                if (is_nodal_z==false) spectral_field_value *= zshift_arr[i];
+            xshift_FFTtoCell[mfi].dataPtr(),
 #endif
-                // Copy field into temporary array
-                tmp_arr(i,j,k) = spectral_field_value;
-            });
-        }
+            zshift_FFTtoCell[mfi].dataPtr()};
 
-        // Perform Fourier transform from `tmpSpectralField` to `tmpRealField`
-        AnyFFT::Execute(backward_plan[mfi]);
-
-        // Copy the temporary field tmpRealField to the real-space field mf and
-        // normalize, dividing by N, since (FFT + inverse FFT) results in a factor N
+        // Loop over batches of components
+        for (int first = 0; first < ncomps; first += batch_size)
         {
-            amrex::Box mf_box = (m_periodic_single_box) ? mfi.validbox() : mfi.fabbox();
-            amrex::Array4<amrex::Real> mf_arr = mf[mfi].array();
-            amrex::Array4<const amrex::Real> tmp_arr = tmpRealField[mfi].array();
+            const int batch = std::min(batch_size, ncomps - first);
+
+            // Bounds of the box that contains the cells filled for all the components of the batch
+            IntVect batch_lo = IntVect::TheMaxVector();
+            IntVect batch_hi = IntVect::TheMinVector();
+            GpuArray<BackwardCopyComp, max_fft_batch_size> copy_comps;
+            for (int n = 0; n < batch; ++n) {
+                const auto& comp = comps[first+n];
+                MultiFab& mf = *comp.mf;
+                const IntVect is_nodal = mf.ixType().toIntVect();
+
+                Box mf_box = (m_periodic_single_box) ? mf.boxArray()[mfi.index()] : mf[mfi].box();
+
+                // Total number of cells, including ghost cells, and lower bound of the box:
+                // assume periodicity and set the last outer guard cell equal to the first one
+                const IntVect lo = mf_box.smallEnd();
+                const IntVect wrap = lo + mf_box.length() - is_nodal;
+
+                // If necessary, do not fill the guard cells
+                // (shrink box by passing negative number of cells)
+                if (m_periodic_single_box == false)
+                {
+                    const amrex::IntVect& mf_ng = mf.nGrowVect();
+                    for (int dir = 0; dir < AMREX_SPACEDIM; dir++)
+                    {
+                        if (static_cast<bool>(fill_guards[dir]) == false) mf_box.grow(dir, -mf_ng[dir]);
+                    }
+                }
 
-            const amrex::Real inv_N = 1._rt / tmpRealField[mfi].box().numPts();
+                copy_comps[n] = BackwardCopyComp{mf[mfi].array(), comp.i_comp, comp.field_index,
+                                                 is_nodal, mf_box, lo, wrap};
+                batch_lo.min(mf_box.smallEnd());
+                batch_hi.max(mf_box.bigEnd());
+            }
 
-            // Total number of cells, including ghost cells (nj represents ny in 3D and nz in 2D)
-            const int ni = mf_box.length(0);
-#if   defined(WARPX_DIM_1D_Z)
-            constexpr int nj = 1;
-            constexpr int nk = 1;
-#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-            const int nj = mf_box.length(1);
-            constexpr int nk = 1;
-#elif defined(WARPX_DIM_3D)
-            const int nj = mf_box.length(1);
-            const int nk = mf_box.length(2);
-#endif
-            // Lower bound of the box (lo_j represents lo_y in 3D and lo_z in 2D)
-            const int lo_i = amrex::lbound(mf_box).x;
-#if   defined(WARPX_DIM_1D_Z)
-            constexpr int lo_j = 0;
-            constexpr int lo_k = 0;
-#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-            const int lo_j = amrex::lbound(mf_box).y;
-            constexpr int lo_k = 0;
-#elif defined(WARPX_DIM_3D)
-            const int lo_j = amrex::lbound(mf_box).y;
-            const int lo_k = amrex::lbound(mf_box).z;
-#endif
-            // If necessary, do not fill the guard cells
-            // (shrink box by passing negative number of cells)
-            if (m_periodic_single_box == false)
+            // Copy the spectral-space fields to the temporary field `tmpSpectralField`
+            // (one component per field of the batch)
+            // and apply correcting shift factor if the field is to be transformed
+            // to a cell-centered grid in real space instead of a nodal grid.
             {
-                for (int dir = 0; dir < AMREX_SPACEDIM; dir++)
-                {
-                    if (static_cast<bool>(fill_guards[dir]) == false) mf_box.grow(dir, -mf_ng[dir]);
-                }
+                Array4<const Complex> field_arr = SpectralFieldData::fields[mfi].const_array();
+                Array4<Complex> tmp_arr = tmpSpectralField[mfi].array();
+                // Loop over indices within one box
+                const Box spectralspace_bx = tmpSpectralField[mfi].box();
+
+                ParallelFor( spectralspace_bx, batch,
+                [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept {
+                    Complex spectral_field_value = field_arr(i,j,k,copy_comps[n].field_index);
+                    // Apply proper shift in each dimension
+                    const int ijk[3] = {i, j, k};
+                    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                        if (copy_comps[n].is_nodal[idim] == 0) {
+                            spectral_field_value *= shift_arr[idim][ijk[idim]];
+                        }
+                    }
+                    // Copy field into temporary array
+                    tmp_arr(i,j,k,n) = spectral_field_value;
+                });
             }
 
-            // Loop over cells within full box, including ghost cells
-            ParallelFor(mf_box, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
+            // Perform batched Fourier transform from `tmpSpectralField` to `tmpRealField`
+            AnyFFT::Execute((batch == batch_size) ? full_plans[mfi] : last_plans[mfi]);
+
+            // Copy the temporary field tmpRealField to the real-space fields and
+            // normalize, dividing by N, since (FFT + inverse FFT) results in a factor N
             {
-                // Assume periodicity and set the last outer guard cell equal to the first one:
-                // this is necessary in order to get the correct value along a nodal direction,
-                // because the last point along a nodal direction is always discarded when FFTs
-                // are computed, as the real-space box is always cell-centered.
-                const int ii = (i == lo_i + ni - si) ? lo_i : i;
-                const int jj = (j == lo_j + nj - sj) ? lo_j : j;
-                const int kk = (k == lo_k + nk - sk) ? lo_k : k;
-                // Copy and normalize field
-                mf_arr(i,j,k,i_comp) = inv_N * tmp_arr(ii,jj,kk);
-            });
+                amrex::Array4<const amrex::Real> tmp_arr = tmpRealField[mfi].const_array();
+
+                const amrex::Real inv_N = 1._rt / tmpRealField[mfi].box().numPts();
+
+                // Loop over cells within the full boxes, including ghost cells
+                // (the boxes of the different components differ along nodal directions)
+                ParallelFor(Box(batch_lo, batch_hi), batch,
+                [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept
+                {
+                    const BackwardCopyComp& c = copy_comps[n];
+                    if (c.box.contains(IntVect(AMREX_D_DECL(i,j,k))) == false) return;
+                    // Assume periodicity and set the last outer guard cell equal to the first one:
+                    // this is necessary in order to get the correct value along a nodal direction,
+                    // because the last point along a nodal direction is always discarded when FFTs
+                    // are computed, as the real-space box is always cell-centered.
+                    int ijk[3] = {i, j, k};
+                    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                        if (ijk[idim] == c.wrap[idim]) ijk[idim] = c.lo[idim];
+                    }
+                    // Copy and normalize field
+                    c.arr(i,j,k,c.i_comp) = inv_N * tmp_arr(ijk[0],ijk[1],ijk[2]);
+                });
+            }
         }
 
         if (do_costs)
@@ -464,4 +702,199 @@ SpectralFieldData::BackwardTransform (const int lev,
     }
 }
 
+/* \brief Transform the components `comps` of the real-space MultiFabs to spectral
+ *  space, with FFTs distributed over the whole domain, by batches of m_fft_batch_size
+ *  components, and store the corresponding results internally (in the spectral
+ *  fields specified by `field_index`) */
+void
+SpectralFieldData::ForwardTransformDistributed (const ForwardTransformComps& comps)
+{
+    for (const auto& comp : comps) {
+        AMREX_ALWAYS_ASSERT(comp.mf->DistributionMap() == tmpRealField.DistributionMap());
+    }
+
+    const int ncomps = static_cast<int>(comps.size());
+    const int batch_size = m_fft_batch_size;
+
+    // Loop over batches of components: the components of a batch are redistributed
+    // together, and transformed by the same batched FFTs
+    for (int first = 0; first < ncomps; first += batch_size)
+    {
+        const int batch = std::min(batch_size, ncomps - first);
+
+        // Copy the valid cells of the real-space fields to `tmpRealField`
+        // (one component per field of the batch; this discards the *last*
+        // point in any direction that has *nodal* index type)
+        for ( MFIter mfi(tmpRealField, TilingIfNotGPU()); mfi.isValid(); ++mfi ){
+            GpuArray<ForwardCopyComp, max_fft_batch_size> copy_comps;
+            for (int n = 0; n < batch; ++n) {
+                const auto& comp = comps[first+n];
+                copy_comps[n] = ForwardCopyComp{(*comp.mf)[mfi].const_array(), comp.i_comp,
+                                                comp.field_index, comp.mf->ixType().toIntVect()};
+            }
+            Array4<Real> tmp_arr = tmpRealField[mfi].array();
+            ParallelFor( mfi.tilebox(), batch,
+            [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept {
+                tmp_arr(i,j,k,n) = copy_comps[n].arr(i,j,k,copy_comps[n].i_comp);
+            });
+        }
+
+        // Redistribute the fields in slabs along the last dimension,
+        // and perform the FFTs along all the dimensions but the last one
+        m_slab_real.ParallelCopy(tmpRealField, 0, 0, batch);
+        AnyFFT::FFTplans& slab_plans = GetSlabFFTPlans(batch, AnyFFT::direction::R2C);
+        for ( MFIter mfi(m_slab_real); mfi.isValid(); ++mfi ){
+            AnyFFT::Execute(slab_plans[mfi]);
+        }
+
+        // Global transpose: redistribute the fields in slabs along the second-to-last
+        // dimension, and perform the FFTs along the last dimension
+        tmpSpectralField.ParallelCopy(m_slab_spectral, 0, 0, batch);
+        for ( MFIter mfi(tmpSpectralField); mfi.isValid(); ++mfi ){
+            for (int n = 0; n < batch; ++n) {
+                AnyFFT::Execute(m_last_dim_forward_plan[n][mfi]);
+            }
+        }
+
+        // Copy the spectral-space fields `tmpSpectralField` to the appropriate
+        // index of the FabArray `fields` (specified by `field_index`)
+        // and apply correcting shift factor if the real space data comes
+        // from a cell-centered grid in real space instead of a nodal grid.
+        for ( MFIter mfi(tmpSpectralField); mfi.isValid(); ++mfi ){
+            GpuArray<const Complex*, AMREX_SPACEDIM> shift_arr = {
+#if defined(WARPX_DIM_3D)
+                xshift_FFTfromCell[mfi].dataPtr(), yshift_FFTfromCell[mfi].dataPtr(),
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+                xshift_FFTfromCell[mfi].dataPtr(),
+#endif
+                zshift_FFTfromCell[mfi].dataPtr()};
+            GpuArray<ForwardCopyComp, max_fft_batch_size> copy_comps;
+            for (int n = 0; n < batch; ++n) {
+                const auto& comp = comps[first+n];
+                copy_comps[n] = ForwardCopyComp{Array4<const Real>(), comp.i_comp,
+                                                comp.field_index, comp.mf->ixType().toIntVect()};
+            }
+            Array4<Complex> fields_arr = SpectralFieldData::fields[mfi].array();
+            Array4<const Complex> tmp_arr = tmpSpectralField[mfi].const_array();
+            ParallelFor( tmpSpectralField[mfi].box(), batch,
+            [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept {
+                Complex spectral_field_value = tmp_arr(i,j,k,n);
+                // Apply proper shift in each dimension
+                const int ijk[3] = {i, j, k};
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    if (copy_comps[n].is_nodal[idim] == 0) {
+                        spectral_field_value *= shift_arr[idim][ijk[idim]];
+                    }
+                }
+                // Copy field into the right index
+                fields_arr(i,j,k,copy_comps[n].field_index) = spectral_field_value;
+            });
+        }
+    }
+}
+
+/* \brief Transform the spectral fields specified by `field_index` back to real
+ * space, with FFTs distributed over the whole domain, by batches of m_fft_batch_size
+ * components, and store them in the components `i_comp` of the real-space MultiFabs */
+void
+SpectralFieldData::BackwardTransformDistributed (const BackwardTransformComps& comps)
+{
+    for (const auto& comp : comps) {
+        AMREX_ALWAYS_ASSERT(comp.mf->DistributionMap() == tmpRealField.DistributionMap());
+    }
+
+    const int ncomps = static_cast<int>(comps.size());
+    const int batch_size = m_fft_batch_size;
+
+    // Normalize, dividing by N, since (FFT + inverse FFT) results in a factor N
+    const amrex::Real inv_N = 1._rt / m_domain_npts;
+
+    // Loop over batches of components (see ForwardTransformDistributed)
+    for (int first = 0; first < ncomps; first += batch_size)
+    {
+        const int batch = std::min(batch_size, ncomps - first);
+
+        // Copy the spectral-space fields to the temporary field `tmpSpectralField`
+        // (one component per field of the batch) and apply correcting shift factor
+        // if the field is to be transformed to a cell-centered grid in real space
+        // instead of a nodal grid.
+        for ( MFIter mfi(tmpSpectralField); mfi.isValid(); ++mfi ){
+            GpuArray<const Complex*, AMREX_SPACEDIM> shift_arr = {
+#if defined(WARPX_DIM_3D)
+                xshift_FFTtoCell[mfi].dataPtr(), yshift_FFTtoCell[mfi].dataPtr(),
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+                xshift_FFTtoCell[mfi].dataPtr(),
+#endif
+                zshift_FFTtoCell[mfi].dataPtr()};
+            GpuArray<ForwardCopyComp, max_fft_batch_size> copy_comps;
+            for (int n = 0; n < batch; ++n) {
+                const auto& comp = comps[first+n];
+                copy_comps[n] = ForwardCopyComp{Array4<const Real>(), comp.i_comp,
+                                                comp.field_index, comp.mf->ixType().toIntVect()};
+            }
+            Array4<const Complex> field_arr = SpectralFieldData::fields[mfi].const_array();
+            Array4<Complex> tmp_arr = tmpSpectralField[mfi].array();
+            ParallelFor( tmpSpectralField[mfi].box(), batch,
+            [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept {
+                Complex spectral_field_value = field_arr(i,j,k,copy_comps[n].field_index);
+                // Apply proper shift in each dimension
+                const int ijk[3] = {i, j, k};
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    if (copy_comps[n].is_nodal[idim] == 0) {
+                        spectral_field_value *= shift_arr[idim][ijk[idim]];
+                    }
+                }
+                // Copy field into temporary array
+                tmp_arr(i,j,k,n) = spectral_field_value;
+            });
+        }
+
+        // Perform the FFTs along the last dimension, then the global transpose back
+        // to the slabs along the last dimension, and the FFTs along the other dimensions
+        for ( MFIter mfi(tmpSpectralField); mfi.isValid(); ++mfi ){
+            for (int n = 0; n < batch; ++n) {
+                AnyFFT::Execute(m_last_dim_backward_plan[n][mfi]);
+            }
+        }
+        m_slab_spectral.ParallelCopy(tmpSpectralField, 0, 0, batch);
+        AnyFFT::FFTplans& slab_plans = GetSlabFFTPlans(batch, AnyFFT::direction::C2R);
+        for ( MFIter mfi(m_slab_real); mfi.isValid(); ++mfi ){
+            AnyFFT::Execute(slab_plans[mfi]);
+        }
+
+        // Redistribute the fields to the boxes of the real-space grid. The guard cell
+        // receives the periodic image of the first cell: this gives the correct value
+        // of the last point along a nodal direction, which is discarded by the FFTs
+        tmpRealField.ParallelCopy(m_slab_real, 0, 0, batch, IntVect(0), IntVect(1),
+                                  m_domain_periodicity);
+
+        // Copy and normalize the fields, in the valid cells of the real-space fields
+        for ( MFIter mfi(tmpRealField, TilingIfNotGPU()); mfi.isValid(); ++mfi ){
+            // Bounds of the box that contains the cells filled for all the components of the batch
+            // (the tile boxes of the different components differ along nodal directions)
+            IntVect batch_lo = IntVect::TheMaxVector();
+            IntVect batch_hi = IntVect::TheMinVector();
+            GpuArray<BackwardCopyComp, max_fft_batch_size> copy_comps;
+            for (int n = 0; n < batch; ++n) {
+                const auto& comp = comps[first+n];
+                const IntVect is_nodal = comp.mf->ixType().toIntVect();
+                const Box bx = mfi.tilebox(is_nodal);
+                // The last point along nodal directions is already in the guard cell of
+                // `tmpRealField`, so the lo and wrap members of BackwardCopyComp are not used
+                copy_comps[n] = BackwardCopyComp{(*comp.mf)[mfi].array(), comp.i_comp,
+                                                 comp.field_index, is_nodal, bx};
+                batch_lo.min(bx.smallEnd());
+                batch_hi.max(bx.bigEnd());
+            }
+            Array4<const Real> tmp_arr = tmpRealField[mfi].const_array();
+            ParallelFor( Box(batch_lo, batch_hi), batch,
+            [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept {
+                const BackwardCopyComp& c = copy_comps[n];
+                if (c.box.contains(IntVect(AMREX_D_DECL(i,j,k))) == false) return;
+                c.arr(i,j,k,c.i_comp) = inv_N * tmp_arr(i,j,k,n);
+            });
+        }
+    }
+}
+
 #endif // WARPX_USE_PSATD
@@ -64,6 +64,8 @@ SpectralFieldDataRZ::SpectralFieldDataRZ (const int lev,
 
     // Loop over boxes and allocate the corresponding plan
     // for each box owned by the local MPI proc.
+    int num_plans = 0;
+    const amrex::Real planning_start = amrex::second();
     for (amrex::MFIter mfi(spectralspace_ba, dm); mfi.isValid(); ++mfi){
         amrex::IntVect grid_size = realspace_ba[mfi].length();
 #if defined(AMREX_USE_CUDA)
@@ -142,7 +144,8 @@ SpectralFieldDataRZ::SpectralFieldDataRZ (const int lev,
                 "rocfft_plan_description_destroy failed!\n", WarnPriority::high);
         }
 #else
-        // Create FFTW plans.
+        // Create FFTW plans, reusing the wisdom saved for this size if any.
+        AnyFFT::ImportWisdom(grid_size, AMREX_SPACEDIM);
         fftw_iodim dims[1];
         fftw_iodim howmany_dims[2];
         dims[0].n = grid_size[1];
@@ -163,7 +166,7 @@ SpectralFieldDataRZ::SpectralFieldDataRZ (const int lev,
                                reinterpret_cast<fftw_complex*>(tempHTransformed[mfi].dataPtr()), // fftw_complex *in
                                reinterpret_cast<fftw_complex*>(tmpSpectralField[mfi].dataPtr()), // fftw_complex *out
                                FFTW_FORWARD, // int sign
-                               FFTW_ESTIMATE); // unsigned flags
+                               AnyFFT::GetFFTWPlannerFlags()); // unsigned flags
         backward_plan[mfi] =
             fftw_plan_guru_dft(1, // int rank
                                dims,
@@ -172,13 +175,20 @@ SpectralFieldDataRZ::SpectralFieldDataRZ (const int lev,
                                reinterpret_cast<fftw_complex*>(tmpSpectralField[mfi].dataPtr()), // fftw_complex *in
                                reinterpret_cast<fftw_complex*>(tempHTransformed[mfi].dataPtr()), // fftw_complex *out
                                FFTW_BACKWARD, // int sign
-                               FFTW_ESTIMATE); // unsigned flags
+                               AnyFFT::GetFFTWPlannerFlags()); // unsigned flags
+        AnyFFT::ExportWisdom(grid_size, AMREX_SPACEDIM);
+#endif
+#if defined(AMREX_USE_CUDA)
+        num_plans += 1; // the forward plan is also used for the backward transform
+#else
+        num_plans += 2;
 #endif
 
         // Create the Hankel transformer for each box.
         std::array<amrex::Real,3> xmax = WarpX::UpperCorner(mfi.tilebox(), lev, 0._rt);
         multi_spectral_hankel_transformer[mfi] = SpectralHankelTransformer(grid_size[0], n_rz_azimuthal_modes, xmax[0]);
     }
+    AnyFFT::RecordPlanning(num_plans, amrex::second() - planning_start);
 }
 
 
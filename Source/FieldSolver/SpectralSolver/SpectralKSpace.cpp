@@ -21,7 +21,9 @@
 #include <AMReX_IndexType.H>
 #include <AMReX_IntVect.H>
 #include <AMReX_MFIter.H>
+#include <AMReX_ParallelDescriptor.H>
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <vector>
@@ -66,6 +68,7 @@ SpectralKSpace::SpectralKSpace( const BoxArray& realspace_ba,
         spectral_bl.push_back( spectral_bx );
     }
     spectralspace_ba.define( spectral_bl );
+    spectralspace_dm = dm;
 
     // Allocate the components of the k vector: kx, ky (only in 3D), kz
     bool only_positive_k;
@@ -80,6 +83,70 @@ SpectralKSpace::SpectralKSpace( const BoxArray& realspace_ba,
     }
 }
 
+namespace
+{
+    /* Chop `bx` along the dimension `dir` into (at most) `nboxes` boxes
+     * of nearly equal length, and assign the box number n to the MPI rank n */
+    void ChopIntoSlabs (const Box& bx, const int dir, const int nboxes,
+                        BoxArray& ba, DistributionMapping& dm)
+    {
+        const int nslabs = std::min(nboxes, bx.length(dir));
+        BoxList bl;
+        Vector<int> pmap;
+        for (int n = 0; n < nslabs; ++n) {
+            Box slab = bx;
+            slab.setSmall(dir, bx.smallEnd(dir) + (n*bx.length(dir))/nslabs);
+            slab.setBig(dir, bx.smallEnd(dir) + ((n+1)*bx.length(dir))/nslabs - 1);
+            bl.push_back(slab);
+            pmap.push_back(n);
+        }
+        ba.define(bl);
+        dm.define(pmap);
+    }
+}
+
+/* \brief Initialize k space object, for FFTs distributed over the whole domain.
+ *
+ * The real-space domain is decomposed in slabs along the last dimension,
+ * and the spectral space is decomposed in slabs along the second-to-last
+ * dimension, with one slab per MPI rank. The FFTs along all the dimensions
+ * but the last one are performed on the real-space slabs and the FFTs along
+ * the last dimension on the spectral-space slabs, after a global transpose.
+ * Boxes in spectral space use the global indices of the spectral domain,
+ * which starts at 0 in each direction.
+ *
+ * \param realspace_domain Cell-centered box that covers the whole domain
+ * \param realspace_dx Cell size of the grid in real space
+ */
+SpectralKSpace::SpectralKSpace( const Box& realspace_domain,
+                                const RealVect realspace_dx )
+    : dx(realspace_dx), m_distributed(true), m_global_fft_size(realspace_domain.length())
+{
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        realspace_domain.ixType()==IndexType::TheCellType(),
+        "SpectralKSpace expects a cell-centered box.");
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE( AMREX_SPACEDIM >= 2,
+        "Distributed FFTs require at least 2 dimensions.");
+
+    const int nprocs = ParallelDescriptor::NProcs();
+    constexpr int last_dim = AMREX_SPACEDIM-1;
+
+    ChopIntoSlabs(realspace_domain, last_dim, nprocs, realspace_slab_ba, realspace_slab_dm);
+
+    // Real-to-complex FFTs: only the positive k are kept along the first axis
+    IntVect spectral_size = m_global_fft_size;
+    spectral_size[0] = m_global_fft_size[0]/2 + 1;
+    const Box spectral_domain = Box( IntVect::TheZeroVector(),
+                                     spectral_size - IntVect::TheUnitVector() );
+    ChopIntoSlabs(spectral_domain, last_dim-1, nprocs, spectralspace_ba, spectralspace_dm);
+
+    // Allocate the components of the k vector: kx, ky (only in 3D), kz
+    for (int i_dim=0; i_dim<AMREX_SPACEDIM; i_dim++) {
+        // Real-to-complex FFTs: first axis contains only the positive k
+        k_vec[i_dim] = getKComponent(spectralspace_dm, realspace_slab_ba, i_dim, i_dim==0);
+    }
+}
+
 /* For each box, in `spectralspace_ba`, which is owned by the local MPI rank
  * (as indicated by the argument `dm`), compute the values of the
  * corresponding k coordinate along the dimension specified by `i_dim`
@@ -98,18 +165,27 @@ SpectralKSpace::getKComponent( const DistributionMapping& dm,
         Box bx = spectralspace_ba[mfi];
         Gpu::DeviceVector<Real>& k = k_comp[mfi];
 
+        // With distributed FFTs, the k vector spans the full axis of the
+        // spectral domain, and is indexed with the global spectral indices
+        const IntVect fft_size = (m_distributed) ? m_global_fft_size
+                                                 : realspace_ba[mfi].length();
+
         // Allocate k to the right size
         int N = bx.length( i_dim );
+        if (m_distributed) {
+            N = (only_positive_k) ? fft_size[i_dim]/2 + 1 : fft_size[i_dim];
+        }
         k.resize( N );
         Real* pk = k.data();
 
         // Fill the k vector
-        IntVect fft_size = realspace_ba[mfi].length();
         const Real dk = 2*MathConst::pi/(fft_size[i_dim]*dx[i_dim]);
-        WARPX_ALWAYS_ASSERT_WITH_MESSAGE( bx.smallEnd(i_dim) == 0,
-            "Expected box to start at 0, in spectral space.");
-        WARPX_ALWAYS_ASSERT_WITH_MESSAGE( bx.bigEnd(i_dim) == N-1,
-            "Expected different box end index in spectral space.");
+        if (m_distributed == false) {
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE( bx.smallEnd(i_dim) == 0,
+                "Expected box to start at 0, in spectral space.");
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE( bx.bigEnd(i_dim) == N-1,
+                "Expected different box end index in spectral space.");
+        }
         if (only_positive_k){
             // Fill the full axis with positive k values
             // (typically: first axis, in a real-to-complex FFT)
@@ -29,6 +29,7 @@ SpectralSolver::SpectralSolver(
                 const amrex::Vector<amrex::Real>& v_comoving,
                 const amrex::RealVect dx, const amrex::Real dt,
                 const bool pml, const bool periodic_single_box,
+                const bool distributed_fft,
                 const bool update_with_rho,
                 const bool fft_do_time_averaging,
                 const bool do_multi_J,
@@ -36,11 +37,15 @@ SpectralSolver::SpectralSolver(
                 const bool divb_cleaning)
 {
     // Initialize all structures using the same distribution mapping dm
+    // (with distributed FFTs, the spectral space has its own distribution mapping)
 
     // - Initialize k space object (Contains info about the size of
     // the spectral space corresponding to each box in `realspace_ba`,
     // as well as the value of the corresponding k coordinates)
-    const SpectralKSpace k_space= SpectralKSpace(realspace_ba, dm, dx);
+    const SpectralKSpace k_space = (distributed_fft) ?
+        SpectralKSpace(realspace_ba.minimalBox(), dx) :
+        SpectralKSpace(realspace_ba, dm, dx);
+    const amrex::DistributionMapping& spectral_dm = k_space.spectralspace_dm;
 
     m_spectral_index = SpectralFieldIndex(update_with_rho, fft_do_time_averaging,
                                           do_multi_J, dive_cleaning, divb_cleaning, pml);
@@ -51,7 +56,7 @@ SpectralSolver::SpectralSolver(
     if (pml) // PSATD equations in the PML grids
     {
         algorithm = std::make_unique<PsatdAlgorithmPml>(
-            k_space, dm, m_spectral_index, norder_x, norder_y, norder_z, nodal,
+            k_space, spectral_dm, m_spectral_index, norder_x, norder_y, norder_z, nodal,
             fill_guards, dt, dive_cleaning, divb_cleaning);
     }
     else // PSATD equations in the regulard grids
@@ -60,7 +65,7 @@ SpectralSolver::SpectralSolver(
         if (v_comoving[0] != 0. || v_comoving[1] != 0. || v_comoving[2] != 0.)
         {
             algorithm = std::make_unique<PsatdAlgorithmComoving>(
-                k_space, dm, m_spectral_index, norder_x, norder_y, norder_z, nodal,
+                k_space, spectral_dm, m_spectral_index, norder_x, norder_y, norder_z, nodal,
                 fill_guards, v_comoving, dt, update_with_rho);
         }
         else // PSATD algorithms: standard, Galilean, averaged Galilean, multi-J
@@ -68,13 +73,13 @@ SpectralSolver::SpectralSolver(
             if (do_multi_J)
             {
                 algorithm = std::make_unique<PsatdAlgorithmJLinearInTime>(
-                    k_space, dm, m_spectral_index, norder_x, norder_y, norder_z, nodal,
+                    k_space, spectral_dm, m_spectral_index, norder_x, norder_y, norder_z, nodal,
                     fill_guards, dt, fft_do_time_averaging, dive_cleaning, divb_cleaning);
             }
             else // standard, Galilean, averaged Galilean
             {
                 algorithm = std::make_unique<PsatdAlgorithm>(
-                    k_space, dm, m_spectral_index, norder_x, norder_y, norder_z, nodal,
+                    k_space, spectral_dm, m_spectral_index, norder_x, norder_y, norder_z, nodal,
                     fill_guards, v_galilean, dt, update_with_rho, fft_do_time_averaging,
                     dive_cleaning, divb_cleaning);
             }
@@ -83,7 +88,8 @@ SpectralSolver::SpectralSolver(
 
     // - Initialize arrays for fields in spectral space + FFT plans
     field_data = SpectralFieldData(lev, realspace_ba, k_space, dm,
-                                   m_spectral_index.n_fields, periodic_single_box);
+                                   m_spectral_index.n_fields, periodic_single_box,
+                                   distributed_fft);
 
     m_fill_guards = fill_guards;
 }
@@ -108,6 +114,20 @@ SpectralSolver::BackwardTransform( const int lev,
     field_data.BackwardTransform(lev, mf, field_index, i_comp, m_fill_guards);
 }
 
+void
+SpectralSolver::ForwardTransform (const int lev, const ForwardTransformComps& comps)
+{
+    WARPX_PROFILE("SpectralSolver::ForwardTransform");
+    field_data.ForwardTransform(lev, comps);
+}
+
+void
+SpectralSolver::BackwardTransform (const int lev, const BackwardTransformComps& comps)
+{
+    WARPX_PROFILE("SpectralSolver::BackwardTransform");
+    field_data.BackwardTransform(lev, comps, m_fill_guards);
+}
+
 void
 SpectralSolver::pushSpectralFields(){
     WARPX_PROFILE("SpectralSolver::pushSpectralFields");
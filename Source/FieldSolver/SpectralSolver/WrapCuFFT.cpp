@@ -15,40 +15,48 @@ namespace AnyFFT
 #ifdef AMREX_USE_FLOAT
     cufftType VendorR2C = CUFFT_R2C;
     cufftType VendorC2R = CUFFT_C2R;
+    cufftType VendorC2C = CUFFT_C2C;
 #else
     cufftType VendorR2C = CUFFT_D2Z;
     cufftType VendorC2R = CUFFT_Z2D;
+    cufftType VendorC2C = CUFFT_Z2Z;
 #endif
 
     std::string cufftErrorToString (const cufftResult& err);
 
     FFTplan CreatePlan(const amrex::IntVect& real_size, amrex::Real * const real_array,
-                       Complex * const complex_array, const direction dir, const int dim)
+                       Complex * const complex_array, const direction dir, const int dim,
+                       const int batch)
     {
         FFTplan fft_plan;
 
+        if (dim < 1 || dim > 3) {
+            amrex::Abort(Utils::TextMsg::Err("only dim=1, dim=2 and dim=3 have been implemented"));
+        }
+
+        // Swap dimensions: AMReX FAB are Fortran-order but cuFFT is C-order
+        int n[3];
+        for (int idim = 0; idim < dim; ++idim) n[idim] = real_size[dim-1-idim];
+
+        // Distance between the arrays of two successive transforms of the batch:
+        // the last (fastest) dimension of the complex array is n/2+1
+        int real_dist = 1;
+        int complex_dist = 1;
+        for (int idim = 0; idim < dim; ++idim) {
+            real_dist *= n[idim];
+            complex_dist *= (idim == dim-1) ? n[idim]/2+1 : n[idim];
+        }
+
         // Initialize fft_plan.m_plan with the vendor fft plan.
         cufftResult result;
         if (dir == direction::R2C){
-            if (dim == 3) {
-                result = cufftPlan3d(
-                    &(fft_plan.m_plan), real_size[2], real_size[1], real_size[0], VendorR2C);
-            } else if (dim == 2) {
-                result = cufftPlan2d(
-                    &(fft_plan.m_plan), real_size[1], real_size[0], VendorR2C);
-            } else {
-                amrex::Abort(Utils::TextMsg::Err("only dim=2 and dim=3 have been implemented"));
-            }
+            result = cufftPlanMany(
+                &(fft_plan.m_plan), dim, n,
+                nullptr, 1, real_dist, nullptr, 1, complex_dist, VendorR2C, batch);
         } else {
-            if (dim == 3) {
-                result = cufftPlan3d(
-                    &(fft_plan.m_plan), real_size[2], real_size[1], real_size[0], VendorC2R);
-            } else if (dim == 2) {
-                result = cufftPlan2d(
-                    &(fft_plan.m_plan), real_size[1], real_size[0], VendorC2R);
-            } else {
-                amrex::Abort(Utils::TextMsg::Err("only dim=2 and dim=3 have been implemented"));
-            }
+            result = cufftPlanMany(
+                &(fft_plan.m_plan), dim, n,
+                nullptr, 1, complex_dist, nullptr, 1, real_dist, VendorC2R, batch);
         }
 
         if ( result != CUFFT_SUCCESS ) {
@@ -62,6 +70,40 @@ namespace AnyFFT
         fft_plan.m_complex_array = complex_array;
         fft_plan.m_dir = dir;
         fft_plan.m_dim = dim;
+        fft_plan.m_batch = batch;
+
+        return fft_plan;
+    }
+
+    FFTplan CreateC2CPlan(const int n, const int stride, const int batch,
+                          Complex * const complex_array, const direction dir)
+    {
+        FFTplan fft_plan;
+
+        if (dir != direction::C2C_FORWARD && dir != direction::C2C_BACKWARD) {
+            amrex::Abort(Utils::TextMsg::Err(
+                "direction must be AnyFFT::direction::C2C_FORWARD or C2C_BACKWARD"));
+        }
+
+        // In-place transforms: successive points of one FFT are separated by stride,
+        // while successive FFTs start at successive points of the array
+        int n_fft = n;
+        cufftResult result = cufftPlanMany(
+            &(fft_plan.m_plan), 1, &n_fft,
+            &n_fft, stride, 1, &n_fft, stride, 1, VendorC2C, batch);
+
+        if ( result != CUFFT_SUCCESS ) {
+            amrex::Print() << Utils::TextMsg::Err(
+                    "cufftplan failed! Error: "
+                    + cufftErrorToString(result));
+        }
+
+        // Store meta-data in fft_plan
+        fft_plan.m_real_array = nullptr;
+        fft_plan.m_complex_array = complex_array;
+        fft_plan.m_dir = dir;
+        fft_plan.m_dim = 1;
+        fft_plan.m_batch = batch;
 
         return fft_plan;
     }
@@ -87,9 +129,19 @@ namespace AnyFFT
             result = cufftExecC2R(fft_plan.m_plan, fft_plan.m_complex_array, fft_plan.m_real_array);
 #else
             result = cufftExecZ2D(fft_plan.m_plan, fft_plan.m_complex_array, fft_plan.m_real_array);
+#endif
+        } else if (fft_plan.m_dir == direction::C2C_FORWARD ||
+                   fft_plan.m_dir == direction::C2C_BACKWARD){
+            const int sign = (fft_plan.m_dir == direction::C2C_FORWARD) ? CUFFT_FORWARD : CUFFT_INVERSE;
+#ifdef AMREX_USE_FLOAT
+            result = cufftExecC2C(fft_plan.m_plan, fft_plan.m_complex_array,
+                                  fft_plan.m_complex_array, sign);
+#else
+            result = cufftExecZ2Z(fft_plan.m_plan, fft_plan.m_complex_array,
+                                  fft_plan.m_complex_array, sign);
 #endif
         } else {
-            amrex::Abort("direction must be AnyFFT::direction::R2C or AnyFFT::direction::C2R");
+            amrex::Abort("direction must be AnyFFT::direction::R2C, C2R, C2C_FORWARD or C2C_BACKWARD");
         }
         if ( result != CUFFT_SUCCESS ) {
             amrex::Print() << Utils::TextMsg::Err(
@@ -98,6 +150,16 @@ namespace AnyFFT
         }
     }
 
+    void ImportWisdom (const amrex::IntVect& /*real_size*/, const int /*dim*/)
+    {
+        // The plans of this library do not depend on the planner effort: nothing to load
+    }
+
+    void ExportWisdom (const amrex::IntVect& /*real_size*/, const int /*dim*/)
+    {
+        // The plans of this library do not depend on the planner effort: nothing to save
+    }
+
     /** \brief This method converts a cufftResult
      * into the corresponding string
      *
@@ -9,61 +9,169 @@
 
 #include <AMReX.H>
 #include <AMReX_IntVect.H>
+#include <AMReX_ParallelDescriptor.H>
 #include <AMReX_REAL.H>
+#include <AMReX_Utility.H>
 
 #include <fftw3.h>
 
+#if defined(AMREX_USE_OMP) && defined(WarpX_FFTW_OMP)
+#   include <omp.h>
+#endif
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+
 namespace AnyFFT
 {
 #ifdef AMREX_USE_FLOAT
-    const auto VendorCreatePlanR2C3D = fftwf_plan_dft_r2c_3d;
-    const auto VendorCreatePlanC2R3D = fftwf_plan_dft_c2r_3d;
-    const auto VendorCreatePlanR2C2D = fftwf_plan_dft_r2c_2d;
-    const auto VendorCreatePlanC2R2D = fftwf_plan_dft_c2r_2d;
+    const auto VendorCreatePlanManyR2C = fftwf_plan_many_dft_r2c;
+    const auto VendorCreatePlanManyC2R = fftwf_plan_many_dft_c2r;
+    const auto VendorCreatePlanManyC2C = fftwf_plan_many_dft;
+    const auto VendorForgetWisdom = fftwf_forget_wisdom;
+    const auto VendorImportWisdom = fftwf_import_wisdom_from_filename;
+    const auto VendorExportWisdom = fftwf_export_wisdom_to_string;
 #else
-    const auto VendorCreatePlanR2C3D = fftw_plan_dft_r2c_3d;
-    const auto VendorCreatePlanC2R3D = fftw_plan_dft_c2r_3d;
-    const auto VendorCreatePlanR2C2D = fftw_plan_dft_r2c_2d;
-    const auto VendorCreatePlanC2R2D = fftw_plan_dft_c2r_2d;
+    const auto VendorCreatePlanManyR2C = fftw_plan_many_dft_r2c;
+    const auto VendorCreatePlanManyC2R = fftw_plan_many_dft_c2r;
+    const auto VendorCreatePlanManyC2C = fftw_plan_many_dft;
+    const auto VendorForgetWisdom = fftw_forget_wisdom;
+    const auto VendorImportWisdom = fftw_import_wisdom_from_filename;
+    const auto VendorExportWisdom = fftw_export_wisdom_to_string;
 #endif
 
-    FFTplan CreatePlan(const amrex::IntVect& real_size, amrex::Real * const real_array,
-                       Complex * const complex_array, const direction dir, const int dim)
+    namespace
     {
-        FFTplan fft_plan;
+        /** Name of the wisdom file for FFTs of size real_size, which contains the
+         *  precision and number of threads, since FFTW wisdom depends on both.
+         */
+        std::string WisdomFileName (const amrex::IntVect& real_size, const int dim)
+        {
+#if defined(AMREX_USE_OMP) && defined(WarpX_FFTW_OMP)
+            const int nthreads = omp_get_max_threads();
+#else
+            const int nthreads = 1;
+#endif
+            std::stringstream ss;
+            ss << GetWisdomDirectory() << "/fftw_wisdom_"
+#ifdef AMREX_USE_FLOAT
+               << "single"
+#else
+               << "double"
+#endif
+               << "_" << nthreads << "threads_";
+            for (int idim = 0; idim < dim; ++idim) {
+                ss << ((idim > 0) ? "x" : "") << real_size[idim];
+            }
+            ss << ".txt";
+            return ss.str();
+        }
 
+        /** Use the OpenMP threads in the FFTs of the plans created afterwards */
+        void InitThreads ()
+        {
 #if defined(AMREX_USE_OMP) && defined(WarpX_FFTW_OMP)
 #   ifdef AMREX_USE_FLOAT
-        fftwf_init_threads();
-        fftwf_plan_with_nthreads(omp_get_max_threads());
+            fftwf_init_threads();
+            fftwf_plan_with_nthreads(omp_get_max_threads());
 #   else
-        fftw_init_threads();
-        fftw_plan_with_nthreads(omp_get_max_threads());
+            fftw_init_threads();
+            fftw_plan_with_nthreads(omp_get_max_threads());
 #   endif
 #endif
+        }
+
+        /** Content of the wisdom file (empty if the file does not exist) */
+        std::string ReadWisdomFile (const std::string& filename)
+        {
+            std::ifstream ifs(filename);
+            return std::string(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+        }
+    }
+
+    unsigned GetFFTWPlannerFlags ()
+    {
+        switch (GetPlanEffort()) {
+            case plan_effort::measure: return FFTW_MEASURE;
+            case plan_effort::patient: return FFTW_PATIENT;
+            default: return FFTW_ESTIMATE;
+        }
+    }
+
+    void ImportWisdom (const amrex::IntVect& real_size, const int dim)
+    {
+        if (GetWisdomDirectory().empty()) return;
+
+        // Only keep the wisdom of this FFT size, so that the file written
+        // by ExportWisdom does not accumulate the wisdom of other sizes
+        VendorForgetWisdom();
+        // The file does not exist yet if these FFTs were never planned
+        VendorImportWisdom(WisdomFileName(real_size, dim).c_str());
+    }
+
+    void ExportWisdom (const amrex::IntVect& real_size, const int dim)
+    {
+        if (GetWisdomDirectory().empty()) return;
+
+        const std::string filename = WisdomFileName(real_size, dim);
+        const std::unique_ptr<char, decltype(&std::free)> wisdom(VendorExportWisdom(), &std::free);
+        if (wisdom == nullptr || ReadWisdomFile(filename) == wisdom.get()) return;
+
+        // Several MPI ranks may plan FFTs of the same size: each rank writes
+        // to its own file, which then atomically replaces the wisdom file
+        if (!amrex::UtilCreateDirectory(GetWisdomDirectory(), 0755)) {
+            amrex::CreateDirectoryFailed(GetWisdomDirectory());
+        }
+        const std::string tmp_filename =
+            filename + "." + std::to_string(amrex::ParallelDescriptor::MyProc());
+        {
+            std::ofstream ofs(tmp_filename);
+            ofs << wisdom.get();
+        }
+        std::rename(tmp_filename.c_str(), filename.c_str());
+    }
+
+    FFTplan CreatePlan(const amrex::IntVect& real_size, amrex::Real * const real_array,
+                       Complex * const complex_array, const direction dir, const int dim,
+                       const int batch)
+    {
+        FFTplan fft_plan;
+
+        InitThreads();
+
+        if (dim < 1 || dim > 3) {
+            amrex::Abort("only dim=1, dim=2 and dim=3 have been implemented.");
+        }
 
-        // Initialize fft_plan.m_plan with the vendor fft plan.
         // Swap dimensions: AMReX FAB are Fortran-order but FFTW is C-order
+        int n[3];
+        for (int idim = 0; idim < dim; ++idim) n[idim] = real_size[dim-1-idim];
+
+        // Distance between the arrays of two successive transforms of the batch:
+        // the last (fastest) dimension of the complex array is n/2+1
+        int real_dist = 1;
+        int complex_dist = 1;
+        for (int idim = 0; idim < dim; ++idim) {
+            real_dist *= n[idim];
+            complex_dist *= (idim == dim-1) ? n[idim]/2+1 : n[idim];
+        }
+
+        // Initialize fft_plan.m_plan with the vendor fft plan.
         if (dir == direction::R2C){
-            if (dim == 3) {
-                fft_plan.m_plan = VendorCreatePlanR2C3D(
-                    real_size[2], real_size[1], real_size[0], real_array, complex_array, FFTW_ESTIMATE);
-            } else if (dim == 2) {
-                fft_plan.m_plan = VendorCreatePlanR2C2D(
-                    real_size[1], real_size[0], real_array, complex_array, FFTW_ESTIMATE);
-            } else {
-                amrex::Abort("only dim=2 and dim=3 have been implemented");
-            }
+            fft_plan.m_plan = VendorCreatePlanManyR2C(
+                dim, n, batch,
+                real_array, nullptr, 1, real_dist,
+                complex_array, nullptr, 1, complex_dist, GetFFTWPlannerFlags());
         } else if (dir == direction::C2R){
-            if (dim == 3) {
-                fft_plan.m_plan = VendorCreatePlanC2R3D(
-                    real_size[2], real_size[1], real_size[0], complex_array, real_array, FFTW_ESTIMATE);
-            } else if (dim == 2) {
-                fft_plan.m_plan = VendorCreatePlanC2R2D(
-                    real_size[1], real_size[0], complex_array, real_array, FFTW_ESTIMATE);
-            } else {
-                amrex::Abort("only dim=2 and dim=3 have been implemented. Should be easy to add dim=1.");
-            }
+            fft_plan.m_plan = VendorCreatePlanManyC2R(
+                dim, n, batch,
+                complex_array, nullptr, 1, complex_dist,
+                real_array, nullptr, 1, real_dist, GetFFTWPlannerFlags());
         }
 
         // Store meta-data in fft_plan
@@ -71,6 +179,37 @@ namespace AnyFFT
         fft_plan.m_complex_array = complex_array;
         fft_plan.m_dir = dir;
         fft_plan.m_dim = dim;
+        fft_plan.m_batch = batch;
+
+        return fft_plan;
+    }
+
+    FFTplan CreateC2CPlan(const int n, const int stride, const int batch,
+                          Complex * const complex_array, const direction dir)
+    {
+        FFTplan fft_plan;
+
+        InitThreads();
+
+        if (dir != direction::C2C_FORWARD && dir != direction::C2C_BACKWARD) {
+            amrex::Abort("direction must be AnyFFT::direction::C2C_FORWARD or C2C_BACKWARD");
+        }
+
+        // In-place transforms: successive points of one FFT are separated by stride,
+        // while successive FFTs start at successive points of the array
+        fft_plan.m_plan = VendorCreatePlanManyC2C(
+            1, &n, batch,
+            complex_array, nullptr, stride, 1,
+            complex_array, nullptr, stride, 1,
+            (dir == direction::C2C_FORWARD) ? FFTW_FORWARD : FFTW_BACKWARD,
+            GetFFTWPlannerFlags());
+
+        // Store meta-data in fft_plan
+        fft_plan.m_real_array = nullptr;
+        fft_plan.m_complex_array = complex_array;
+        fft_plan.m_dir = dir;
+        fft_plan.m_dim = 1;
+        fft_plan.m_batch = batch;
 
         return fft_plan;
     }
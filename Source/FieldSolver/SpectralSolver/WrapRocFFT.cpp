@@ -22,7 +22,8 @@ namespace AnyFFT
     }
 
     FFTplan CreatePlan (const amrex::IntVect& real_size, amrex::Real * const real_array,
-                        Complex * const complex_array, const direction dir, const int dim)
+                        Complex * const complex_array, const direction dir, const int dim,
+                        const int batch)
     {
         FFTplan fft_plan;
 
@@ -42,8 +43,8 @@ namespace AnyFFT
                                                   rocfft_precision_double,
 #endif
                                                   dim, lengths,
-                                                  1, // number of transforms,
-                                                  nullptr);
+                                                  batch, // number of transforms,
+                                                  nullptr); // default: contiguous batch
         assert_rocfft_status("rocfft_plan_create", result);
 
         // Store meta-data in fft_plan
@@ -51,6 +52,60 @@ namespace AnyFFT
         fft_plan.m_complex_array = complex_array;
         fft_plan.m_dir = dir;
         fft_plan.m_dim = dim;
+        fft_plan.m_batch = batch;
+
+        return fft_plan;
+    }
+
+    FFTplan CreateC2CPlan (const int n, const int stride, const int batch,
+                           Complex * const complex_array, const direction dir)
+    {
+        FFTplan fft_plan;
+
+        if (dir != direction::C2C_FORWARD && dir != direction::C2C_BACKWARD) {
+            amrex::Abort("direction must be AnyFFT::direction::C2C_FORWARD or C2C_BACKWARD");
+        }
+
+        // In-place transforms: successive points of one FFT are separated by stride,
+        // while successive FFTs start at successive points of the array
+        rocfft_plan_description description = nullptr;
+        rocfft_status result = rocfft_plan_description_create(&description);
+        assert_rocfft_status("rocfft_plan_description_create", result);
+
+        const std::size_t strides[] = {std::size_t(stride)};
+        result = rocfft_plan_description_set_data_layout(description,
+                                                         rocfft_array_type_complex_interleaved,
+                                                         rocfft_array_type_complex_interleaved,
+                                                         nullptr, nullptr, // offsets
+                                                         1, strides, 1, // input strides, distance
+                                                         1, strides, 1); // output strides, distance
+        assert_rocfft_status("rocfft_plan_description_set_data_layout", result);
+
+        const std::size_t lengths[] = {std::size_t(n)};
+        result = rocfft_plan_create(&(fft_plan.m_plan),
+                                    rocfft_placement_inplace,
+                                    (dir == direction::C2C_FORWARD)
+                                        ? rocfft_transform_type_complex_forward
+                                        : rocfft_transform_type_complex_inverse,
+#ifdef AMREX_USE_FLOAT
+                                    rocfft_precision_single,
+#else
+                                    rocfft_precision_double,
+#endif
+                                    1, lengths,
+                                    batch, // number of transforms,
+                                    description);
+        assert_rocfft_status("rocfft_plan_create", result);
+
+        result = rocfft_plan_description_destroy(description);
+        assert_rocfft_status("rocfft_plan_description_destroy", result);
+
+        // Store meta-data in fft_plan
+        fft_plan.m_real_array = nullptr;
+        fft_plan.m_complex_array = complex_array;
+        fft_plan.m_dir = dir;
+        fft_plan.m_dim = 1;
+        fft_plan.m_batch = batch;
 
         return fft_plan;
     }
@@ -87,8 +142,14 @@ namespace AnyFFT
                                     (void**)&(fft_plan.m_complex_array), // in
                                     (void**)&(fft_plan.m_real_array), // out
                                     execinfo);
+        } else if (fft_plan.m_dir == direction::C2C_FORWARD ||
+                   fft_plan.m_dir == direction::C2C_BACKWARD) {
+            result = rocfft_execute(fft_plan.m_plan,
+                                    (void**)&(fft_plan.m_complex_array), // in and out
+                                    nullptr,
+                                    execinfo);
         } else {
-            amrex::Abort("direction must be AnyFFT::direction::R2C or AnyFFT::direction::C2R");
+            amrex::Abort("direction must be AnyFFT::direction::R2C, C2R, C2C_FORWARD or C2C_BACKWARD");
         }
 
         assert_rocfft_status("rocfft_execute", result);
@@ -101,6 +162,16 @@ namespace AnyFFT
         assert_rocfft_status("rocfft_execution_info_destroy", result);
     }
 
+    void ImportWisdom (const amrex::IntVect& /*real_size*/, const int /*dim*/)
+    {
+        // The plans of this library do not depend on the planner effort: nothing to load
+    }
+
+    void ExportWisdom (const amrex::IntVect& /*real_size*/, const int /*dim*/)
+    {
+        // The plans of this library do not depend on the planner effort: nothing to save
+    }
+
     /** \brief This method converts a rocfftResult
      * into the corresponding string
      *
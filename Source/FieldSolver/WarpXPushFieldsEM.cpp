@@ -20,6 +20,7 @@
 #       include "FieldSolver/SpectralSolver/SpectralSolver.H"
 #   endif
 #endif
+#include "Utils/PhaseTimers.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXConst.H"
@@ -41,6 +42,7 @@
 #include <AMReX_GpuLaunch.H>
 #include <AMReX_GpuQualifiers.H>
 #include <AMReX_IndexType.H>
+#include <AMReX_IntVect.H>
 #include <AMReX_MFIter.H>
 #include <AMReX_Math.H>
 #include <AMReX_MultiFab.H>
@@ -70,9 +72,10 @@ namespace {
         solver.ForwardTransform(lev, *vector_field[0], compx, *vector_field[1], compy);
         solver.ForwardTransform(lev, *vector_field[2], compz);
 #else
-        solver.ForwardTransform(lev, *vector_field[0], compx);
-        solver.ForwardTransform(lev, *vector_field[1], compy);
-        solver.ForwardTransform(lev, *vector_field[2], compz);
+        solver.ForwardTransform(lev, ForwardTransformComps{
+            {vector_field[0].get(), compx, 0},
+            {vector_field[1].get(), compy, 0},
+            {vector_field[2].get(), compz, 0}});
 #endif
     }
 
@@ -88,11 +91,13 @@ namespace {
     {
 #ifdef WARPX_DIM_RZ
         solver.BackwardTransform(lev, *vector_field[0], compx, *vector_field[1], compy);
+        solver.BackwardTransform(lev, *vector_field[2], compz);
 #else
-        solver.BackwardTransform(lev, *vector_field[0], compx);
-        solver.BackwardTransform(lev, *vector_field[1], compy);
+        solver.BackwardTransform(lev, BackwardTransformComps{
+            {vector_field[0].get(), compx, 0},
+            {vector_field[1].get(), compy, 0},
+            {vector_field[2].get(), compz, 0}});
 #endif
-        solver.BackwardTransform(lev, *vector_field[2], compz);
     }
 }
 
@@ -486,6 +491,8 @@ WarpX::PSATDScaleAverageFields (const amrex::Real scale_factor)
 void
 WarpX::PushPSATD ()
 {
+    PhaseTimers::Scope phase_timer(PhaseTimers::FieldSolve);
+
 #ifndef WARPX_USE_PSATD
     amrex::Abort("PushFieldsEM: PSATD solver selected but not built");
 #else
@@ -572,12 +579,16 @@ WarpX::EvolveB (int lev, amrex::Real a_dt, DtType a_dt_type)
 void
 WarpX::EvolveB (int lev, PatchType patch_type, amrex::Real a_dt, DtType a_dt_type)
 {
+    PhaseTimers::Scope phase_timer(PhaseTimers::FieldSolve);
 
     // Evolve B field in regular cells
     if (patch_type == PatchType::fine) {
+        // With temporal blocking, B is also updated in the guard cells that are still valid
+        const amrex::IntVect ng_update = (fdtd_temporal_blocking > 0) ?
+            FDTDBlockingGrowth() : amrex::IntVect::TheZeroVector();
         m_fdtd_solver_fp[lev]->EvolveB(Bfield_fp[lev], Efield_fp[lev], G_fp[lev],
                                        m_face_areas[lev], m_area_mod[lev], ECTRhofield[lev], Venl[lev],
-                                       m_flag_info_face[lev], m_borrowing[lev], lev, a_dt);
+                                       m_flag_info_face[lev], m_borrowing[lev], lev, a_dt, ng_update);
     } else {
         m_fdtd_solver_cp[lev]->EvolveB(Bfield_cp[lev], Efield_cp[lev], G_cp[lev],
                                        m_face_areas[lev], m_area_mod[lev], ECTRhofield[lev], Venl[lev],
@@ -622,12 +633,17 @@ WarpX::EvolveE (int lev, amrex::Real a_dt)
 void
 WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real a_dt)
 {
+    PhaseTimers::Scope phase_timer(PhaseTimers::FieldSolve);
+
     // Evolve E field in regular cells
     if (patch_type == PatchType::fine) {
+        // With temporal blocking, E is also updated in the guard cells that are still valid
+        const amrex::IntVect ng_update = (fdtd_temporal_blocking > 0) ?
+            FDTDBlockingGrowth() : amrex::IntVect::TheZeroVector();
         m_fdtd_solver_fp[lev]->EvolveE(Efield_fp[lev], Bfield_fp[lev],
                                        current_fp[lev], m_edge_lengths[lev],
                                        m_face_areas[lev], ECTRhofield[lev],
-                                       F_fp[lev], lev, a_dt );
+                                       F_fp[lev], lev, a_dt, ng_update );
     } else {
         m_fdtd_solver_cp[lev]->EvolveE(Efield_cp[lev], Bfield_cp[lev],
                                        current_cp[lev], m_edge_lengths[lev],
@@ -672,6 +688,52 @@ WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real a_dt)
 }
 
 
+void
+WarpX::EvolveBEBFused (amrex::Real a_dt)
+{
+    WARPX_PROFILE("WarpX::EvolveBEBFused()");
+    PhaseTimers::Scope phase_timer(PhaseTimers::FieldSolve);
+
+    // Temporal blocking is only implemented without mesh refinement
+    const int lev = 0;
+    // Each of the three updates invalidates one more layer of guard cells,
+    // and the kernel shrinks the updated region accordingly
+    const amrex::IntVect ng_update = AdvanceFDTDBlockingSubsteps(3);
+    m_fdtd_solver_fp[lev]->EvolveBEBFused(Bfield_fp[lev], Efield_fp[lev], current_fp[lev],
+                                          lev, a_dt, ng_update);
+    // The PEC boundary conditions are applied by the kernel, between the updates
+}
+
+amrex::IntVect
+WarpX::FDTDBlockingGrowth ()
+{
+    return AdvanceFDTDBlockingSubsteps(1);
+}
+
+amrex::IntVect
+WarpX::AdvanceFDTDBlockingSubsteps (int n)
+{
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_fdtd_blocking_substeps >= 0,
+        "The guard cells of E and B must be exchanged before the first FDTD update "
+        "with warpx.fdtd_temporal_blocking");
+    // Each update of E or B invalidates one more layer of guard cells
+    // (the Yee and CKC stencils reach one cell away)
+    const amrex::IntVect ng_first = guard_cells.ng_FieldGather - (m_fdtd_blocking_substeps + 1);
+    m_fdtd_blocking_substeps += n;
+    const amrex::IntVect ng_last = guard_cells.ng_FieldGather - m_fdtd_blocking_substeps;
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(ng_last.allGE(amrex::IntVect::TheZeroVector()),
+        "Not enough valid guard cells for warpx.fdtd_temporal_blocking");
+    return ng_first;
+}
+
+bool
+WarpX::FDTDBlockingNeedsExchange () const
+{
+    if (fdtd_temporal_blocking == 0 || m_fdtd_blocking_substeps < 0) return true;
+    return !(guard_cells.ng_FieldGather - m_fdtd_blocking_substeps).allGE(
+        guard_cells.ng_TemporalBlockingStep);
+}
+
 void
 WarpX::EvolveF (amrex::Real a_dt, DtType a_dt_type)
 {
@@ -698,6 +760,7 @@ WarpX::EvolveF (int lev, PatchType patch_type, amrex::Real a_dt, DtType a_dt_typ
     if (!do_dive_cleaning) return;
 
     WARPX_PROFILE("WarpX::EvolveF()");
+    PhaseTimers::Scope phase_timer(PhaseTimers::FieldSolve);
 
     const int rhocomp = (a_dt_type == DtType::FirstHalf) ? 0 : 1;
 
@@ -752,6 +815,7 @@ WarpX::EvolveG (int lev, PatchType patch_type, amrex::Real a_dt, DtType /*a_dt_t
     if (!do_divb_cleaning) return;
 
     WARPX_PROFILE("WarpX::EvolveG()");
+    PhaseTimers::Scope phase_timer(PhaseTimers::FieldSolve);
 
     // Evolve G field in regular cells
     if (patch_type == PatchType::fine)
@@ -786,6 +850,8 @@ WarpX::MacroscopicEvolveE (int lev, amrex::Real a_dt) {
 
 void
 WarpX::MacroscopicEvolveE (int lev, PatchType patch_type, amrex::Real a_dt) {
+    PhaseTimers::Scope phase_timer(PhaseTimers::FieldSolve);
+
     if (patch_type == PatchType::fine) {
         m_fdtd_solver_fp[lev]->MacroscopicEvolveE( Efield_fp[lev], Bfield_fp[lev],
                                              current_fp[lev], m_edge_lengths[lev],
@@ -8,6 +8,7 @@
 #include "Filter.H"
 
 #include "Utils/WarpXProfilerWrapper.H"
+#include "WarpX.H"
 
 #include <AMReX_Array4.H>
 #include <AMReX_Box.H>
@@ -15,13 +16,77 @@
 #include <AMReX_Extension.H>
 #include <AMReX_FArrayBox.H>
 #include <AMReX_FabArray.H>
+#include <AMReX_GpuElixir.H>
+#include <AMReX_GpuLaunch.H>
 #include <AMReX_MFIter.H>
 #include <AMReX_MultiFab.H>
+#include <AMReX_OpenMP.H>
 
 #include <algorithm>
+#include <cstddef>
+#include <memory>
 
 using namespace amrex;
 
+namespace {
+    /* \brief One pass of a separable stencil along direction dir:
+     * out(i) = sum_is s[is]*(in(i-is)+in(i+is)) along dir, with in = 0 outside of its box.
+     * Instead of checking each tap, the range of the stencil is clipped
+     * to the box of in once per cell.
+     */
+    template <int dir>
+    void FilterPass (const Box& bx,
+                     Array4<Real const> const& in, int icomp,
+                     Array4<Real> const& out, int ocomp, int ncomp,
+                     Real const* AMREX_RESTRICT s, int slen)
+    {
+        constexpr int di = (dir == 0) ? 1 : 0;
+        constexpr int dj = (dir == 1) ? 1 : 0;
+        constexpr int dk = (dir == 2) ? 1 : 0;
+        const Dim3 lo = amrex::lbound(in);
+        const Dim3 hi = amrex::ubound(in);
+        // bounds of in along dir
+        const int clo = di*lo.x + dj*lo.y + dk*lo.z;
+        const int chi = di*hi.x + dj*hi.y + dk*hi.z;
+
+        amrex::ParallelFor(bx, ncomp,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        {
+            const bool inside = (di || (i >= lo.x && i <= hi.x))
+                             && (dj || (j >= lo.y && j <= hi.y))
+                             && (dk || (k >= lo.z && k <= hi.z));
+            Real d = 0._rt;
+            if (inside) {
+                const int c = di*i + dj*j + dk*k;
+                // taps c-is, with clo <= c-is <= chi
+                const int mmax = amrex::min(slen-1, c-clo);
+                for (int is = amrex::max(0, c-chi); is <= mmax; ++is) {
+                    d += s[is]*in(i-is*di, j-is*dj, k-is*dk, icomp+n);
+                }
+                // taps c+is, with clo <= c+is <= chi
+                const int pmax = amrex::min(slen-1, chi-c);
+                for (int is = amrex::max(0, clo-c); is <= pmax; ++is) {
+                    d += s[is]*in(i+is*di, j+is*dj, k+is*dk, icomp+n);
+                }
+            }
+            out(i,j,k,ocomp+n) = d;
+        });
+    }
+
+    /* \brief Returns an Array4 on box bx with ncomp components, stored in buf,
+     * which is only reallocated when it is too small (CPU only: on GPU, the
+     * kernels of consecutive boxes may run concurrently on different streams).
+     */
+    Array4<Real> PassBuffer (Gpu::DeviceVector<Real>& buf, const Box& bx, int ncomp)
+    {
+        const auto npts = static_cast<std::size_t>(bx.numPts()*ncomp);
+        if (buf.size() < npts) buf.resize(npts);
+        return Array4<Real>(buf.data(), amrex::begin(bx), amrex::end(bx), ncomp);
+    }
+}
+
+Filter::~Filter () = default;
+
 #ifdef AMREX_USE_GPU
 
 /* \brief Apply stencil on MultiFab (GPU version, 2D/3D).
@@ -35,6 +100,11 @@ using namespace amrex;
 void
 Filter::ApplyStencil (MultiFab& dstmf, const MultiFab& srcmf, const int lev, int scomp, int dcomp, int ncomp)
 {
+    if (separable) {
+        ApplySeparableStencil(dstmf, srcmf, lev, scomp, dcomp, ncomp);
+        return;
+    }
+
     WARPX_PROFILE("Filter::ApplyStencil(MultiFab)");
     ncomp = std::min(ncomp, srcmf.nComp());
 
@@ -199,6 +269,11 @@ void Filter::DoFilter (const Box& tbx,
 void
 Filter::ApplyStencil (amrex::MultiFab& dstmf, const amrex::MultiFab& srcmf, const int lev, int scomp, int dcomp, int ncomp)
 {
+    if (separable) {
+        ApplySeparableStencil(dstmf, srcmf, lev, scomp, dcomp, ncomp);
+        return;
+    }
+
     WARPX_PROFILE("Filter::ApplyStencil(MultiFab)");
     ncomp = std::min(ncomp, srcmf.nComp());
 
@@ -337,3 +412,128 @@ void Filter::DoFilter (const Box& tbx,
 }
 
 #endif // #ifdef AMREX_USE_CUDA
+
+/* \brief Apply stencil on MultiFab as a sequence of 1D passes along each
+ * direction (CPU/GPU, 1D/2D/3D). This is equivalent to the tensor-product
+ * stencil, but costs slen.x+slen.y+slen.z instead of slen.x*slen.y*slen.z
+ * operations per cell. On CPU, the passes are done tile by tile, so that
+ * the intermediate results stay in cache.
+ * \param dstmf Destination MultiFab
+ * \param srcmf source MultiFab
+ * \param[in] lev mesh refinement level
+ * \param scomp first component of srcmf on which the filter is applied
+ * \param dcomp first component of dstmf on which the filter is applied
+ * \param ncomp Number of components on which the filter is applied.
+ */
+void
+Filter::ApplySeparableStencil (MultiFab& dstmf, const MultiFab& srcmf, const int lev, int scomp, int dcomp, int ncomp)
+{
+    WARPX_PROFILE("Filter::ApplySeparableStencil(MultiFab)");
+    ncomp = std::min(ncomp, srcmf.nComp());
+
+    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
+
+#ifndef AMREX_USE_GPU
+    // two buffers per thread, kept between calls
+    const int nthreads = amrex::OpenMP::get_max_threads();
+    if (static_cast<int>(m_pass_buffers.size()) < 2*nthreads) m_pass_buffers.resize(2*nthreads);
+#endif
+
+#if (AMREX_SPACEDIM >= 2)
+    amrex::Real const* sx = stencil_x.data();
+#endif
+#if defined(WARPX_DIM_3D)
+    amrex::Real const* sy = stencil_y.data();
+#endif
+    amrex::Real const* sz = stencil_z.data();
+    const Dim3 sl = slen;
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    {
+#ifndef AMREX_USE_GPU
+        const int tid = amrex::OpenMP::get_thread_num();
+#endif
+        for (MFIter mfi(dstmf, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+            {
+                amrex::Gpu::synchronize();
+            }
+            amrex::Real wt = amrex::second();
+
+            const auto& src = srcmf.const_array(mfi);
+            const auto& dst = dstmf.array(mfi);
+            const Box& tbx = mfi.growntilebox();
+
+#if defined(WARPX_DIM_3D)
+            // pass along x on tbx grown along y and z, then along y on tbx grown along z, then along z
+            const Box& b1 = amrex::grow(amrex::grow(tbx, 1, sl.y-1), 2, sl.z-1);
+            const Box& b2 = amrex::grow(tbx, 2, sl.z-1);
+#ifdef AMREX_USE_GPU
+            // each box has its own buffers, freed once the kernels of its stream are done
+            FArrayBox tmp1_fab(b1, ncomp);
+            Elixir tmp1_eli = tmp1_fab.elixir();
+            FArrayBox tmp2_fab(b2, ncomp);
+            Elixir tmp2_eli = tmp2_fab.elixir();
+            const auto& t1 = tmp1_fab.array();
+            const auto& t2 = tmp2_fab.array();
+#else
+            const auto& t1 = PassBuffer(m_pass_buffers[2*tid  ], b1, ncomp);
+            const auto& t2 = PassBuffer(m_pass_buffers[2*tid+1], b2, ncomp);
+#endif
+            FilterPass<0>(b1, src, scomp, t1, 0, ncomp, sx, sl.x);
+            FilterPass<1>(b2, t1, 0, t2, 0, ncomp, sy, sl.y);
+            FilterPass<2>(tbx, t2, 0, dst, dcomp, ncomp, sz, sl.z);
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+            // pass along x on tbx grown along z, then along z
+            const Box& b1 = amrex::grow(tbx, 1, sl.y-1);
+#ifdef AMREX_USE_GPU
+            // each box has its own buffer, freed once the kernels of its stream are done
+            FArrayBox tmp1_fab(b1, ncomp);
+            Elixir tmp1_eli = tmp1_fab.elixir();
+            const auto& t1 = tmp1_fab.array();
+#else
+            const auto& t1 = PassBuffer(m_pass_buffers[2*tid], b1, ncomp);
+#endif
+            FilterPass<0>(b1, src, scomp, t1, 0, ncomp, sx, sl.x);
+            FilterPass<1>(tbx, t1, 0, dst, dcomp, ncomp, sz, sl.y);
+#elif defined(WARPX_DIM_1D_Z)
+            FilterPass<0>(tbx, src, scomp, dst, dcomp, ncomp, sz, sl.x);
+#else
+            amrex::Abort("Filter not implemented for the current geometry!");
+#endif
+
+            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+            {
+                amrex::Gpu::synchronize();
+                wt = amrex::second() - wt;
+                amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+            }
+        }
+    }
+}
+
+amrex::MultiFab&
+Filter::GetScratchMultiFab (int id, const amrex::BoxArray& ba, const amrex::DistributionMapping& dm,
+                            int ncomp, const amrex::IntVect& ngrow)
+{
+    for (int i = 0; i < static_cast<int>(m_scratch_mfs.size()); ++i) {
+        auto& mf = m_scratch_mfs[i];
+        if (m_scratch_ids[i] == id && mf->boxArray() == ba && mf->DistributionMap() == dm &&
+            mf->nComp() == ncomp && mf->nGrowVect() == ngrow) {
+            return *mf;
+        }
+    }
+    m_scratch_mfs.push_back(std::make_unique<amrex::MultiFab>(ba, dm, ncomp, ngrow));
+    m_scratch_ids.push_back(id);
+    return *m_scratch_mfs.back();
+}
+
+void
+Filter::ClearScratch ()
+{
+    m_scratch_mfs.clear();
+    m_scratch_ids.clear();
+}
@@ -365,80 +365,86 @@ PlasmaInjector::PlasmaInjector (int ispecies, const std::string& name)
         queryWithParser(pp_species_name, "z_shift",z_shift);
 
 #ifdef WARPX_USE_OPENPMD
-        if (amrex::ParallelDescriptor::IOProcessor()) {
+        // The file is opened on all the MPI ranks, which then read the particles in parallel
+        if (amrex::ParallelDescriptor::NProcs() > 1) {
+#if defined(AMREX_USE_MPI)
+            m_openpmd_input_series = std::make_unique<openPMD::Series>(
+                str_injection_file, openPMD::Access::READ_ONLY,
+                amrex::ParallelDescriptor::Communicator());
+#else
+            amrex::Abort("openPMD-api not built with MPI support!");
+#endif
+        } else {
             m_openpmd_input_series = std::make_unique<openPMD::Series>(
                 str_injection_file, openPMD::Access::READ_ONLY);
+        }
+
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            m_openpmd_input_series->iterations.size() == 1u,
+            "External file should contain only 1 iteration\n");
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            m_openpmd_input_series->iterations.begin()->second.particles.size() == 1u,
+            "External file should contain only 1 species\n");
+
+        // The charge and mass records are read on all the MPI ranks, since the file
+        // was opened with the MPI communicator and the reads are thus collective
+        openPMD::Iteration it = m_openpmd_input_series->iterations.begin()->second;
+        std::string const ps_name = it.particles.begin()->first;
+        openPMD::ParticleSpecies ps = it.particles.begin()->second;
 
-            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
-                m_openpmd_input_series->iterations.size() == 1u,
-                "External file should contain only 1 iteration\n");
-            openPMD::Iteration it = m_openpmd_input_series->iterations.begin()->second;
-            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
-                it.particles.size() == 1u,
-                "External file should contain only 1 species\n");
-            std::string const ps_name = it.particles.begin()->first;
-            openPMD::ParticleSpecies ps = it.particles.begin()->second;
-
-            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
-                ps.contains("charge") || charge_is_specified || species_is_specified,
-                std::string("'") + ps_name +
-                ".injection_file' does not contain a 'charge' species record. "
-                "Please specify '" + ps_name + ".charge' or "
-                "'" + ps_name + ".species_type' in your input file!\n");
-            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
-                ps.contains("mass") || mass_is_specified || species_is_specified,
-                std::string("'") + ps_name +
-                ".injection_file' does not contain a 'mass' species record. "
-                "Please specify '" + ps_name + ".mass' or "
-                "'" + ps_name + ".species_type' in your input file!\n");
-
-            if (charge_is_specified) {
-                WarpX::GetInstance().RecordWarning("Species",
-                    "Both '" + ps_name + ".charge' and '" +
-                        ps_name + ".injection_file' specify a charge.\n'" +
-                        ps_name + ".charge' will take precedence.\n");
-            }
-            else if (species_is_specified) {
-                WarpX::GetInstance().RecordWarning("Species",
-                    "Both '" + ps_name + ".species_type' and '" +
-                        ps_name + ".injection_file' specify a charge.\n'" +
-                        ps_name + ".species_type' will take precedence.\n");
-            }
-            else {
-                // TODO: Add ASSERT_WITH_MESSAGE to test if charge is a constant record
-                amrex::ParticleReal const p_q =
-                    ps["charge"][openPMD::RecordComponent::SCALAR].loadChunk<amrex::ParticleReal>().get()[0];
-                double const charge_unit = ps["charge"][openPMD::RecordComponent::SCALAR].unitSI();
-                charge = p_q * charge_unit;
-            }
-            if (mass_is_specified) {
-                WarpX::GetInstance().RecordWarning("Species",
-                    "Both '" + ps_name + ".mass' and '" +
-                        ps_name + ".injection_file' specify a charge.\n'" +
-                        ps_name + ".mass' will take precedence.\n");
-            }
-            else if (species_is_specified) {
-                WarpX::GetInstance().RecordWarning("Species",
-                    "Both '" + ps_name + ".species_type' and '" +
-                        ps_name + ".injection_file' specify a mass.\n'" +
-                        ps_name + ".species_type' will take precedence.\n");
-            }
-            else {
-                // TODO: Add ASSERT_WITH_MESSAGE to test if mass is a constant record
-                amrex::ParticleReal const p_m =
-                    ps["mass"][openPMD::RecordComponent::SCALAR].loadChunk<amrex::ParticleReal>().get()[0];
-                double const mass_unit = ps["mass"][openPMD::RecordComponent::SCALAR].unitSI();
-                mass = p_m * mass_unit;
-            }
-        } // IOProcessor
-
-        // Broadcast charge and mass to non-IO processors
-        if (!charge_is_specified && !species_is_specified)
-            amrex::ParallelDescriptor::Bcast(&charge, 1,
-                amrex::ParallelDescriptor::IOProcessorNumber());
-        if (!mass_is_specified && !species_is_specified)
-            amrex::ParallelDescriptor::Bcast(&mass, 1,
-                amrex::ParallelDescriptor::IOProcessorNumber());
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            ps.contains("charge") || charge_is_specified || species_is_specified,
+            std::string("'") + ps_name +
+            ".injection_file' does not contain a 'charge' species record. "
+            "Please specify '" + ps_name + ".charge' or "
+            "'" + ps_name + ".species_type' in your input file!\n");
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            ps.contains("mass") || mass_is_specified || species_is_specified,
+            std::string("'") + ps_name +
+            ".injection_file' does not contain a 'mass' species record. "
+            "Please specify '" + ps_name + ".mass' or "
+            "'" + ps_name + ".species_type' in your input file!\n");
+
+        if (charge_is_specified) {
+            WarpX::GetInstance().RecordWarning("Species",
+                "Both '" + ps_name + ".charge' and '" +
+                    ps_name + ".injection_file' specify a charge.\n'" +
+                    ps_name + ".charge' will take precedence.\n");
+        }
+        else if (species_is_specified) {
+            WarpX::GetInstance().RecordWarning("Species",
+                "Both '" + ps_name + ".species_type' and '" +
+                    ps_name + ".injection_file' specify a charge.\n'" +
+                    ps_name + ".species_type' will take precedence.\n");
+        }
+        else {
+            // TODO: Add ASSERT_WITH_MESSAGE to test if charge is a constant record
+            std::shared_ptr<amrex::ParticleReal> const p_q =
+                ps["charge"][openPMD::RecordComponent::SCALAR].loadChunk<amrex::ParticleReal>({0}, {1});
+            m_openpmd_input_series->flush();
+            double const charge_unit = ps["charge"][openPMD::RecordComponent::SCALAR].unitSI();
+            charge = p_q.get()[0] * charge_unit;
+        }
+        if (mass_is_specified) {
+            WarpX::GetInstance().RecordWarning("Species",
+                "Both '" + ps_name + ".mass' and '" +
+                    ps_name + ".injection_file' specify a charge.\n'" +
+                    ps_name + ".mass' will take precedence.\n");
+        }
+        else if (species_is_specified) {
+            WarpX::GetInstance().RecordWarning("Species",
+                "Both '" + ps_name + ".species_type' and '" +
+                    ps_name + ".injection_file' specify a mass.\n'" +
+                    ps_name + ".species_type' will take precedence.\n");
+        }
+        else {
+            // TODO: Add ASSERT_WITH_MESSAGE to test if mass is a constant record
+            std::shared_ptr<amrex::ParticleReal> const p_m =
+                ps["mass"][openPMD::RecordComponent::SCALAR].loadChunk<amrex::ParticleReal>({0}, {1});
+            m_openpmd_input_series->flush();
+            double const mass_unit = ps["mass"][openPMD::RecordComponent::SCALAR].unitSI();
+            mass = p_m.get()[0] * mass_unit;
+        }
 #else
         amrex::Abort("Plasma injection via external_file requires openPMD support: "
                      "Add USE_OPENPMD=TRUE when compiling WarpX.\n");
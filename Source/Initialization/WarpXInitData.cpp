@@ -18,6 +18,9 @@
 #include "Diagnostics/MultiDiagnostics.H"
 #include "Diagnostics/ReducedDiags/MultiReducedDiags.H"
 #include "FieldSolver/FiniteDifferenceSolver/MacroscopicProperties/MacroscopicProperties.H"
+#ifdef WARPX_USE_PSATD
+#   include "FieldSolver/SpectralSolver/AnyFFT.H"
+#endif
 #include "Filter/BilinearFilter.H"
 #include "Filter/NCIGodfreyFilter.H"
 #include "Particles/MultiParticleContainer.H"
@@ -246,6 +249,25 @@ WarpX::PrintMainPICparameters ()
     if (fft_do_time_averaging == 1){
       amrex::Print()<<"                      | - time-averaged is ON \n";
     }
+    if (fft_distributed == 1){
+      amrex::Print()<<"                      | - distributed FFTs are ON \n";
+    }
+    if (WarpX::maxwell_solver_id == MaxwellSolverAlgo::PSATD){
+      // Time spent creating the FFT plans (maximum over MPI ranks)
+      int num_plans = 0;
+      double planning_time = 0.;
+      AnyFFT::GetPlanningStats(num_plans, planning_time);
+      amrex::Real planning_times[2] = {static_cast<amrex::Real>(planning_time),
+          (num_plans > 0) ? static_cast<amrex::Real>(planning_time/num_plans) : 0._rt};
+      amrex::ParallelDescriptor::ReduceRealMax(planning_times, 2);
+      amrex::ParallelDescriptor::ReduceIntSum(num_plans);
+      const std::string effort =
+          (AnyFFT::GetPlanEffort() == AnyFFT::plan_effort::patient) ? "patient" :
+          (AnyFFT::GetPlanEffort() == AnyFFT::plan_effort::measure) ? "measure" : "estimate";
+      amrex::Print() << "                      | - FFT planner effort: " << effort << "\n";
+      amrex::Print() << "                      |   - " << num_plans << " plans, planning time = "
+                     << planning_times[0] << " s (" << planning_times[1] << " s per plan)\n";
+    }
   #endif // WARPX_USE_PSATD
 
   if (do_nodal==1){
@@ -633,6 +655,7 @@ WarpX::InitFilter (){
     if (WarpX::use_filter){
         WarpX::bilinear_filter.npass_each_dir = WarpX::filter_npass_each_dir.toArray<unsigned int>();
         WarpX::bilinear_filter.ComputeStencils();
+        WarpX::bilinear_filter.separable = WarpX::use_separable_filter;
     }
 }
 
@@ -13,8 +13,11 @@
 
 #include <AMReX.H>
 #include <AMReX_Algorithm.H>
+#include <AMReX_BoxArray.H>
 #include <AMReX_Config.H>
+#include <AMReX_DistributionMapping.H>
 #include <AMReX_Extension.H>
+#include <AMReX_Geometry.H>
 #include <AMReX_GpuContainers.H>
 #include <AMReX_GpuDevice.H>
 #include <AMReX_GpuLaunch.H>
@@ -24,14 +27,29 @@
 #include <AMReX_ParmParse.H>
 #include <AMReX_Print.H>
 #include <AMReX_REAL.H>
+#include <AMReX_RealBox.H>
 #include <AMReX_Vector.H>
 
+#ifdef AMREX_USE_MPI
+#   include <mpi.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
+#include <cstring>
+#include <exception>
 #include <fstream>
 #include <iterator>
 #include <limits>
+#include <stdexcept>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -75,16 +93,14 @@ WarpXLaserProfiles::FromTXYEFileLaserProfile::init (
     //Reads the (optional) delay
     queryWithParser(ppl, "delay", m_params.t_delay);
 
-    //Allocate memory for E_data Vector
-    const int data_size = m_params.time_chunk_size*
-            m_params.nx*m_params.ny;
-    m_params.E_data.resize(data_size);
+    //Whether each MPI rank can read the txye file directly
+    ppl.query("txye_shared_file_system", m_params.shared_file_system);
+
+    //Copy common params (needed to find the data used by this MPI rank)
+    m_common_params = params;
 
     //Read first time chunck
     read_data_t_chuck(0, m_params.time_chunk_size);
-
-    //Copy common params
-    m_common_params = params;
 }
 
 void
@@ -102,6 +118,35 @@ WarpXLaserProfiles::FromTXYEFileLaserProfile::update (amrex::Real t)
     //Load data chunck if needed
     if(idx_t_right >  m_params.last_time_index){
         read_data_t_chuck(idx_t_left, idx_t_left+m_params.time_chunk_size);
+        return;
+    }
+
+    //The local data range only needs to be recomputed when the grids have changed
+    //since it was computed (the grids were not yet defined at initialization, regrid,
+    //load balancing or moving window). The grids are the same on all the ranks,
+    //so that all the ranks take the same branch.
+    if(!range_grids_changed())
+        return;
+
+    //Reload the current data chunck if the local boxes need data that this rank
+    //does not hold, or much less data than it holds
+    const auto& old_range = m_params.local_range;
+    const auto new_range = find_local_data_range();
+    const bool is_contained = (new_range[1]*new_range[3] == 0) || (
+        new_range[0] >= old_range[0] &&
+        new_range[0] + new_range[1] <= old_range[0] + old_range[1] &&
+        new_range[2] >= old_range[2] &&
+        new_range[2] + new_range[3] <= old_range[2] + old_range[3]);
+    const bool is_oversized = static_cast<amrex::Long>(old_range[1])*old_range[3] >
+        2*static_cast<amrex::Long>(new_range[1])*new_range[3];
+    bool range_changed = !is_contained || is_oversized;
+    ParallelDescriptor::ReduceBoolOr(range_changed);
+    if(range_changed){
+        read_data_t_chuck(m_params.first_time_index,
+            m_params.first_time_index+m_params.time_chunk_size);
+    }
+    else{
+        store_range_grids();
     }
 }
 
@@ -283,44 +328,314 @@ WarpXLaserProfiles::FromTXYEFileLaserProfile::read_data_t_chuck(int t_begin, int
     //Indices of the first and last timestep to read
     auto i_first = max(0, t_begin);
     auto i_last = min(t_end-1, m_params.nt-1);
-    if(i_last-i_first+1 > static_cast<int>(m_params.E_data.size()))
+    if(i_last-i_first+1 > m_params.time_chunk_size)
         Abort("Data chunk to read from file is too large");
 
-    Vector<Real> h_E_data(m_params.E_data.size());
+    //Uses the data prefetched in the background, if it is the one needed.
+    //The errors of the background thread are rethrown by get().
+    const auto get_data = [&] (const std::array<int,4>& range) {
+        try{
+            if(m_params.prefetched_data.valid()){
+                auto prefetched = m_params.prefetched_data.get();
+                if(m_params.prefetched_t_begin == i_first && m_params.prefetched_range == range)
+                    return prefetched;
+            }
+            return read_data_range(i_first, i_last, range);
+        }
+        catch(const std::exception& e){
+            Abort(std::string("Error while reading txye file: ") + e.what());
+        }
+        return Vector<Real>{};
+    };
 
-    if(ParallelDescriptor::IOProcessor()){
-        //Read data chunk
-        std::ifstream inp(m_params.txye_file_name, std::ios::binary);
-        if(!inp) Abort("Failed to open txye file");
-        inp.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+    const auto local_range = find_local_data_range();
+    Vector<Real> h_E_data;
 
-        auto skip_amount = 1 +
-            3*sizeof(uint32_t) +
-            m_params.t_coords.size()*sizeof(double) +
-            m_params.h_x_coords.size()*sizeof(double) +
-            m_params.h_y_coords.size()*sizeof(double) +
-            sizeof(double)*t_begin*m_params.nx*m_params.ny;
-        inp.seekg(skip_amount);
-        if(!inp) Abort("Failed to read field data from txye file");
-        const int read_size = (i_last - i_first + 1)*
-            m_params.nx*m_params.ny;
-        Vector<double> buf_e(read_size);
-        inp.read(reinterpret_cast<char*>(buf_e.dataPtr()), read_size*sizeof(double));
-        if(!inp) Abort("Failed to read field data from txye file");
-        std::transform(buf_e.begin(), buf_e.end(), h_E_data.begin(),
-            [](auto x) {return static_cast<amrex::Real>(x);} );
+    if(m_params.shared_file_system){
+        //Each rank reads its own data from the file
+        h_E_data = get_data(local_range);
+    }
+    else{
+        //The I/O processor reads the data chunk and sends to each rank
+        //the part that it needs
+        const std::array<int,4> full_range = {0, m_params.nx, 0, m_params.ny};
+        Vector<Real> h_full_data;
+        if(ParallelDescriptor::IOProcessor())
+            h_full_data = get_data(full_range);
+
+        const auto extract_range = [&] (const std::array<int,4>& range, Real* dst) {
+            for(int it = 0; it < i_last-i_first+1; ++it){
+                for(int ix = range[0]; ix < range[0]+range[1]; ++ix){
+                    const auto src = h_full_data.begin() +
+                        (static_cast<std::size_t>(it)*m_params.nx + ix)*m_params.ny + range[2];
+                    dst = std::copy(src, src+range[3], dst);
+                }
+            }
+        };
+
+        h_E_data.resize(static_cast<std::size_t>(i_last-i_first+1)*local_range[1]*local_range[3]);
+#ifdef AMREX_USE_MPI
+        const int nprocs = ParallelDescriptor::NProcs();
+        const int io_proc = ParallelDescriptor::IOProcessorNumber();
+        Vector<int> all_ranges;
+        if(ParallelDescriptor::IOProcessor()) all_ranges.resize(4*nprocs);
+        ParallelDescriptor::Gather(local_range.data(), 4, all_ranges.dataPtr(), 4, io_proc);
+
+        Vector<Real> send_buf;
+        Vector<int> send_counts, send_displs;
+        if(ParallelDescriptor::IOProcessor()){
+            send_counts.resize(nprocs);
+            send_displs.resize(nprocs);
+            std::size_t total_size = 0;
+            for(int iproc = 0; iproc < nprocs; ++iproc){
+                send_counts[iproc] = (i_last-i_first+1)*all_ranges[4*iproc+1]*all_ranges[4*iproc+3];
+                send_displs[iproc] = static_cast<int>(total_size);
+                total_size += send_counts[iproc];
+            }
+            send_buf.resize(total_size);
+            for(int iproc = 0; iproc < nprocs; ++iproc){
+                const std::array<int,4> range = {all_ranges[4*iproc], all_ranges[4*iproc+1],
+                    all_ranges[4*iproc+2], all_ranges[4*iproc+3]};
+                extract_range(range, send_buf.dataPtr() + send_displs[iproc]);
+            }
+        }
+        MPI_Scatterv(send_buf.dataPtr(), send_counts.dataPtr(), send_displs.dataPtr(),
+            ParallelDescriptor::Mpi_typemap<Real>::type(),
+            h_E_data.dataPtr(), static_cast<int>(h_E_data.size()),
+            ParallelDescriptor::Mpi_typemap<Real>::type(),
+            io_proc, ParallelDescriptor::Communicator());
+#else
+        extract_range(local_range, h_E_data.dataPtr());
+#endif
     }
 
-    //Broadcast E_data
-    ParallelDescriptor::Bcast(h_E_data.dataPtr(),
-        h_E_data.size(), ParallelDescriptor::IOProcessorNumber());
+    //The amplitude kernels assume that the data of this rank covers its range,
+    //which contains the projection of its boxes: check it once here
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        local_range[0] >= 0 && local_range[0]+local_range[1] <= m_params.nx &&
+        local_range[2] >= 0 && local_range[2]+local_range[3] <= m_params.ny &&
+        h_E_data.size() ==
+            static_cast<std::size_t>(i_last-i_first+1)*local_range[1]*local_range[3],
+        "The txye data read by this rank does not match its data range");
 
+    m_params.E_data.resize(h_E_data.size());
     Gpu::copyAsync(Gpu::hostToDevice,h_E_data.begin(),h_E_data.end(),m_params.E_data.begin());
     Gpu::synchronize();
 
-    //Update first and last indices
+    //Update first and last indices and local index range
     m_params.first_time_index = i_first;
     m_params.last_time_index = i_last;
+    m_params.local_range = local_range;
+    store_range_grids();
+
+    //Start reading the next data chunk, while the current one is used
+    if(i_last < m_params.nt-1)
+        prefetch_data_t_chunk(i_last);
+}
+
+void
+WarpXLaserProfiles::FromTXYEFileLaserProfile::prefetch_data_t_chunk(int t_begin)
+{
+    if(!m_params.shared_file_system && !ParallelDescriptor::IOProcessor())
+        return;
+
+    const auto range = m_params.shared_file_system ?
+        m_params.local_range : std::array<int,4>{0, m_params.nx, 0, m_params.ny};
+    const int i_last = min(t_begin+m_params.time_chunk_size-1, m_params.nt-1);
+
+    m_params.prefetched_t_begin = t_begin;
+    m_params.prefetched_range = range;
+    //The background thread only reads the file: the data is sent to the
+    //other ranks and to the GPU by read_data_t_chuck, when it is needed
+    m_params.prefetched_data = std::async(std::launch::async,
+        [this, t_begin, i_last, range] () {
+            return read_data_range(t_begin, i_last, range);});
+}
+
+std::array<int,4>
+WarpXLaserProfiles::FromTXYEFileLaserProfile::find_local_data_range() const
+{
+    const std::array<int,4> full_range = {0, m_params.nx, 0, m_params.ny};
+
+#if defined(WARPX_DIM_3D) || defined(WARPX_DIM_XZ)
+    auto& warpx = WarpX::GetInstance();
+    const BoxArray& ba = warpx.boxArray(0);
+    //The grids are not defined yet at initialization, and the antenna moves
+    //in boosted-frame simulations: in these cases, all the data is used
+    if(ba.empty() || WarpX::gamma_boost > 1._rt) return full_range;
+    const DistributionMapping& dm = warpx.DistributionMap(0);
+    const Geometry& geom = warpx.Geom(0);
+
+    const auto& pos0 = m_common_params.position;
+    const auto& u_X = m_common_params.u_X;
+    const auto& u_Y = m_common_params.u_Y;
+
+    //Extent of the projection of the local boxes on the plane of the antenna
+    Real X_min = std::numeric_limits<Real>::max();
+    Real X_max = std::numeric_limits<Real>::lowest();
+    Real Y_min = std::numeric_limits<Real>::max();
+    Real Y_max = std::numeric_limits<Real>::lowest();
+    bool has_boxes = false;
+    for(int ibox = 0; ibox < static_cast<int>(ba.size()); ++ibox){
+        if(dm[ibox] != ParallelDescriptor::MyProc()) continue;
+        has_boxes = true;
+        const RealBox rb(ba[ibox], geom.CellSize(), geom.ProbLo());
+        for(int icorner = 0; icorner < (1 << AMREX_SPACEDIM); ++icorner){
+#if defined(WARPX_DIM_3D)
+            const Real pos[3] = {
+                (icorner & 1) ? rb.hi(0) : rb.lo(0),
+                (icorner & 2) ? rb.hi(1) : rb.lo(1),
+                (icorner & 4) ? rb.hi(2) : rb.lo(2)};
+#else
+            const Real pos[3] = {
+                (icorner & 1) ? rb.hi(0) : rb.lo(0),
+                pos0[1],
+                (icorner & 2) ? rb.hi(1) : rb.lo(1)};
+#endif
+            const Real X = u_X[0]*(pos[0]-pos0[0]) + u_X[1]*(pos[1]-pos0[1]) + u_X[2]*(pos[2]-pos0[2]);
+            const Real Y = u_Y[0]*(pos[0]-pos0[0]) + u_Y[1]*(pos[1]-pos0[1]) + u_Y[2]*(pos[2]-pos0[2]);
+            X_min = min(X_min, X); X_max = max(X_max, X);
+            Y_min = min(Y_min, Y); Y_max = max(Y_max, Y);
+        }
+    }
+    if(!has_boxes) return {0, 0, 0, 0};
+
+    //Index range {lo, n} of the data points enclosing [c_min, c_max],
+    //with one extra point on each side
+    const auto index_range = [&] (const Vector<Real>& coords, int n, Real c_min, Real c_max) {
+        int i_lo, i_hi;
+        if(m_params.is_grid_uniform){
+            const auto scale = (n-1)/(coords.back()-coords.front());
+            i_lo = static_cast<int>(std::floor((c_min-coords.front())*scale)) - 1;
+            i_hi = static_cast<int>(std::ceil((c_max-coords.front())*scale)) + 1;
+        }
+        else{
+            i_lo = static_cast<int>(std::distance(coords.begin(),
+                std::upper_bound(coords.begin(), coords.end(), c_min))) - 2;
+            i_hi = static_cast<int>(std::distance(coords.begin(),
+                std::upper_bound(coords.begin(), coords.end(), c_max))) + 1;
+        }
+        i_lo = max(0, min(i_lo, n-1));
+        i_hi = max(i_lo, min(i_hi, n-1));
+        return std::make_pair(i_lo, i_hi-i_lo+1);
+    };
+
+    const auto x_range = index_range(m_params.h_x_coords, m_params.nx, X_min, X_max);
+#if defined(WARPX_DIM_3D)
+    const auto y_range = index_range(m_params.h_y_coords, m_params.ny, Y_min, Y_max);
+#else
+    const auto y_range = std::make_pair(0, m_params.ny);
+#endif
+    return {x_range.first, x_range.second, y_range.first, y_range.second};
+#else
+    //RZ: the antenna covers the whole plane for all the azimuthal modes
+    return full_range;
+#endif
+}
+
+bool
+WarpXLaserProfiles::FromTXYEFileLaserProfile::range_grids_changed() const
+{
+    auto& warpx = WarpX::GetInstance();
+    bool changed = !(warpx.boxArray(0) == m_params.range_ba) ||
+        !(warpx.DistributionMap(0) == m_params.range_dm);
+    const auto prob_lo = warpx.Geom(0).ProbLoArray();
+    for(int idim = 0; idim < AMREX_SPACEDIM; ++idim)
+        changed = changed || (prob_lo[idim] != m_params.range_prob_lo[idim]);
+    return changed;
+}
+
+void
+WarpXLaserProfiles::FromTXYEFileLaserProfile::store_range_grids()
+{
+    auto& warpx = WarpX::GetInstance();
+    m_params.range_ba = warpx.boxArray(0);
+    m_params.range_dm = warpx.DistributionMap(0);
+    m_params.range_prob_lo = warpx.Geom(0).ProbLoArray();
+}
+
+amrex::Vector<amrex::Real>
+WarpXLaserProfiles::FromTXYEFileLaserProfile::read_data_range(
+    int i_first, int i_last, std::array<int,4> range) const
+{
+    const int x_lo = range[0];
+    const int nx_loc = range[1];
+    const int y_lo = range[2];
+    const int ny_loc = range[3];
+    Vector<Real> h_data(static_cast<std::size_t>(i_last-i_first+1)*nx_loc*ny_loc);
+    if(h_data.empty()) return h_data;
+
+    //Position of the field data in the file
+    const std::size_t data_offset = 1 +
+        3*sizeof(uint32_t) +
+        m_params.t_coords.size()*sizeof(double) +
+        m_params.h_x_coords.size()*sizeof(double) +
+        m_params.h_y_coords.size()*sizeof(double);
+    //Position, in bytes, of the first point of the row (it, ix) to read
+    const auto row_offset = [&] (int it, int ix) {
+        return data_offset + sizeof(double)*(
+            (static_cast<std::size_t>(it)*m_params.nx + ix)*m_params.ny + y_lo);
+    };
+    const std::size_t row_size = sizeof(double)*ny_loc;
+
+    Vector<double> buf_row(ny_loc);
+    auto dst = h_data.begin();
+    const auto copy_row = [&] () {
+        dst = std::transform(buf_row.begin(), buf_row.end(), dst,
+            [](auto x) {return static_cast<amrex::Real>(x);} );
+    };
+
+#if defined(__unix__) || defined(__APPLE__)
+    if(m_params.shared_file_system){
+        const int fd = open(m_params.txye_file_name.c_str(), O_RDONLY);
+        if(fd < 0) throw std::runtime_error("Failed to open txye file");
+        struct stat file_stat;
+        if(fstat(fd, &file_stat) != 0){
+            close(fd);
+            throw std::runtime_error("Failed to open txye file");
+        }
+        const auto file_size = static_cast<std::size_t>(file_stat.st_size);
+        if(row_offset(i_last, x_lo+nx_loc-1) + row_size > file_size){
+            close(fd);
+            throw std::runtime_error("Failed to read field data from txye file");
+        }
+        void* const p_map = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if(p_map == MAP_FAILED) throw std::runtime_error("Failed to memory-map txye file");
+        const char* const p_file = static_cast<const char*>(p_map);
+        //Field data is not aligned in the file: copy it row by row
+        for(int it = i_first; it <= i_last; ++it){
+            for(int ix = x_lo; ix < x_lo+nx_loc; ++ix){
+                std::memcpy(buf_row.dataPtr(), p_file + row_offset(it, ix), row_size);
+                copy_row();
+            }
+        }
+        munmap(p_map, file_size);
+        return h_data;
+    }
+#endif
+
+    std::ifstream inp(m_params.txye_file_name, std::ios::binary);
+    if(!inp) throw std::runtime_error("Failed to open txye file");
+    inp.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+    if(nx_loc == m_params.nx && ny_loc == m_params.ny){
+        //Whole planes are read: the data is contiguous in the file
+        inp.seekg(row_offset(i_first, 0));
+        buf_row.resize(h_data.size());
+        inp.read(reinterpret_cast<char*>(buf_row.dataPtr()), buf_row.size()*sizeof(double));
+        if(!inp) throw std::runtime_error("Failed to read field data from txye file");
+        copy_row();
+        return h_data;
+    }
+    for(int it = i_first; it <= i_last; ++it){
+        for(int ix = x_lo; ix < x_lo+nx_loc; ++ix){
+            inp.seekg(row_offset(it, ix));
+            inp.read(reinterpret_cast<char*>(buf_row.dataPtr()), row_size);
+            if(!inp) throw std::runtime_error("Failed to read field data from txye file");
+            copy_row();
+        }
+    }
+    return h_data;
 }
 
 void
@@ -342,6 +657,12 @@ WarpXLaserProfiles::FromTXYEFileLaserProfile::internal_fill_amplitude_uniform(
     const auto tmp_nx = m_params.nx;
 #if (defined(WARPX_DIM_3D) || (defined WARPX_DIM_RZ))
     const auto tmp_ny = m_params.ny;
+#endif
+    const int tmp_x_lo = m_params.local_range[0];
+    const int tmp_nx_loc = m_params.local_range[1];
+#if (defined(WARPX_DIM_3D) || (defined WARPX_DIM_RZ))
+    const int tmp_y_lo = m_params.local_range[2];
+    const int tmp_ny_loc = m_params.local_range[3];
 #endif
     const auto p_E_data = m_params.E_data.dataPtr();
     const auto tmp_idx_first_time = m_params.first_time_index;
@@ -393,9 +714,16 @@ WarpXLaserProfiles::FromTXYEFileLaserProfile::internal_fill_amplitude_uniform(
 
         //Interpolate amplitude
         const auto idx = [=](int i_interp, int j_interp, int k_interp){
+            const int j_loc = j_interp-tmp_x_lo;
+            const int k_loc = k_interp-tmp_y_lo;
+            //The laser particles of this rank are in the data range of this rank
+            //(checked in read_data_t_chuck): clamp anyway in release mode
+            AMREX_ASSERT(j_loc >= 0 && j_loc < tmp_nx_loc &&
+                         k_loc >= 0 && k_loc < tmp_ny_loc);
             return
-                (i_interp-tmp_idx_first_time)*tmp_nx*tmp_ny+
-                j_interp*tmp_ny + k_interp;
+                (i_interp-tmp_idx_first_time)*tmp_nx_loc*tmp_ny_loc+
+                max(min(j_loc, tmp_nx_loc-1), 0)*tmp_ny_loc +
+                max(min(k_loc, tmp_ny_loc-1), 0);
         };
         amplitude[i] = WarpXUtilAlgo::trilinear_interp(
             t_left, t_right,
@@ -414,7 +742,12 @@ WarpXLaserProfiles::FromTXYEFileLaserProfile::internal_fill_amplitude_uniform(
 #elif defined(WARPX_DIM_XZ)
         //Interpolate amplitude
         const auto idx = [=](int i_interp, int j_interp){
-            return (i_interp-tmp_idx_first_time) * tmp_nx + j_interp;
+            const int j_loc = j_interp-tmp_x_lo;
+            //The laser particles of this rank are in the data range of this rank
+            //(checked in read_data_t_chuck): clamp anyway in release mode
+            AMREX_ASSERT(j_loc >= 0 && j_loc < tmp_nx_loc);
+            return (i_interp-tmp_idx_first_time) * tmp_nx_loc +
+                max(min(j_loc, tmp_nx_loc-1), 0);
         };
         amplitude[i] = WarpXUtilAlgo::bilinear_interp(
             t_left, t_right,
@@ -428,6 +761,7 @@ WarpXLaserProfiles::FromTXYEFileLaserProfile::internal_fill_amplitude_uniform(
 #else
         // TODO: implement WARPX_DIM_1D_Z
         amrex::ignore_unused(x_0, x_1, tmp_e_max, p_E_data, tmp_idx_first_time,
+                             tmp_x_lo, tmp_nx_loc,
                              t_left, t_right, Xp, Yp, t, idx_x_left);
         amrex::Abort("WarpXLaserProfiles::FromTXYEFileLaserProfile Not implemented for the current geometry");
 #endif
@@ -456,6 +790,12 @@ WarpXLaserProfiles::FromTXYEFileLaserProfile::internal_fill_amplitude_nonuniform
 #if (defined(WARPX_DIM_3D) || (defined WARPX_DIM_RZ))
     const auto p_y_coords = m_params.d_y_coords.dataPtr();
     const int tmp_y_coords_size = static_cast<int>(m_params.d_y_coords.size());
+#endif
+    const int tmp_x_lo = m_params.local_range[0];
+    const int tmp_nx_loc = m_params.local_range[1];
+#if (defined(WARPX_DIM_3D) || (defined WARPX_DIM_RZ))
+    const int tmp_y_lo = m_params.local_range[2];
+    const int tmp_ny_loc = m_params.local_range[3];
 #endif
     const auto p_E_data = m_params.E_data.dataPtr();
     const auto tmp_idx_first_time = m_params.first_time_index;
@@ -496,9 +836,16 @@ WarpXLaserProfiles::FromTXYEFileLaserProfile::internal_fill_amplitude_nonuniform
 
         //Interpolate amplitude
         const auto idx = [=](int i, int j, int k){
+            const int j_loc = j-tmp_x_lo;
+            const int k_loc = k-tmp_y_lo;
+            //The laser particles of this rank are in the data range of this rank
+            //(checked in read_data_t_chuck): clamp anyway in release mode
+            AMREX_ASSERT(j_loc >= 0 && j_loc < tmp_nx_loc &&
+                         k_loc >= 0 && k_loc < tmp_ny_loc);
             return
-                (i-tmp_idx_first_time)*tmp_x_coords_size*tmp_y_coords_size+
-                j*tmp_y_coords_size + k;
+                (i-tmp_idx_first_time)*tmp_nx_loc*tmp_ny_loc+
+                max(min(j_loc, tmp_nx_loc-1), 0)*tmp_ny_loc +
+                max(min(k_loc, tmp_ny_loc-1), 0);
         };
         amplitude[ip] = WarpXUtilAlgo::trilinear_interp(
             t_left, t_right,
@@ -517,7 +864,12 @@ WarpXLaserProfiles::FromTXYEFileLaserProfile::internal_fill_amplitude_nonuniform
 #elif (defined WARPX_DIM_XZ)
         //Interpolate amplitude
         const auto idx = [=](int i, int j){
-            return (i-tmp_idx_first_time) * tmp_x_coords_size + j;
+            const int j_loc = j-tmp_x_lo;
+            //The laser particles of this rank are in the data range of this rank
+            //(checked in read_data_t_chuck): clamp anyway in release mode
+            AMREX_ASSERT(j_loc >= 0 && j_loc < tmp_nx_loc);
+            return (i-tmp_idx_first_time) * tmp_nx_loc +
+                max(min(j_loc, tmp_nx_loc-1), 0);
         };
         amplitude[ip] = WarpXUtilAlgo::bilinear_interp(
             t_left, t_right,
@@ -530,6 +882,7 @@ WarpXLaserProfiles::FromTXYEFileLaserProfile::internal_fill_amplitude_nonuniform
 #else
         // TODO: implement WARPX_DIM_1D_Z
         amrex::ignore_unused(idx_x_left, idx_t_left, idx_t_right, tmp_e_max,
+                             tmp_x_lo, tmp_nx_loc,
                              p_E_data, tmp_idx_first_time, t_left, t_right, t);
         amrex::Abort("WarpXLaserProfiles::FromTXYEFileLaserProfile Not implemented for the current geometry");
 #endif
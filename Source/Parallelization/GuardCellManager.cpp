@@ -53,7 +53,8 @@ guardCellManager::Init (
     const bool do_pml,
     const int do_pml_in_domain,
     const int pml_ncell,
-    const amrex::Vector<amrex::IntVect>& ref_ratios)
+    const amrex::Vector<amrex::IntVect>& ref_ratios,
+    const int fdtd_temporal_blocking)
 {
     // When using subcycling, the particles on the fine level perform two pushes
     // before being redistributed ; therefore, we need one extra guard cell
@@ -319,4 +320,16 @@ guardCellManager::Init (
             ng_MovingWindow[moving_window_dir] = 1;
         }
     }
+
+    // With temporal blocking, E and B are also updated in the guard cells, and each
+    // of the 3 updates of a step (B, E, B) invalidates one layer of guard cells.
+    // The guard cells exchanged before the field gather are thus deep enough for
+    // fdtd_temporal_blocking steps, and E, B and J are allocated accordingly
+    // (J is then summed in all its guard cells, as with PSATD).
+    if (fdtd_temporal_blocking > 0) {
+        ng_TemporalBlockingStep = ng_FieldGather.max(IntVect(AMREX_D_DECL(3,3,3)));
+        ng_FieldGather = ng_TemporalBlockingStep + 3*(fdtd_temporal_blocking-1);
+        ng_alloc_EB.max(ng_FieldGather);
+        ng_alloc_J.max(ng_FieldGather);
+    }
 }
@@ -15,6 +15,7 @@
 #include "Filter/BilinearFilter.H"
 #include "Utils/CoarsenMR.H"
 #include "Utils/IntervalsParser.H"
+#include "Utils/PhaseTimers.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXProfilerWrapper.H"
@@ -53,6 +54,7 @@ void
 WarpX::UpdateAuxilaryData ()
 {
     WARPX_PROFILE("WarpX::UpdateAuxilaryData()");
+    PhaseTimers::Scope phase_timer(PhaseTimers::Communication);
 
     if (Bfield_aux[0][0]->ixType() == Bfield_fp[0][0]->ixType()) {
         UpdateAuxilaryDataSameType();
@@ -520,6 +522,8 @@ WarpX::FillBoundaryE(int lev, IntVect ng)
 void
 WarpX::FillBoundaryE (const int lev, const PatchType patch_type, const amrex::IntVect ng)
 {
+    PhaseTimers::Scope phase_timer(PhaseTimers::Communication);
+
     std::array<amrex::MultiFab*,3> mf;
     amrex::Periodicity period;
 
@@ -555,16 +559,17 @@ WarpX::FillBoundaryE (const int lev, const PatchType patch_type, const amrex::In
 #endif
     }
 
-    // Fill guard cells in valid domain
+    // Fill guard cells in valid domain, for the three components at once
+    amrex::Vector<amrex::IntVect> nghost(3);
     for (int i = 0; i < 3; ++i)
     {
         WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
             ng <= mf[i]->nGrowVect(),
             "Error: in FillBoundaryE, requested more guard cells than allocated");
 
-        const amrex::IntVect nghost = (safe_guard_cells) ? mf[i]->nGrowVect() : ng;
-        WarpXCommUtil::FillBoundary(*mf[i], nghost, period);
+        nghost[i] = (safe_guard_cells) ? mf[i]->nGrowVect() : ng;
     }
+    WarpXCommUtil::FillBoundary({mf[0], mf[1], mf[2]}, nghost, period);
 }
 
 void
@@ -577,6 +582,8 @@ WarpX::FillBoundaryB (int lev, IntVect ng)
 void
 WarpX::FillBoundaryB (const int lev, const PatchType patch_type, const amrex::IntVect ng)
 {
+    PhaseTimers::Scope phase_timer(PhaseTimers::Communication);
+
     std::array<amrex::MultiFab*,3> mf;
     amrex::Periodicity period;
 
@@ -612,16 +619,17 @@ WarpX::FillBoundaryB (const int lev, const PatchType patch_type, const amrex::In
 #endif
     }
 
-    // Fill guard cells in valid domain
+    // Fill guard cells in valid domain, for the three components at once
+    amrex::Vector<amrex::IntVect> nghost(3);
     for (int i = 0; i < 3; ++i)
     {
         WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
             ng <= mf[i]->nGrowVect(),
             "Error: in FillBoundaryB, requested more guard cells than allocated");
 
-        const amrex::IntVect nghost = (safe_guard_cells) ? mf[i]->nGrowVect() : ng;
-        WarpXCommUtil::FillBoundary(*mf[i], nghost, period);
+        nghost[i] = (safe_guard_cells) ? mf[i]->nGrowVect() : ng;
     }
+    WarpXCommUtil::FillBoundary({mf[0], mf[1], mf[2]}, nghost, period);
 }
 
 void
@@ -634,6 +642,8 @@ WarpX::FillBoundaryE_avg(int lev, IntVect ng)
 void
 WarpX::FillBoundaryE_avg (int lev, PatchType patch_type, IntVect ng)
 {
+    PhaseTimers::Scope phase_timer(PhaseTimers::Communication);
+
     if (patch_type == PatchType::fine)
     {
         if (do_pml && pml[lev]->ok())
@@ -649,9 +659,8 @@ WarpX::FillBoundaryE_avg (int lev, PatchType patch_type, IntVect ng)
             WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
                 ng <= Efield_avg_fp[lev][0]->nGrowVect(),
                 "Error: in FillBoundaryE_avg, requested more guard cells than allocated");
-            WarpXCommUtil::FillBoundary(*Efield_avg_fp[lev][0], ng, period);
-            WarpXCommUtil::FillBoundary(*Efield_avg_fp[lev][1], ng, period);
-            WarpXCommUtil::FillBoundary(*Efield_avg_fp[lev][2], ng, period);
+            Vector<MultiFab*> mf{Efield_avg_fp[lev][0].get(),Efield_avg_fp[lev][1].get(),Efield_avg_fp[lev][2].get()};
+            WarpXCommUtil::FillBoundary(mf, {ng, ng, ng}, period);
         }
     }
     else if (patch_type == PatchType::coarse)
@@ -670,9 +679,8 @@ WarpX::FillBoundaryE_avg (int lev, PatchType patch_type, IntVect ng)
             WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
                 ng <= Efield_avg_cp[lev][0]->nGrowVect(),
                 "Error: in FillBoundaryE, requested more guard cells than allocated");
-            WarpXCommUtil::FillBoundary(*Efield_avg_cp[lev][0], ng, cperiod);
-            WarpXCommUtil::FillBoundary(*Efield_avg_cp[lev][1], ng, cperiod);
-            WarpXCommUtil::FillBoundary(*Efield_avg_cp[lev][2], ng, cperiod);
+            Vector<MultiFab*> mf{Efield_avg_cp[lev][0].get(),Efield_avg_cp[lev][1].get(),Efield_avg_cp[lev][2].get()};
+            WarpXCommUtil::FillBoundary(mf, {ng, ng, ng}, cperiod);
         }
     }
 }
@@ -688,6 +696,8 @@ WarpX::FillBoundaryB_avg (int lev, IntVect ng)
 void
 WarpX::FillBoundaryB_avg (int lev, PatchType patch_type, IntVect ng)
 {
+    PhaseTimers::Scope phase_timer(PhaseTimers::Communication);
+
     if (patch_type == PatchType::fine)
     {
         if (do_pml && pml[lev]->ok())
@@ -702,9 +712,8 @@ WarpX::FillBoundaryB_avg (int lev, PatchType patch_type, IntVect ng)
             WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
                 ng <= Bfield_fp[lev][0]->nGrowVect(),
                 "Error: in FillBoundaryB, requested more guard cells than allocated");
-            WarpXCommUtil::FillBoundary(*Bfield_avg_fp[lev][0], ng, period);
-            WarpXCommUtil::FillBoundary(*Bfield_avg_fp[lev][1], ng, period);
-            WarpXCommUtil::FillBoundary(*Bfield_avg_fp[lev][2], ng, period);
+            Vector<MultiFab*> mf{Bfield_avg_fp[lev][0].get(),Bfield_avg_fp[lev][1].get(),Bfield_avg_fp[lev][2].get()};
+            WarpXCommUtil::FillBoundary(mf, {ng, ng, ng}, period);
         }
     }
     else if (patch_type == PatchType::coarse)
@@ -722,9 +731,8 @@ WarpX::FillBoundaryB_avg (int lev, PatchType patch_type, IntVect ng)
             WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
                 ng <= Bfield_avg_cp[lev][0]->nGrowVect(),
                 "Error: in FillBoundaryB_avg, requested more guard cells than allocated");
-            WarpXCommUtil::FillBoundary(*Bfield_avg_cp[lev][0], ng, cperiod);
-            WarpXCommUtil::FillBoundary(*Bfield_avg_cp[lev][1], ng, cperiod);
-            WarpXCommUtil::FillBoundary(*Bfield_avg_cp[lev][2], ng, cperiod);
+            Vector<MultiFab*> mf{Bfield_avg_cp[lev][0].get(),Bfield_avg_cp[lev][1].get(),Bfield_avg_cp[lev][2].get()};
+            WarpXCommUtil::FillBoundary(mf, {ng, ng, ng}, cperiod);
         }
     }
 }
@@ -739,6 +747,8 @@ WarpX::FillBoundaryF (int lev, IntVect ng)
 void
 WarpX::FillBoundaryF (int lev, PatchType patch_type, IntVect ng)
 {
+    PhaseTimers::Scope phase_timer(PhaseTimers::Communication);
+
     if (patch_type == PatchType::fine)
     {
         if (do_pml && pml[lev] && pml[lev]->ok())
@@ -783,6 +793,8 @@ void WarpX::FillBoundaryG (int lev, IntVect ng)
 
 void WarpX::FillBoundaryG (int lev, PatchType patch_type, IntVect ng)
 {
+    PhaseTimers::Scope phase_timer(PhaseTimers::Communication);
+
     if (patch_type == PatchType::fine)
     {
         if (do_pml && pml[lev] && pml[lev]->ok())
@@ -827,19 +839,20 @@ WarpX::FillBoundaryAux (IntVect ng)
 void
 WarpX::FillBoundaryAux (int lev, IntVect ng)
 {
+    PhaseTimers::Scope phase_timer(PhaseTimers::Communication);
+
     const amrex::Periodicity& period = Geom(lev).periodicity();
-    WarpXCommUtil::FillBoundary(*Efield_aux[lev][0], ng, period);
-    WarpXCommUtil::FillBoundary(*Efield_aux[lev][1], ng, period);
-    WarpXCommUtil::FillBoundary(*Efield_aux[lev][2], ng, period);
-    WarpXCommUtil::FillBoundary(*Bfield_aux[lev][0], ng, period);
-    WarpXCommUtil::FillBoundary(*Bfield_aux[lev][1], ng, period);
-    WarpXCommUtil::FillBoundary(*Bfield_aux[lev][2], ng, period);
+    // Fill the guard cells of the six components at once
+    Vector<MultiFab*> mf{Efield_aux[lev][0].get(), Efield_aux[lev][1].get(), Efield_aux[lev][2].get(),
+                         Bfield_aux[lev][0].get(), Bfield_aux[lev][1].get(), Bfield_aux[lev][2].get()};
+    WarpXCommUtil::FillBoundary(mf, Vector<IntVect>(mf.size(), ng), period);
 }
 
 void
 WarpX::SyncCurrent ()
 {
     WARPX_PROFILE("WarpX::SyncCurrent()");
+    PhaseTimers::Scope phase_timer(PhaseTimers::Communication);
 
     amrex::Vector<std::array<std::unique_ptr<amrex::MultiFab>,3>>& J_fp = current_fp;
     amrex::Vector<std::array<std::unique_ptr<amrex::MultiFab>,3>>& J_cp = current_cp;
@@ -889,6 +902,7 @@ void
 WarpX::SyncRho ()
 {
     WARPX_PROFILE("WarpX::SyncRho()");
+    PhaseTimers::Scope phase_timer(PhaseTimers::Communication);
 
     if (!rho_fp[0]) return;
     const int ncomp = rho_fp[0]->nComp();
@@ -942,10 +956,20 @@ void WarpX::ApplyFilterandSumBoundaryJ (
     const int lev,
     PatchType patch_type)
 {
+    // The summation may have been started during the deposition (warpx.do_overlap_current_sum)
+    if (patch_type == PatchType::fine && m_pending_current_sum->active) {
+        WarpXCommUtil::SumBoundary_finish(*m_pending_current_sum);
+        return;
+    }
+
     const int glev = (patch_type == PatchType::fine) ? lev : lev-1;
     const amrex::Periodicity& period = Geom(glev).periodicity();
     const std::array<std::unique_ptr<amrex::MultiFab>,3>& j = (patch_type == PatchType::fine) ?
                                                               J_fp[lev] : J_cp[lev];
+    // The guard cells of the three components are summed at once
+    amrex::Vector<amrex::MultiFab*> mf_dst(3);
+    amrex::Vector<amrex::MultiFab const*> mf_src(3);
+    amrex::Vector<amrex::IntVect> mf_ng_depos_J(3);
     for (int idim = 0; idim < 3; ++idim) {
         IntVect ng = j[idim]->nGrowVect();
         IntVect ng_depos_J = get_ng_depos_J();
@@ -966,13 +990,21 @@ void WarpX::ApplyFilterandSumBoundaryJ (
             ng += bilinear_filter.stencil_length_each_dir-1;
             ng_depos_J += bilinear_filter.stencil_length_each_dir-1;
             ng_depos_J.min(ng);
-            MultiFab jf(j[idim]->boxArray(), j[idim]->DistributionMap(), j[idim]->nComp(), ng);
+            // The filtered current is stored in a MultiFab kept by the filter between steps
+            MultiFab& jf = bilinear_filter.GetScratchMultiFab(idim,
+                j[idim]->boxArray(), j[idim]->DistributionMap(), j[idim]->nComp(), ng);
             bilinear_filter.ApplyStencil(jf, *j[idim], lev);
-            WarpXSumGuardCells(*(j[idim]), jf, period, ng_depos_J, 0, (j[idim])->nComp());
+            mf_src[idim] = &jf;
         } else {
             ng_depos_J.min(ng);
-            WarpXSumGuardCells(*(j[idim]), period, ng_depos_J, 0, (j[idim])->nComp());
         }
+        mf_dst[idim] = j[idim].get();
+        mf_ng_depos_J[idim] = ng_depos_J;
+    }
+    if (use_filter) {
+        WarpXSumGuardCells(mf_dst, mf_src, period, mf_ng_depos_J, 0, j[0]->nComp());
+    } else {
+        WarpXSumGuardCells(mf_dst, period, mf_ng_depos_J, 0, j[0]->nComp());
     }
 }
 
@@ -7,12 +7,336 @@
 #include "WarpXCommUtil.H"
 
 #include <AMReX.H>
+#include <AMReX_Arena.H>
 #include <AMReX_BaseFab.H>
 #include <AMReX_IntVect.H>
 #include <AMReX_FabArray.H>
+#include <AMReX_GpuAtomic.H>
+#include <AMReX_GpuLaunch.H>
 #include <AMReX_MultiFab.H>
+#include <AMReX_ParallelContext.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_TagParallelFor.H>
 #include <AMReX_iMultiFab.H>
 
+#include <climits>
+#include <cstddef>
+#include <map>
+#include <memory>
+
+namespace {
+
+    using CommMetaData = amrex::FabArrayBase::CommMetaData;
+    using CopyComTagsContainer = amrex::FabArrayBase::CopyComTagsContainer;
+
+#ifdef AMREX_USE_GPU
+    /** \brief Copy (or addition) of a box of a source FArrayBox into a destination
+     * FArrayBox, for the local copies of the fused exchanges
+     */
+    struct LocalCopyTag {
+        amrex::Array4<amrex::Real> dfab;
+        amrex::Array4<amrex::Real const> sfab;
+        amrex::Box dbox;
+        amrex::Dim3 offset;
+        int ncomp;
+
+        AMREX_GPU_HOST_DEVICE
+        amrex::Box const& box () const noexcept { return dbox; }
+    };
+
+    /** \brief Does the local copies (or additions) of pe.src[i] into pe.dst[i], for all i,
+     * in one kernel launch for all the MultiFabs and boxes.
+     * The destination boxes of an addition can overlap (e.g. with nodal data),
+     * in which case the values are added atomically.
+     */
+    void FusedLocalCopy_gpu (WarpXCommUtil::PendingExchange const& pe)
+    {
+        using namespace amrex;
+
+        const int nmf = static_cast<int>(pe.dst.size());
+        const int scomp = pe.scomp;
+        const int dcomp = pe.dcomp;
+
+        Vector<LocalCopyTag> loc_tags;
+        bool threadsafe = true;
+        for (int i = 0; i < nmf; ++i) {
+            if (!pe.cmd[i]->m_LocTags) continue;
+            threadsafe = threadsafe && pe.cmd[i]->m_threadsafe_loc;
+            for (auto const& tag : *pe.cmd[i]->m_LocTags) {
+                loc_tags.push_back(LocalCopyTag{pe.dst[i]->array(tag.dstIndex),
+                                                pe.src[i]->const_array(tag.srcIndex),
+                                                tag.dbox,
+                                                (tag.sbox.smallEnd() - tag.dbox.smallEnd()).dim3(),
+                                                pe.ncomp[i]});
+            }
+        }
+        if (loc_tags.empty()) return;
+
+        if (pe.op == FabArrayBase::COPY) {
+            // Overlapping copies write the same values, in the cells shared by several boxes
+            ParallelFor(loc_tags,
+            [=] AMREX_GPU_DEVICE (int ii, int jj, int kk, LocalCopyTag const& tag) noexcept
+            {
+                for (int n = 0; n < tag.ncomp; ++n) {
+                    tag.dfab(ii,jj,kk,dcomp+n) = tag.sfab(ii+tag.offset.x,jj+tag.offset.y,kk+tag.offset.z,scomp+n);
+                }
+            });
+        } else if (threadsafe) {
+            ParallelFor(loc_tags,
+            [=] AMREX_GPU_DEVICE (int ii, int jj, int kk, LocalCopyTag const& tag) noexcept
+            {
+                for (int n = 0; n < tag.ncomp; ++n) {
+                    tag.dfab(ii,jj,kk,dcomp+n) += tag.sfab(ii+tag.offset.x,jj+tag.offset.y,kk+tag.offset.z,scomp+n);
+                }
+            });
+        } else {
+            ParallelFor(loc_tags,
+            [=] AMREX_GPU_DEVICE (int ii, int jj, int kk, LocalCopyTag const& tag) noexcept
+            {
+                for (int n = 0; n < tag.ncomp; ++n) {
+                    Gpu::Atomic::AddNoRet(tag.dfab.ptr(ii,jj,kk,dcomp+n),
+                        tag.sfab(ii+tag.offset.x,jj+tag.offset.y,kk+tag.offset.z,scomp+n));
+                }
+            });
+        }
+    }
+#endif
+
+    /** \brief Starts to copy (or add) the data of pe.src[i] into pe.dst[i], for all i,
+     * following the communication patterns pe.cmd[i] (as computed by getFB or getCPC):
+     * posts the receives and the sends, and does the local copies.
+     * The data that all the MultiFabs exchange with a given rank is packed into
+     * one message, so that there is one message per neighbor rank in total.
+     */
+    void FusedParallelCopy_nowait (WarpXCommUtil::PendingExchange& pe)
+    {
+        using namespace amrex;
+
+        const int nmf = static_cast<int>(pe.dst.size());
+        pe.active = true;
+        if (nmf == 0) return;
+
+        auto const& dst = pe.dst;
+        auto const& src = pe.src;
+        auto const& cmd = pe.cmd;
+        auto const& ncomp = pe.ncomp;
+        const int scomp = pe.scomp;
+        const int dcomp = pe.dcomp;
+
+#ifdef AMREX_USE_MPI
+        // Size in bytes of the data exchanged with each rank, for each MultiFab
+        std::map<int, Vector<std::size_t>> send_size;
+        auto& recv_size = pe.recv_size;
+        for (int i = 0; i < nmf; ++i) {
+            if (cmd[i]->m_SndTags) {
+                for (auto const& kv : *cmd[i]->m_SndTags) {
+                    std::size_t nbytes = 0;
+                    for (auto const& tag : kv.second) {
+                        nbytes += tag.sbox.numPts() * ncomp[i] * sizeof(Real);
+                    }
+                    auto& sizes = send_size[kv.first];
+                    sizes.resize(nmf, 0);
+                    sizes[i] = nbytes;
+                }
+            }
+            if (cmd[i]->m_RcvTags) {
+                for (auto const& kv : *cmd[i]->m_RcvTags) {
+                    std::size_t nbytes = 0;
+                    for (auto const& tag : kv.second) {
+                        nbytes += tag.dbox.numPts() * ncomp[i] * sizeof(Real);
+                    }
+                    auto& sizes = recv_size[kv.first];
+                    sizes.resize(nmf, 0);
+                    sizes[i] = nbytes;
+                }
+            }
+        }
+
+        const int seq_num = ParallelDescriptor::SeqNum();
+        MPI_Comm comm = ParallelContext::CommunicatorSub();
+
+        // Post the receives: one message per rank, containing all the MultiFabs
+        for (auto const& kv : recv_size) {
+            std::size_t nbytes = 0;
+            for (auto n : kv.second) nbytes += n;
+            if (nbytes == 0) continue;
+            AMREX_ALWAYS_ASSERT(nbytes < static_cast<std::size_t>(INT_MAX));
+            char* buffer = static_cast<char*>(The_Comms_Arena()->alloc(nbytes));
+            pe.recv_reqs.push_back(MPI_REQUEST_NULL);
+            MPI_Irecv(buffer, static_cast<int>(nbytes), MPI_CHAR,
+                      ParallelContext::global_to_local_rank(kv.first), seq_num, comm,
+                      &pe.recv_reqs.back());
+            pe.recv_from.push_back(kv.first);
+            pe.recv_buffer.push_back(buffer);
+        }
+
+        // Pack the data of each MultiFab at its offset in the message to each rank
+        Vector<int> send_to;
+        Vector<std::size_t> send_nbytes;
+        for (auto const& kv : send_size) {
+            std::size_t nbytes = 0;
+            for (auto n : kv.second) nbytes += n;
+            if (nbytes == 0) continue;
+            AMREX_ALWAYS_ASSERT(nbytes < static_cast<std::size_t>(INT_MAX));
+            send_to.push_back(kv.first);
+            pe.send_buffer.push_back(static_cast<char*>(The_Comms_Arena()->alloc(nbytes)));
+            send_nbytes.push_back(nbytes);
+        }
+        Vector<std::size_t> send_offset(send_to.size(), 0);
+        for (int i = 0; i < nmf; ++i) {
+            Vector<char*> data;
+            Vector<std::size_t> size;
+            Vector<const CopyComTagsContainer*> cctc;
+            for (int r = 0; r < static_cast<int>(send_to.size()); ++r) {
+                const std::size_t nbytes = send_size[send_to[r]][i];
+                if (nbytes == 0) continue;
+                data.push_back(pe.send_buffer[r] + send_offset[r]);
+                size.push_back(nbytes);
+                cctc.push_back(&cmd[i]->m_SndTags->at(send_to[r]));
+                send_offset[r] += nbytes;
+            }
+            if (data.empty()) continue;
+#ifdef AMREX_USE_GPU
+            if (Gpu::inLaunchRegion()) {
+                FabArray<FArrayBox>::pack_send_buffer_gpu(*src[i], scomp, ncomp[i], data, size, cctc);
+            } else
+#endif
+            {
+                FabArray<FArrayBox>::pack_send_buffer_cpu(*src[i], scomp, ncomp[i], data, size, cctc);
+            }
+        }
+        Gpu::streamSynchronize();
+
+        pe.send_reqs.resize(send_to.size(), MPI_REQUEST_NULL);
+        for (int r = 0; r < static_cast<int>(send_to.size()); ++r) {
+            MPI_Isend(pe.send_buffer[r], static_cast<int>(send_nbytes[r]), MPI_CHAR,
+                      ParallelContext::global_to_local_rank(send_to[r]), seq_num, comm,
+                      &pe.send_reqs[r]);
+        }
+#endif
+
+        // Local copies, while the messages are in flight
+#ifdef AMREX_USE_GPU
+        if (Gpu::inLaunchRegion()) {
+            FusedLocalCopy_gpu(pe);
+            // The copies must be done before the MultiFabs are modified by other
+            // kernels, which may run on other streams (e.g. the deposition of the
+            // interior tiles with warpx.do_overlap_current_sum = 1)
+            Gpu::streamSynchronize();
+            return;
+        }
+#endif
+        for (int i = 0; i < nmf; ++i) {
+            if (!cmd[i]->m_LocTags) continue;
+            auto const& tags = *cmd[i]->m_LocTags;
+            const int ntags = static_cast<int>(tags.size());
+            const int nc = ncomp[i];
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for if (Gpu::notInLaunchRegion() && cmd[i]->m_threadsafe_loc)
+#endif
+            for (int itag = 0; itag < ntags; ++itag) {
+                auto const& tag = tags[itag];
+                auto const sfab = src[i]->const_array(tag.srcIndex);
+                auto const dfab = dst[i]->array(tag.dstIndex);
+                const Dim3 offset = (tag.sbox.smallEnd() - tag.dbox.smallEnd()).dim3();
+                if (pe.op == FabArrayBase::COPY) {
+                    ParallelFor(tag.dbox, nc,
+                    [=] AMREX_GPU_DEVICE (int ii, int jj, int kk, int n) noexcept
+                    {
+                        dfab(ii,jj,kk,dcomp+n) = sfab(ii+offset.x,jj+offset.y,kk+offset.z,scomp+n);
+                    });
+                } else {
+                    ParallelFor(tag.dbox, nc,
+                    [=] AMREX_GPU_DEVICE (int ii, int jj, int kk, int n) noexcept
+                    {
+                        dfab(ii,jj,kk,dcomp+n) += sfab(ii+offset.x,jj+offset.y,kk+offset.z,scomp+n);
+                    });
+                }
+            }
+        }
+    }
+
+    /** \brief Completes an exchange started by FusedParallelCopy_nowait:
+     * waits for the messages, unpacks the received data and frees the buffers.
+     */
+    void FusedParallelCopy_finish (WarpXCommUtil::PendingExchange& pe)
+    {
+        using namespace amrex;
+
+        if (!pe.active) return;
+
+#ifdef AMREX_USE_MPI
+        const int nmf = static_cast<int>(pe.dst.size());
+        auto const& dst = pe.dst;
+        auto const& cmd = pe.cmd;
+        auto const& ncomp = pe.ncomp;
+        const int dcomp = pe.dcomp;
+
+        // Unpack the data of each MultiFab from its offset in the message from each rank
+        if (!pe.recv_reqs.empty()) {
+            Vector<MPI_Status> stats(pe.recv_reqs.size());
+            MPI_Waitall(static_cast<int>(pe.recv_reqs.size()), pe.recv_reqs.data(), stats.data());
+        }
+        Vector<std::size_t> recv_offset(pe.recv_from.size(), 0);
+        for (int i = 0; i < nmf; ++i) {
+            Vector<char*> data;
+            Vector<std::size_t> size;
+            Vector<const CopyComTagsContainer*> cctc;
+            for (int r = 0; r < static_cast<int>(pe.recv_from.size()); ++r) {
+                const std::size_t nbytes = pe.recv_size[pe.recv_from[r]][i];
+                if (nbytes == 0) continue;
+                data.push_back(pe.recv_buffer[r] + recv_offset[r]);
+                size.push_back(nbytes);
+                cctc.push_back(&cmd[i]->m_RcvTags->at(pe.recv_from[r]));
+                recv_offset[r] += nbytes;
+            }
+            if (data.empty()) continue;
+#ifdef AMREX_USE_GPU
+            if (Gpu::inLaunchRegion()) {
+                FabArray<FArrayBox>::unpack_recv_buffer_gpu(*dst[i], dcomp, ncomp[i], data, size, cctc,
+                                                            pe.op, cmd[i]->m_threadsafe_rcv);
+            } else
+#endif
+            {
+                FabArray<FArrayBox>::unpack_recv_buffer_cpu(*dst[i], dcomp, ncomp[i], data, size, cctc,
+                                                            pe.op, cmd[i]->m_threadsafe_rcv);
+            }
+        }
+        Gpu::streamSynchronize();
+
+        if (!pe.send_reqs.empty()) {
+            Vector<MPI_Status> stats(pe.send_reqs.size());
+            MPI_Waitall(static_cast<int>(pe.send_reqs.size()), pe.send_reqs.data(), stats.data());
+        }
+        for (auto buffer : pe.recv_buffer) The_Comms_Arena()->free(buffer);
+        for (auto buffer : pe.send_buffer) The_Comms_Arena()->free(buffer);
+#endif
+        pe = WarpXCommUtil::PendingExchange{};
+    }
+
+    /** \brief Copies (or adds) the data of src[i] into dst[i], for all i, following
+     * the communication patterns cmd[i] (as computed by getFB or getCPC),
+     * with one message per neighbor rank in total.
+     */
+    void FusedParallelCopy (amrex::Vector<amrex::MultiFab*> const& dst,
+                            amrex::Vector<amrex::MultiFab const*> const& src,
+                            amrex::Vector<CommMetaData const*> const& cmd,
+                            int scomp, int dcomp, amrex::Vector<int> const& ncomp,
+                            amrex::FabArrayBase::CpOp op)
+    {
+        WarpXCommUtil::PendingExchange pe;
+        pe.dst = dst;
+        pe.src = src;
+        pe.cmd = cmd;
+        pe.ncomp = ncomp;
+        pe.scomp = scomp;
+        pe.dcomp = dcomp;
+        pe.op = op;
+        FusedParallelCopy_nowait(pe);
+        FusedParallelCopy_finish(pe);
+    }
+}
+
 namespace WarpXCommUtil {
 
 void ParallelCopy (amrex::MultiFab&            dst,
@@ -134,9 +458,41 @@ void FillBoundary (amrex::iMultiFab&         imf,
 void
 FillBoundary (amrex::Vector<amrex::MultiFab*> const& mf, const amrex::Periodicity& period)
 {
+    amrex::Vector<amrex::IntVect> ng;
     for (auto x : mf) {
-        WarpXCommUtil::FillBoundary(*x, period);
+        ng.push_back(x->nGrowVect());
     }
+    WarpXCommUtil::FillBoundary(mf, ng, period);
+}
+
+void
+FillBoundary (amrex::Vector<amrex::MultiFab*> const& mf,
+              amrex::Vector<amrex::IntVect> const& ng,
+              const amrex::Periodicity& period)
+{
+    BL_PROFILE("WarpXCommUtil::FillBoundary(Vector)");
+
+    if (!WarpX::do_fused_comms || WarpX::do_single_precision_comms)
+    {
+        for (int i = 0; i < static_cast<int>(mf.size()); ++i) {
+            WarpXCommUtil::FillBoundary(*mf[i], ng[i], period);
+        }
+        return;
+    }
+
+    amrex::Vector<amrex::MultiFab*> dst;
+    amrex::Vector<amrex::MultiFab const*> src;
+    amrex::Vector<CommMetaData const*> cmd;
+    amrex::Vector<int> ncomp;
+    for (int i = 0; i < static_cast<int>(mf.size()); ++i) {
+        // Same as FabArray::FillBoundary: nothing to do without guard cells
+        if (ng[i].max() == 0) continue;
+        dst.push_back(mf[i]);
+        src.push_back(mf[i]);
+        cmd.push_back(&mf[i]->getFB(ng[i], period));
+        ncomp.push_back(mf[i]->nComp());
+    }
+    FusedParallelCopy(dst, src, cmd, 0, 0, ncomp, amrex::FabArrayBase::COPY);
 }
 
 void SumBoundary (amrex::MultiFab& mf, const amrex::Periodicity& period)
@@ -215,6 +571,98 @@ void SumBoundary (amrex::MultiFab&          mf,
     }
 }
 
+void SumBoundary (amrex::Vector<amrex::MultiFab*> const& mf,
+                  int                                    start_comp,
+                  int                                    num_comps,
+                  amrex::Vector<amrex::IntVect> const&   src_ng,
+                  amrex::Vector<amrex::IntVect> const&   dst_ng,
+                  const amrex::Periodicity&              period)
+{
+    BL_PROFILE("WarpXCommUtil::SumBoundary(Vector)");
+
+    PendingExchange pe;
+    WarpXCommUtil::SumBoundary_nowait(pe, mf, start_comp, num_comps, src_ng, dst_ng, period);
+    WarpXCommUtil::SumBoundary_finish(pe);
+}
+
+void SumBoundary_nowait (PendingExchange&                       pe,
+                         amrex::Vector<amrex::MultiFab*> const& mf,
+                         int                                    start_comp,
+                         int                                    num_comps,
+                         amrex::Vector<amrex::IntVect> const&   src_ng,
+                         amrex::Vector<amrex::IntVect> const&   dst_ng,
+                         const amrex::Periodicity&              period)
+{
+    BL_PROFILE("WarpXCommUtil::SumBoundary_nowait");
+
+    AMREX_ALWAYS_ASSERT(!pe.active);
+
+    if (!WarpX::do_fused_comms || WarpX::do_single_precision_comms)
+    {
+        // The sum is done here, there is nothing left for SumBoundary_finish
+        for (int i = 0; i < static_cast<int>(mf.size()); ++i) {
+            WarpXCommUtil::SumBoundary(*mf[i], start_comp, num_comps, src_ng[i], dst_ng[i], period);
+        }
+        pe.active = true;
+        return;
+    }
+
+    // Same as FabArray::SumBoundary: the data of a copy of each MultiFab (with its
+    // guard cells) is added to the MultiFab, after zeroing the cells to update
+    for (int i = 0; i < static_cast<int>(mf.size()); ++i) {
+        if (mf[i]->nGrowVect() == amrex::IntVect::TheZeroVector() &&
+            mf[i]->ixType().cellCentered()) continue;
+        pe.tmp.push_back(std::make_unique<amrex::MultiFab>(mf[i]->boxArray(), mf[i]->DistributionMap(),
+                                                           num_comps, src_ng[i], amrex::MFInfo(),
+                                                           mf[i]->Factory()));
+        amrex::MultiFab::Copy(*pe.tmp.back(), *mf[i], start_comp, 0, num_comps, src_ng[i]);
+        mf[i]->setVal(0., start_comp, num_comps, dst_ng[i]);
+        pe.dst.push_back(mf[i]);
+        pe.src.push_back(pe.tmp.back().get());
+        pe.cmd.push_back(&mf[i]->getCPC(dst_ng[i], *pe.tmp.back(), src_ng[i], period));
+    }
+    pe.scomp = 0;
+    pe.dcomp = start_comp;
+    pe.ncomp.assign(pe.dst.size(), num_comps);
+    pe.op = amrex::FabArrayBase::ADD;
+    FusedParallelCopy_nowait(pe);
+}
+
+void SumBoundary_finish (PendingExchange& pe)
+{
+    BL_PROFILE("WarpXCommUtil::SumBoundary_finish");
+
+    FusedParallelCopy_finish(pe);
+}
+
+void ParallelAdd (amrex::Vector<amrex::MultiFab*> const&       dst,
+                  amrex::Vector<amrex::MultiFab const*> const& src,
+                  int                                          src_comp,
+                  int                                          dst_comp,
+                  int                                          num_comp,
+                  amrex::Vector<amrex::IntVect> const&         src_nghost,
+                  amrex::Vector<amrex::IntVect> const&         dst_nghost,
+                  const amrex::Periodicity&                    period)
+{
+    BL_PROFILE("WarpXCommUtil::ParallelAdd(Vector)");
+
+    if (!WarpX::do_fused_comms || WarpX::do_single_precision_comms)
+    {
+        for (int i = 0; i < static_cast<int>(dst.size()); ++i) {
+            WarpXCommUtil::ParallelAdd(*dst[i], *src[i], src_comp, dst_comp, num_comp,
+                                       src_nghost[i], dst_nghost[i], period);
+        }
+        return;
+    }
+
+    amrex::Vector<CommMetaData const*> cmd;
+    for (int i = 0; i < static_cast<int>(dst.size()); ++i) {
+        cmd.push_back(&dst[i]->getCPC(dst_nghost[i], *src[i], src_nghost[i], period));
+    }
+    FusedParallelCopy(dst, src, cmd, src_comp, dst_comp, amrex::Vector<int>(dst.size(), num_comp),
+                      amrex::FabArrayBase::ADD);
+}
+
 void OverrideSync (amrex::MultiFab&          mf,
                    const amrex::Periodicity& period)
 {
@@ -8,11 +8,13 @@
  */
 #include "WarpX.H"
 
+#include "BoundaryConditions/PML.H"
 #include "Diagnostics/MultiDiagnostics.H"
 #include "Diagnostics/ReducedDiags/MultiReducedDiags.H"
 #include "Particles/MultiParticleContainer.H"
 #include "Particles/ParticleBoundaryBuffer.H"
 #include "Particles/WarpXParticleContainer.H"
+#include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXProfilerWrapper.H"
 
@@ -33,6 +35,7 @@
 #include <AMReX_ParallelContext.H>
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_REAL.H>
+#include <AMReX_Utility.H>
 #include <AMReX_Vector.H>
 #include <AMReX_iMultiFab.H>
 
@@ -41,11 +44,48 @@
 #include <cmath>
 #include <cstddef>
 #include <memory>
+#include <sstream>
 #include <utility>
 #include <vector>
 
 using namespace amrex;
 
+namespace
+{
+    /** Relative weight of the initial weights of the calibrated cost model in its fit,
+     * which keeps the fit well-posed with few boxes or with correlated features */
+    constexpr Real costs_model_regularization = 0.1;
+
+    /** Solves the n-by-n linear system A x = b (A is stored row by row) by Gaussian
+     * elimination with partial pivoting. The solution is returned in b.
+     * Returns false if A is singular. */
+    bool SolveLinearSystem (Vector<Real> A, Vector<Real>& b, const int n)
+    {
+        for (int k = 0; k < n; ++k)
+        {
+            int pivot = k;
+            for (int i = k+1; i < n; ++i) {
+                if (std::abs(A[i*n+k]) > std::abs(A[pivot*n+k])) pivot = i;
+            }
+            if (A[pivot*n+k] == 0.0) return false;
+            if (pivot != k) {
+                for (int j = 0; j < n; ++j) std::swap(A[k*n+j], A[pivot*n+j]);
+                std::swap(b[k], b[pivot]);
+            }
+            for (int i = k+1; i < n; ++i) {
+                const Real f = A[i*n+k]/A[k*n+k];
+                for (int j = k; j < n; ++j) A[i*n+j] -= f*A[k*n+j];
+                b[i] -= f*b[k];
+            }
+        }
+        for (int k = n-1; k >= 0; --k) {
+            for (int j = k+1; j < n; ++j) b[k] -= A[k*n+j]*b[j];
+            b[k] /= A[k*n+k];
+        }
+        return true;
+    }
+}
+
 void
 WarpX::LoadBalance ()
 {
@@ -60,16 +100,58 @@ WarpX::LoadBalance ()
         // compute the costs on a per-rank basis
         ComputeCostsHeuristic(costs);
     }
+    else if (load_balance_costs_calibrated)
+    {
+        if (load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        {
+            // the timer-based costs of the last interval are used for this
+            // load balancing step, and to calibrate the cost model
+            CalibrateCostsModel(std::max(istep[0] - load_balance_last_step, 1));
+        } else
+        {
+            ComputeCostsCalibrated(costs);
+        }
+    }
 
     // By default, do not do a redistribute; this toggles to true if RemakeLevel
     // is called for any level
     int loadBalancedAnyLevel = false;
 
+    // Predictive load balancing: wall time of the last interval, which is compared
+    // to the wall time of the last redistribution to decide whether to rebalance
+    const int step = istep[0];
+    const amrex::Real walltime = amrex::second();
+    const amrex::Real interval_walltime = (load_balance_last_walltime > 0)
+        ? walltime - load_balance_last_walltime : -1;
+    const amrex::Real next_interval_ratio = (step > load_balance_last_step)
+        ? amrex::Real(load_balance_intervals.localPeriod(step+1))/(step - load_balance_last_step) : 1;
+    amrex::Real remake_walltime = 0;
+
     const int nLevels = finestLevel();
     for (int lev = 0; lev <= nLevels; ++lev)
     {
         int doLoadBalance = false;
 
+        // Costs used to compute the new distribution mapping: costs of the last
+        // interval, or costs extrapolated to the next interval (predictive load balancing)
+        LayoutData<Real> predicted_costs;
+        if (load_balance_predictive)
+        {
+            // Efficiency that was expected and that was measured over the last interval
+            load_balance_efficiency_expected[lev] = load_balance_efficiency_predicted[lev];
+            Real local_cost = 0.0;
+            for (int i : costs[lev]->IndexArray()) local_cost += (*costs[lev])[i];
+            Real max_cost = local_cost;
+            ParallelDescriptor::ReduceRealSum(local_cost);
+            ParallelDescriptor::ReduceRealMax(max_cost);
+            load_balance_efficiency_actual[lev] = (max_cost > 0.0)
+                ? local_cost/(ParallelContext::NProcsSub()*max_cost) : -1;
+
+            predicted_costs.define(costs[lev]->boxArray(), costs[lev]->DistributionMap());
+            PredictCosts(lev, step, predicted_costs);
+        }
+        const LayoutData<Real>& lb_costs = (load_balance_predictive) ? predicted_costs : *costs[lev];
+
         // Compute the new distribution mapping
         DistributionMapping newdm;
         const amrex::Real nboxes = costs[lev]->size();
@@ -81,11 +163,11 @@ WarpX::LoadBalance ()
         amrex::Real proposedEfficiency = 0.0;
 
         newdm = (load_balance_with_sfc)
-            ? DistributionMapping::makeSFC(*costs[lev],
+            ? DistributionMapping::makeSFC(lb_costs,
                                            currentEfficiency, proposedEfficiency,
                                            false,
                                            ParallelDescriptor::IOProcessorNumber())
-            : DistributionMapping::makeKnapSack(*costs[lev],
+            : DistributionMapping::makeKnapSack(lb_costs,
                                                 currentEfficiency, proposedEfficiency,
                                                 nmax,
                                                 false,
@@ -97,6 +179,18 @@ WarpX::LoadBalance ()
             && (ParallelDescriptor::MyProc() == ParallelDescriptor::IOProcessorNumber()))
         {
             doLoadBalance = (proposedEfficiency > load_balance_efficiency_ratio_threshold*currentEfficiency);
+
+            // Predictive load balancing: the time of a step is proportional to the maximum
+            // cost over all ranks, i.e. inversely proportional to the efficiency. Rebalance
+            // only if the expected gain over the next interval exceeds the measured time
+            // of the last redistribution (unknown until the first redistribution)
+            if (doLoadBalance && load_balance_predictive && interval_walltime > 0
+                && proposedEfficiency > 0)
+            {
+                const amrex::Real expected_gain = interval_walltime * next_interval_ratio
+                    * (1._rt - currentEfficiency/proposedEfficiency);
+                doLoadBalance = (expected_gain > load_balance_remake_walltime);
+            }
         }
 
         ParallelDescriptor::Bcast(&doLoadBalance, 1,
@@ -119,30 +213,127 @@ WarpX::LoadBalance ()
                 newdm = DistributionMapping(pmap);
             }
 
+            const amrex::Real remake_start = amrex::second();
             RemakeLevel(lev, t_new[lev], boxArray(lev), newdm);
+            remake_walltime += amrex::second() - remake_start;
 
             // Record the load balance efficiency
             setLoadBalanceEfficiency(lev, proposedEfficiency);
         }
 
+        if (load_balance_predictive)
+        {
+            // Efficiency expected over the next interval, with the predicted costs
+            // (only the root rank knows the efficiencies computed by makeSFC/makeKnapSack)
+            amrex::Real predictedEfficiency = (doLoadBalance) ? proposedEfficiency : currentEfficiency;
+            ParallelDescriptor::Bcast(&predictedEfficiency, 1, ParallelDescriptor::IOProcessorNumber());
+            load_balance_efficiency_predicted[lev] = predictedEfficiency;
+        }
+
         loadBalancedAnyLevel = loadBalancedAnyLevel || doLoadBalance;
     }
     if (loadBalancedAnyLevel)
     {
+        const amrex::Real redistribute_start = amrex::second();
         mypc->Redistribute();
         mypc->defineAllParticleTiles();
 
         // redistribute particle boundary buffer
         m_particle_boundary_buffer->redistribute();
+        remake_walltime += amrex::second() - redistribute_start;
+
+        // Measured time of the redistribution (maximum over all ranks)
+        ParallelDescriptor::ReduceRealMax(remake_walltime);
+        load_balance_remake_walltime = remake_walltime;
 
         // diagnostics & reduced diagnostics
         // not yet needed:
         //multi_diags->LoadBalance();
         reduced_diags->LoadBalance();
     }
+
+    load_balance_last_step = step;
+    load_balance_last_walltime = amrex::second();
+
+    if (load_balance_costs_calibrated)
+    {
+        // Activate the timers over the next interval only if the cost model
+        // is calibrated again at the end of this interval
+        const int next_load_balance = load_balance_intervals.nextContains(step+1);
+        load_balance_costs_update_algo = (costs_calibration_intervals.contains(next_load_balance))
+            ? LoadBalanceCostsUpdateAlgo::Timers : LoadBalanceCostsUpdateAlgo::Calibrated;
+    }
 #endif
 }
 
+void
+WarpX::PredictCosts (const int lev, const int step, LayoutData<Real>& predicted_costs)
+{
+    // Timer-based costs are accumulated over the interval: normalize them by
+    // the number of steps, and assign them to the middle of the interval.
+    // Heuristic and calibrated costs are computed at the current step.
+    const bool heuristic = (load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Heuristic
+                            || load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Calibrated);
+    const int nsteps = std::max(step - load_balance_last_step, 1);
+    const Real norm = (heuristic) ? 1._rt : 1._rt/nsteps;
+    const Real sample_step = (heuristic) ? step : step - 0.5_rt*nsteps;
+
+    // Record the costs of the last interval, and discard the oldest ones
+    auto& history = costs_history[lev];
+    auto& history_steps = costs_history_steps[lev];
+    auto sample = std::make_unique<LayoutData<Real>>(costs[lev]->boxArray(),
+                                                     costs[lev]->DistributionMap());
+    for (int i : costs[lev]->IndexArray()) (*sample)[i] = norm*(*costs[lev])[i];
+    history.push_back(std::move(sample));
+    history_steps.push_back(sample_step);
+    while (static_cast<int>(history.size()) > load_balance_history_length) {
+        history.erase(history.begin());
+        history_steps.erase(history_steps.begin());
+    }
+
+    // Linear least-squares fit of the cost history of each box,
+    // evaluated at the middle of the next interval
+    const Real target_step = step + 0.5_rt*load_balance_intervals.localPeriod(step+1);
+    const int nsamples = static_cast<int>(history.size());
+    Real mean_step = 0.0;
+    for (const Real s : history_steps) mean_step += s/nsamples;
+    Real var_step = 0.0;
+    for (const Real s : history_steps) var_step += (s - mean_step)*(s - mean_step);
+
+    for (int i : predicted_costs.IndexArray())
+    {
+        Real mean_cost = 0.0;
+        for (const auto& h : history) mean_cost += (*h)[i]/nsamples;
+        Real slope = 0.0;
+        if (var_step > 0.0)
+        {
+            for (int n = 0; n < nsamples; ++n) {
+                slope += (history_steps[n] - mean_step)*((*history[n])[i] - mean_cost);
+            }
+            slope /= var_step;
+        }
+        // Costs cannot be negative
+        predicted_costs[i] = std::max(mean_cost + slope*(target_step - mean_step), 0._rt);
+    }
+}
+
+void
+WarpX::RemapCostsHistory (const int lev, const DistributionMapping& dm)
+{
+    for (auto& h : costs_history[lev])
+    {
+        // Gather the costs of all the boxes, and keep those owned by the local rank in dm
+        const int nboxes = h->size();
+        Vector<Real> all_costs(nboxes, 0.0);
+        for (int i : h->IndexArray()) all_costs[i] = (*h)[i];
+        ParallelDescriptor::ReduceRealSum(all_costs.data(), nboxes);
+
+        auto remapped = std::make_unique<LayoutData<Real>>(h->boxArray(), dm);
+        for (int i : remapped->IndexArray()) (*remapped)[i] = all_costs[i];
+        h = std::move(remapped);
+    }
+}
+
 
 template <typename MultiFabType> void
 RemakeMultiFab (std::unique_ptr<MultiFabType>& mf, const DistributionMapping& dm,
@@ -158,6 +349,12 @@ RemakeMultiFab (std::unique_ptr<MultiFabType>& mf, const DistributionMapping& dm
 void
 WarpX::RemakeLevel (int lev, Real /*time*/, const BoxArray& ba, const DistributionMapping& dm)
 {
+    // The scratch MultiFabs of the filter are defined on the previous grids
+    bilinear_filter.ClearScratch();
+    // The guard cells of E and B are exchanged again before the next field gather
+    // (warpx.fdtd_temporal_blocking)
+    m_fdtd_blocking_substeps = -1;
+
     if (ba == boxArray(lev))
     {
         if (ParallelDescriptor::NProcs() == 1) return;
@@ -226,7 +423,7 @@ WarpX::RemakeLevel (int lev, Real /*time*/, const BoxArray& ba, const Distributi
                                            dm,
                                            dx);
 #   else
-                if ( fft_periodic_single_box == false ) {
+                if ( fft_periodic_single_box == false && fft_distributed == false ) {
                     realspace_ba.grow(ngEB);   // add guard cells
                 }
                 bool const pml_flag_false = false;
@@ -318,6 +515,8 @@ WarpX::RemakeLevel (int lev, Real /*time*/, const BoxArray& ba, const Distributi
                 BuildBufferMasks();
         }
 
+        RemapCostsHistory(lev, dm);
+
         if (costs[lev] != nullptr)
         {
             costs[lev] = std::make_unique<LayoutData<Real>>(ba, dm);
@@ -373,6 +572,162 @@ WarpX::ComputeCostsHeuristic (amrex::Vector<std::unique_ptr<amrex::LayoutData<am
     }
 }
 
+void
+WarpX::InitCostsModel ()
+{
+    const auto & mypc_ref = GetInstance().GetPartContainer();
+    const auto nSpecies = mypc_ref.nSpecies();
+
+    // Initial weights: heuristic weights for cells and particles. PML cells
+    // carry split fields and are counted twice. The work per particle grows with
+    // the particle shape (on GPU, the heuristic weights already account for it),
+    // and with the QED processes, ionization and collisions of its species.
+    costs_model_wt.resize(2 + nSpecies);
+    costs_model_wt[0] = costs_heuristic_cells_wt;
+    costs_model_wt[1] = 2._rt*costs_heuristic_cells_wt;
+#ifdef AMREX_USE_GPU
+    const Real shape_factor = 1._rt;
+#else
+    const Real shape_factor = static_cast<Real>(std::pow(0.5_rt*(nox + 1), AMREX_SPACEDIM));
+#endif
+    for (int i_s = 0; i_s < nSpecies; ++i_s)
+    {
+        auto & myspc = mypc_ref.GetParticleContainer(i_s);
+        const int nprocesses = myspc.DoQED() + (myspc.DoFieldIonization() ? 1 : 0)
+            + (mypc_ref.SpeciesHasCollisions(i_s) ? 1 : 0);
+        costs_model_wt[2 + i_s] = costs_heuristic_particles_wt*shape_factor*(1 + nprocesses);
+    }
+}
+
+LayoutData<Vector<Real> >
+WarpX::CostsModelFeatures (int lev)
+{
+    const auto & mypc_ref = GetInstance().GetPartContainer();
+    const auto nSpecies = mypc_ref.nSpecies();
+    const int nfeatures = 2 + nSpecies;
+
+    const MultiFab* Ex = Efield_fp[lev][0].get();
+    LayoutData<Vector<Real> > features(Ex->boxArray(), Ex->DistributionMap());
+    for (int i : features.IndexArray()) features[i].resize(nfeatures, 0.0);
+
+    // Cells, including guard cells (as in the heuristic costs)
+    for (MFIter mfi(*Ex, false); mfi.isValid(); ++mfi)
+    {
+        features[mfi.index()][0] = static_cast<Real>(mfi.growntilebox().numPts());
+    }
+
+    // PML cells within pml_ncell cells of each box
+    if (do_pml && pml[lev])
+    {
+        const BoxArray pml_ba = amrex::convert(pml[lev]->GetE_fp()[0]->boxArray(),
+                                               IntVect::TheCellVector());
+        const BoxArray& ba = boxArray(lev);
+        for (int i : features.IndexArray())
+        {
+            Real npml = 0.0;
+            for (auto const& isect : pml_ba.intersections(amrex::grow(ba[i], pml_ncell))) {
+                npml += static_cast<Real>(isect.second.numPts());
+            }
+            features[i][1] = npml;
+        }
+    }
+
+    // Particles of each species
+    for (int i_s = 0; i_s < nSpecies; ++i_s)
+    {
+        auto & myspc = mypc_ref.GetParticleContainer(i_s);
+        for (WarpXParIter pti(myspc, lev); pti.isValid(); ++pti)
+        {
+            features[pti.index()][2 + i_s] += static_cast<Real>(pti.numParticles());
+        }
+    }
+
+    return features;
+}
+
+void
+WarpX::ComputeCostsCalibrated (amrex::Vector<std::unique_ptr<amrex::LayoutData<amrex::Real> > >& a_costs)
+{
+    if (costs_model_wt.empty()) InitCostsModel();
+
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        const auto features = CostsModelFeatures(lev);
+        for (int i : features.IndexArray())
+        {
+            Real cost = 0.0;
+            for (int f = 0; f < static_cast<int>(costs_model_wt.size()); ++f) {
+                cost += costs_model_wt[f]*features[i][f];
+            }
+            (*a_costs[lev])[i] = cost;
+        }
+    }
+}
+
+void
+WarpX::CalibrateCostsModel (const int nsteps)
+{
+    if (costs_model_wt.empty()) InitCostsModel();
+    const int nfeatures = costs_model_wt.size();
+
+    // Normal equations of the least-squares fit of the timer-based costs (per step)
+    // of all the boxes on all the levels: A = X^T X and b = X^T y
+    Vector<Real> A(nfeatures*nfeatures, 0.0);
+    Vector<Real> b(nfeatures, 0.0);
+    Real sum_costs = 0.0;
+    Real sum_model = 0.0;
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        const auto features = CostsModelFeatures(lev);
+        for (int i : features.IndexArray())
+        {
+            const auto& x = features[i];
+            const Real y = (*costs[lev])[i]/nsteps;
+            for (int f = 0; f < nfeatures; ++f)
+            {
+                for (int g = 0; g < nfeatures; ++g) A[f*nfeatures+g] += x[f]*x[g];
+                b[f] += x[f]*y;
+                sum_model += costs_model_wt[f]*x[f];
+            }
+            sum_costs += y;
+        }
+    }
+    ParallelDescriptor::ReduceRealSum(A.data(), A.size());
+    ParallelDescriptor::ReduceRealSum(b.data(), b.size());
+    ParallelDescriptor::ReduceRealSum(sum_costs);
+    ParallelDescriptor::ReduceRealSum(sum_model);
+    if (sum_costs <= 0.0 || sum_model <= 0.0) return;
+
+    // Regularize towards the current weights, rescaled to the units of the timers.
+    // Features that are zero in all boxes (e.g. no PML) keep their current weight.
+    const Real scale = sum_costs/sum_model;
+    Vector<Real> wt(nfeatures);
+    for (int f = 0; f < nfeatures; ++f)
+    {
+        const Real diag = A[f*nfeatures+f];
+        if (diag > 0.0)
+        {
+            A[f*nfeatures+f] += costs_model_regularization*diag;
+            b[f] += costs_model_regularization*diag*scale*costs_model_wt[f];
+        } else
+        {
+            A[f*nfeatures+f] = 1.0;
+            b[f] = scale*costs_model_wt[f];
+        }
+    }
+    if (!SolveLinearSystem(A, b, nfeatures)) return;
+
+    // Negative weights are not physical
+    for (int f = 0; f < nfeatures; ++f) costs_model_wt[f] = std::max(b[f], 0._rt);
+
+    if (verbose) {
+        std::stringstream ss;
+        ss << "Calibrated cost model weights (cells, PML cells, particles of each species):";
+        for (const Real w : costs_model_wt) ss << " " << w;
+        amrex::Print() << Utils::TextMsg::Info(ss.str());
+    }
+}
+
 void
 WarpX::ResetCosts ()
 {
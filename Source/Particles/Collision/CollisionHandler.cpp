@@ -82,3 +82,13 @@ void CollisionHandler::doCollisions ( amrex::Real cur_time, amrex::Real dt, Mult
     }
 
 }
+
+bool CollisionHandler::isSpeciesColliding (const std::string& species_name) const
+{
+    for (auto const& collision : allcollisions) {
+        for (auto const& name : collision->get_species_names()) {
+            if (name == species_name) return true;
+        }
+    }
+    return false;
+}
@@ -6,6 +6,8 @@
  */
 #include "BreitWheelerEngineWrapper.H"
 
+#include "Utils/WarpXUtil.H"
+
 #include <AMReX.H>
 #include <AMReX_BLassert.H>
 #include <AMReX_GpuDevice.H>
@@ -142,10 +144,58 @@ void BreitWheelerEngine::compute_lookup_tables (
     const amrex::Real bw_minimum_chi_phot)
 {
 #ifdef WARPX_QED_TABLE_GEN
+    namespace pxr_bw = picsar::multi_physics::phys::breit_wheeler;
+    // The tables are computed in double precision, as in PICSAR
+    using RealTypeGen = double;
+
+    // Both tables are distributed by blocks of rows over all the MPI ranks:
+    // each rank computes its own rows, which are then gathered on all the ranks.
+
+    // dN/dt table: one value per row
     m_dndt_table = BW_dndt_table{ctrl.dndt_params};
-    m_dndt_table.generate(true); //Progress bar is displayed
+    {
+        const auto all_coords = m_dndt_table.get_all_coordinates();
+        const int nrows = static_cast<int>(all_coords.size());
+        auto all_vals = std::vector<amrex::Real>(all_coords.size());
+        const auto [first_row, nrows_local] = WarpXUtilMPI::GetRowBlock(nrows);
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+        for (int i = first_row; i < first_row + nrows_local; ++i){
+            all_vals[i] = static_cast<amrex::Real>(
+                pxr_bw::compute_T_function<RealTypeGen>(all_coords[i]));
+        }
+        WarpXUtilMPI::AllGatherRows(all_vals, 1);
+        m_dndt_table.set_all_vals(all_vals);
+    }
+
+    // pair production table: one row per chi_phot value, with frac_how_many values each
     m_pair_prod_table = BW_pair_prod_table{ctrl.pair_prod_params};
-    m_pair_prod_table.generate(true); //Progress bar is displayed
+    {
+        const auto all_coords = m_pair_prod_table.get_all_coordinates();
+        const int row_size = static_cast<int>(ctrl.pair_prod_params.frac_how_many);
+        const int nrows = static_cast<int>(ctrl.pair_prod_params.chi_phot_how_many);
+        auto all_vals = std::vector<amrex::Real>(all_coords.size());
+        const auto [first_row, nrows_local] = WarpXUtilMPI::GetRowBlock(nrows);
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+        for (int i = first_row; i < first_row + nrows_local; ++i){
+            const auto chi_phot = static_cast<RealTypeGen>(all_coords[i*row_size][0]);
+            auto chi_parts = std::vector<RealTypeGen>(row_size);
+            for (int j = 0; j < row_size; ++j){
+                chi_parts[j] = static_cast<RealTypeGen>(all_coords[i*row_size + j][1]);
+            }
+            const auto vals = pxr_bw::compute_cumulative_prob_opt<
+                RealTypeGen, std::vector<RealTypeGen>>(chi_phot, chi_parts);
+            for (int j = 0; j < row_size; ++j){
+                all_vals[i*row_size + j] = static_cast<amrex::Real>(vals[j]);
+            }
+        }
+        WarpXUtilMPI::AllGatherRows(all_vals, row_size);
+        m_pair_prod_table.set_all_vals(all_vals);
+    }
+
     m_bw_minimum_chi_phot = bw_minimum_chi_phot;
 
     amrex::Gpu::synchronize();
@@ -6,6 +6,8 @@
  */
 #include "QuantumSyncEngineWrapper.H"
 
+#include "Utils/WarpXUtil.H"
+
 #include <AMReX.H>
 #include <AMReX_BLassert.H>
 #include <AMReX_GpuDevice.H>
@@ -141,10 +143,58 @@ void QuantumSynchrotronEngine::compute_lookup_tables (
     const amrex::Real qs_minimum_chi_part)
 {
 #ifdef WARPX_QED_TABLE_GEN
+    namespace pxr_qs = picsar::multi_physics::phys::quantum_sync;
+    // The tables are computed in double precision, as in PICSAR
+    using RealTypeGen = double;
+
+    // Both tables are distributed by blocks of rows over all the MPI ranks:
+    // each rank computes its own rows, which are then gathered on all the ranks.
+
+    // dN/dt table: one value per row
     m_dndt_table = QS_dndt_table{ctrl.dndt_params};
-    m_dndt_table.generate(true); //Progress bar is displayed
+    {
+        const auto all_coords = m_dndt_table.get_all_coordinates();
+        const int nrows = static_cast<int>(all_coords.size());
+        auto all_vals = std::vector<amrex::Real>(all_coords.size());
+        const auto [first_row, nrows_local] = WarpXUtilMPI::GetRowBlock(nrows);
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+        for (int i = first_row; i < first_row + nrows_local; ++i){
+            all_vals[i] = static_cast<amrex::Real>(
+                pxr_qs::compute_G_function<RealTypeGen>(all_coords[i]));
+        }
+        WarpXUtilMPI::AllGatherRows(all_vals, 1);
+        m_dndt_table.set_all_vals(all_vals);
+    }
+
+    // photon emission table: one row per chi_part value, with frac_how_many values each
     m_phot_em_table = QS_phot_em_table{ctrl.phot_em_params};
-    m_phot_em_table.generate(true); //Progress bar is displayed
+    {
+        const auto all_coords = m_phot_em_table.get_all_coordinates();
+        const int row_size = static_cast<int>(ctrl.phot_em_params.frac_how_many);
+        const int nrows = static_cast<int>(ctrl.phot_em_params.chi_part_how_many);
+        auto all_vals = std::vector<amrex::Real>(all_coords.size());
+        const auto [first_row, nrows_local] = WarpXUtilMPI::GetRowBlock(nrows);
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+        for (int i = first_row; i < first_row + nrows_local; ++i){
+            const auto chi_part = static_cast<RealTypeGen>(all_coords[i*row_size][0]);
+            auto chi_phots = std::vector<RealTypeGen>(row_size);
+            for (int j = 0; j < row_size; ++j){
+                chi_phots[j] = static_cast<RealTypeGen>(all_coords[i*row_size + j][1]);
+            }
+            const auto vals = pxr_qs::compute_cumulative_prob_opt<
+                RealTypeGen, std::vector<RealTypeGen>>(chi_part, chi_phots);
+            for (int j = 0; j < row_size; ++j){
+                all_vals[i*row_size + j] = static_cast<amrex::Real>(vals[j]);
+            }
+        }
+        WarpXUtilMPI::AllGatherRows(all_vals, row_size);
+        m_phot_em_table.set_all_vals(all_vals);
+    }
+
     m_qs_minimum_chi_part = qs_minimum_chi_part;
 
     amrex::Gpu::synchronize();
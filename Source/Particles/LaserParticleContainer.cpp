@@ -237,6 +237,9 @@ LaserParticleContainer::LaserParticleContainer (AmrCore* amr_core, int ispecies,
     common_params.e_max = m_e_max;
     common_params.p_X = m_p_X;
     common_params.nvec = m_nvec;
+    common_params.position = m_position;
+    common_params.u_X = m_u_X;
+    common_params.u_Y = m_u_Y;
     m_up_laser_profile->init(pp_laser_name, ParmParse{"my_constants"}, common_params);
 }
 
@@ -529,7 +532,10 @@ LaserParticleContainer::Evolve (int lev,
     }
 
     // Update laser profile
-    m_up_laser_profile->update(t);
+    // (only once per step, when the tiles are processed in two calls)
+    if (tile_selection != TileSelection::Interior) {
+        m_up_laser_profile->update(t);
+    }
 
     BL_ASSERT(OnSameGrids(lev,jx));
 
@@ -549,6 +555,8 @@ LaserParticleContainer::Evolve (int lev,
 
         for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
         {
+            if (!IsTileSelected(pti)) continue;
+
             if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
             {
                 amrex::Gpu::synchronize();
@@ -67,8 +67,12 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <iomanip>
 #include <limits>
 #include <map>
+#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -82,6 +86,83 @@ namespace
     {
         Array4< amrex::Real const > const Ex, Ey, Ez, Bx, By, Bz;
     };
+
+#ifdef WARPX_QED
+    /** Name of the file in which a QED lookup table is cached. The name contains a
+     * hash (64-bit FNV-1a) of the table parameters and of the floating point precision,
+     * so that tables generated with different parameters never share a file.
+     *
+     * @param[in] cache_dir directory of the cache
+     * @param[in] process name of the QED process ("qs" or "bw")
+     * @param[in] params parameters of the lookup tables
+     */
+    std::string
+    QEDTableCacheFileName (std::string const& cache_dir, std::string const& process,
+                           std::vector<double> const& params)
+    {
+        std::uint64_t hash = 14695981039346656037ull;
+        auto hash_bytes = [&hash] (const char* bytes, std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) {
+                hash ^= static_cast<unsigned char>(bytes[i]);
+                hash *= 1099511628211ull;
+            }
+        };
+        hash_bytes(process.data(), process.size());
+        const auto real_size = static_cast<int>(sizeof(amrex::Real));
+        hash_bytes(reinterpret_cast<const char*>(&real_size), sizeof(real_size));
+        for (const double param : params)
+            hash_bytes(reinterpret_cast<const char*>(&param), sizeof(param));
+
+        std::stringstream ss;
+        ss << cache_dir << "/" << process << "_table_"
+           << std::hex << std::setw(16) << std::setfill('0') << hash << ".bin";
+        return ss.str();
+    }
+
+    /** Reads a QED lookup table from the cache.
+     *
+     * @param[in] cache_file name of the file of the cache
+     * @return the table data on all the MPI ranks (empty if the table is not in the cache)
+     */
+    Vector<char>
+    ReadQEDTableFromCache (std::string const& cache_file)
+    {
+        int exists = 0;
+        if (ParallelDescriptor::IOProcessor())
+            exists = amrex::FileExists(cache_file);
+        ParallelDescriptor::Bcast(&exists, 1, ParallelDescriptor::IOProcessorNumber());
+
+        Vector<char> table_data;
+        if (exists)
+            ParallelDescriptor::ReadAndBcastFile(cache_file, table_data);
+        return table_data;
+    }
+
+    /** Writes a QED lookup table in the cache (I/O processor only). The table is first
+     * written in a temporary file, which is then renamed, so that concurrent runs
+     * never read a partially written table.
+     *
+     * @param[in] cache_file name of the file of the cache
+     * @param[in] table_data the table data
+     */
+    void
+    WriteQEDTableInCache (std::string const& cache_file, Vector<char> const& table_data)
+    {
+        if (!ParallelDescriptor::IOProcessor()) return;
+
+        const std::string cache_dir = cache_file.substr(0, cache_file.rfind('/'));
+        const std::string tmp_file = cache_file + "." + amrex::UniqueString();
+        if (!amrex::UtilCreateDirectory(cache_dir, 0755) ||
+            !WarpXUtilIO::WriteBinaryDataOnFile(tmp_file, table_data) ||
+            std::rename(tmp_file.c_str(), cache_file.c_str()) != 0)
+        {
+            std::remove(tmp_file.c_str());
+            WarpX::GetInstance().RecordWarning("QED",
+                "The QED lookup table could not be written in the cache: " + cache_file,
+                WarnPriority::low);
+        }
+    }
+#endif
 }
 
 MultiParticleContainer::MultiParticleContainer (AmrCore* amr_core)
@@ -112,6 +193,7 @@ MultiParticleContainer::MultiParticleContainer (AmrCore* amr_core)
     }
 
     pc_tmp = std::make_unique<PhysicalParticleContainer>(amr_core);
+    m_cell_bins.resize(allcontainers.size());
 
     // Compute the number of species for which lab-frame data is dumped
     // nspecies_lab_frame_diags, and map their ID to MultiParticleContainer
@@ -423,7 +505,10 @@ MultiParticleContainer::Evolve (int lev,
                                 const MultiFab* cBx, const MultiFab* cBy, const MultiFab* cBz,
                                 Real t, Real dt, DtType a_dt_type, bool skip_deposition)
 {
-    if (! skip_deposition) {
+    // When the tiles are processed in two calls (Boundary then Interior),
+    // the Interior call adds to the current and charge of the Boundary call
+    if (! skip_deposition &&
+        WarpXParticleContainer::tile_selection != WarpXParticleContainer::TileSelection::Interior) {
         jx.setVal(0.0);
         jy.setVal(0.0);
         jz.setVal(0.0);
@@ -433,6 +518,8 @@ MultiParticleContainer::Evolve (int lev,
         if (rho) rho->setVal(0.0);
         if (crho) crho->setVal(0.0);
     }
+    // The particle positions are modified below
+    InvalidateCellBins();
     for (auto& pc : allcontainers) {
         pc->Evolve(lev, Ex, Ey, Ez, Bx, By, Bz, jx, jy, jz, cjx, cjy, cjz,
                    rho, crho, cEx, cEy, cEz, cBx, cBy, cBz, t, dt, a_dt_type, skip_deposition);
@@ -442,6 +529,7 @@ MultiParticleContainer::Evolve (int lev,
 void
 MultiParticleContainer::PushX (Real dt)
 {
+    InvalidateCellBins();
     for (auto& pc : allcontainers) {
         pc->PushX(dt);
     }
@@ -561,6 +649,7 @@ MultiParticleContainer::GetChargeDensity (int lev, bool local)
 void
 MultiParticleContainer::SortParticlesByBin (amrex::IntVect bin_size)
 {
+    InvalidateCellBins();
     for (auto& pc : allcontainers) {
         pc->SortParticlesByBin(bin_size);
     }
@@ -569,6 +658,7 @@ MultiParticleContainer::SortParticlesByBin (amrex::IntVect bin_size)
 void
 MultiParticleContainer::Redistribute ()
 {
+    ClearCellBins();
     for (auto& pc : allcontainers) {
         pc->Redistribute();
     }
@@ -585,6 +675,7 @@ MultiParticleContainer::defineAllParticleTiles ()
 void
 MultiParticleContainer::RedistributeLocal (const int num_ghost)
 {
+    ClearCellBins();
     for (auto& pc : allcontainers) {
         pc->Redistribute(0, 0, 0, num_ghost);
     }
@@ -593,6 +684,7 @@ MultiParticleContainer::RedistributeLocal (const int num_ghost)
 void
 MultiParticleContainer::ApplyBoundaryConditions ()
 {
+    InvalidateCellBins();
     for (auto& pc : allcontainers) {
         pc->ApplyBoundaryConditions();
     }
@@ -641,6 +733,7 @@ MultiParticleContainer::Increment (MultiFab& mf, int lev)
 void
 MultiParticleContainer::SetParticleBoxArray (int lev, BoxArray& new_ba)
 {
+    ClearCellBins();
     for (auto& pc : allcontainers) {
         pc->SetParticleBoxArray(lev,new_ba);
     }
@@ -649,6 +742,7 @@ MultiParticleContainer::SetParticleBoxArray (int lev, BoxArray& new_ba)
 void
 MultiParticleContainer::SetParticleDistributionMap (int lev, DistributionMapping& new_dm)
 {
+    ClearCellBins();
     for (auto& pc : allcontainers) {
         pc->SetParticleDistributionMap(lev,new_dm);
     }
@@ -949,14 +1043,50 @@ MultiParticleContainer::doCollisions ( Real cur_time, amrex::Real dt )
     collisionhandler->doCollisions(cur_time, dt, this);
 }
 
+bool
+MultiParticleContainer::SpeciesHasCollisions (int i) const
+{
+    return collisionhandler->isSpeciesColliding(species_names[i]);
+}
+
+CellBinsCache::ParticleBins&
+MultiParticleContainer::GetCellBins (WarpXParticleContainer& pc, int lev, amrex::MFIter const& mfi)
+{
+    const auto it = std::find_if(allcontainers.begin(), allcontainers.end(),
+        [&pc](std::unique_ptr<WarpXParticleContainer> const& p) { return p.get() == &pc; });
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(it != allcontainers.end(),
+        "GetCellBins: the species is not part of this MultiParticleContainer");
+    const auto ispecies = static_cast<int>(std::distance(allcontainers.begin(), it));
+
+    return m_cell_bins[ispecies].getBins(lev, mfi, pc.ParticlesAt(lev, mfi));
+}
+
+void
+MultiParticleContainer::InvalidateCellBins ()
+{
+    for (auto& bins : m_cell_bins) {
+        bins.invalidate();
+    }
+}
+
+void
+MultiParticleContainer::ClearCellBins ()
+{
+    for (auto& bins : m_cell_bins) {
+        bins.clear();
+    }
+}
+
 void MultiParticleContainer::doResampling (const int timestep)
 {
-    for (auto& pc : allcontainers)
+    for (int i = 0; i < static_cast<int>(allcontainers.size()); ++i)
     {
+        auto& pc = allcontainers[i];
         // do_resampling can only be true for PhysicalParticleContainers
         if (!pc->do_resampling){ continue; }
 
-        pc->resample(timestep);
+        // The cached bins of the species are shared with the collision operators
+        pc->resample(timestep, m_cell_bins[i]);
     }
 }
 
@@ -1156,69 +1286,82 @@ MultiParticleContainer::QuantumSyncGenerateTable ()
     amrex::Real qs_minimum_chi_part;
     getWithParser(pp_qed_qs, "chi_min", qs_minimum_chi_part);
 
-    if(ParallelDescriptor::IOProcessor()){
-        PicsarQuantumSyncCtrl ctrl;
-
-        //==Table parameters==
-
-        //--- sub-table 1 (1D)
-        //These parameters are used to pre-compute a function
-        //which appears in the evolution of the optical depth
-
-        //Minimun chi for the table. If a lepton has chi < tab_dndt_chi_min,
-        //chi is considered as if it were equal to tab_dndt_chi_min
-        getWithParser(pp_qed_qs, "tab_dndt_chi_min", ctrl.dndt_params.chi_part_min);
-
-        //Maximum chi for the table. If a lepton has chi > tab_dndt_chi_max,
-        //chi is considered as if it were equal to tab_dndt_chi_max
-        getWithParser(pp_qed_qs, "tab_dndt_chi_max", ctrl.dndt_params.chi_part_max);
-
-        //How many points should be used for chi in the table
-        getWithParser(pp_qed_qs, "tab_dndt_how_many", ctrl.dndt_params.chi_part_how_many);
-        //------
-
-        //--- sub-table 2 (2D)
-        //These parameters are used to pre-compute a function
-        //which is used to extract the properties of the generated
-        //photons.
-
-        //Minimun chi for the table. If a lepton has chi < tab_em_chi_min,
-        //chi is considered as if it were equal to tab_em_chi_min
-        getWithParser(pp_qed_qs, "tab_em_chi_min", ctrl.phot_em_params.chi_part_min);
-
-        //Maximum chi for the table. If a lepton has chi > tab_em_chi_max,
-        //chi is considered as if it were equal to tab_em_chi_max
-        getWithParser(pp_qed_qs, "tab_em_chi_max", ctrl.phot_em_params.chi_part_max);
-
-        //How many points should be used for chi in the table
-        getWithParser(pp_qed_qs, "tab_em_chi_how_many", ctrl.phot_em_params.chi_part_how_many);
-
-        //The other axis of the table is the ratio between the quantum
-        //parameter of the emitted photon and the quantum parameter of the
-        //lepton. This parameter is the minimum ratio to consider for the table.
-        getWithParser(pp_qed_qs, "tab_em_frac_min", ctrl.phot_em_params.frac_min);
-
-        //This parameter is the number of different points to consider for the second
-        //axis
-        getWithParser(pp_qed_qs, "tab_em_frac_how_many", ctrl.phot_em_params.frac_how_many);
-        //====================
-
+    PicsarQuantumSyncCtrl ctrl;
+
+    //==Table parameters==
+
+    //--- sub-table 1 (1D)
+    //These parameters are used to pre-compute a function
+    //which appears in the evolution of the optical depth
+
+    //Minimun chi for the table. If a lepton has chi < tab_dndt_chi_min,
+    //chi is considered as if it were equal to tab_dndt_chi_min
+    getWithParser(pp_qed_qs, "tab_dndt_chi_min", ctrl.dndt_params.chi_part_min);
+
+    //Maximum chi for the table. If a lepton has chi > tab_dndt_chi_max,
+    //chi is considered as if it were equal to tab_dndt_chi_max
+    getWithParser(pp_qed_qs, "tab_dndt_chi_max", ctrl.dndt_params.chi_part_max);
+
+    //How many points should be used for chi in the table
+    getWithParser(pp_qed_qs, "tab_dndt_how_many", ctrl.dndt_params.chi_part_how_many);
+    //------
+
+    //--- sub-table 2 (2D)
+    //These parameters are used to pre-compute a function
+    //which is used to extract the properties of the generated
+    //photons.
+
+    //Minimun chi for the table. If a lepton has chi < tab_em_chi_min,
+    //chi is considered as if it were equal to tab_em_chi_min
+    getWithParser(pp_qed_qs, "tab_em_chi_min", ctrl.phot_em_params.chi_part_min);
+
+    //Maximum chi for the table. If a lepton has chi > tab_em_chi_max,
+    //chi is considered as if it were equal to tab_em_chi_max
+    getWithParser(pp_qed_qs, "tab_em_chi_max", ctrl.phot_em_params.chi_part_max);
+
+    //How many points should be used for chi in the table
+    getWithParser(pp_qed_qs, "tab_em_chi_how_many", ctrl.phot_em_params.chi_part_how_many);
+
+    //The other axis of the table is the ratio between the quantum
+    //parameter of the emitted photon and the quantum parameter of the
+    //lepton. This parameter is the minimum ratio to consider for the table.
+    getWithParser(pp_qed_qs, "tab_em_frac_min", ctrl.phot_em_params.frac_min);
+
+    //This parameter is the number of different points to consider for the second
+    //axis
+    getWithParser(pp_qed_qs, "tab_em_frac_how_many", ctrl.phot_em_params.frac_how_many);
+    //====================
+
+    // Lookup tables are cached on disk, in files keyed by the table parameters
+    std::string cache_dir;
+    pp_qed_qs.query("table_cache_dir", cache_dir);
+    std::string cache_file;
+    bool init_from_cache = false;
+    if(!cache_dir.empty()){
+        cache_file = QEDTableCacheFileName(cache_dir, "qs", {
+            ctrl.dndt_params.chi_part_min, ctrl.dndt_params.chi_part_max,
+            static_cast<double>(ctrl.dndt_params.chi_part_how_many),
+            ctrl.phot_em_params.chi_part_min, ctrl.phot_em_params.chi_part_max,
+            static_cast<double>(ctrl.phot_em_params.chi_part_how_many),
+            ctrl.phot_em_params.frac_min,
+            static_cast<double>(ctrl.phot_em_params.frac_how_many)});
+        const auto cached_data = ReadQEDTableFromCache(cache_file);
+        init_from_cache = !cached_data.empty() &&
+            m_shr_p_qs_engine->init_lookup_tables_from_raw_data(cached_data, qs_minimum_chi_part);
+    }
+
+    if(!init_from_cache){
+        // The rows of the tables are distributed over all the MPI ranks
         m_shr_p_qs_engine->compute_lookup_tables(ctrl, qs_minimum_chi_part);
-        const auto data = m_shr_p_qs_engine->export_lookup_tables_data();
-        WarpXUtilIO::WriteBinaryDataOnFile(table_name,
-            Vector<char>{data.begin(), data.end()});
     }
 
-    ParallelDescriptor::Barrier();
-    Vector<char> table_data;
-    ParallelDescriptor::ReadAndBcastFile(table_name, table_data);
-    ParallelDescriptor::Barrier();
-
-    //No need to initialize from raw data for the processor that
-    //has just generated the table
-    if(!ParallelDescriptor::IOProcessor()){
-        m_shr_p_qs_engine->init_lookup_tables_from_raw_data(
-            table_data, qs_minimum_chi_part);
+    const auto data = m_shr_p_qs_engine->export_lookup_tables_data();
+    const auto table_data = Vector<char>{data.begin(), data.end()};
+    if(ParallelDescriptor::IOProcessor()){
+        WarpXUtilIO::WriteBinaryDataOnFile(table_name, table_data);
+    }
+    if(!cache_dir.empty() && !init_from_cache){
+        WriteQEDTableInCache(cache_file, table_data);
     }
 }
 
@@ -1237,65 +1380,77 @@ MultiParticleContainer::BreitWheelerGenerateTable ()
     amrex::Real bw_minimum_chi_part;
     getWithParser(pp_qed_bw, "chi_min", bw_minimum_chi_part);
 
-    if(ParallelDescriptor::IOProcessor()){
-        PicsarBreitWheelerCtrl ctrl;
-
-        //==Table parameters==
-
-        //--- sub-table 1 (1D)
-        //These parameters are used to pre-compute a function
-        //which appears in the evolution of the optical depth
-
-        //Minimun chi for the table. If a photon has chi < tab_dndt_chi_min,
-        //an analytical approximation is used.
-        getWithParser(pp_qed_bw, "tab_dndt_chi_min", ctrl.dndt_params.chi_phot_min);
-
-        //Maximum chi for the table. If a photon has chi > tab_dndt_chi_max,
-        //an analytical approximation is used.
-        getWithParser(pp_qed_bw, "tab_dndt_chi_max", ctrl.dndt_params.chi_phot_max);
-
-        //How many points should be used for chi in the table
-        getWithParser(pp_qed_bw, "tab_dndt_how_many", ctrl.dndt_params.chi_phot_how_many);
-        //------
-
-        //--- sub-table 2 (2D)
-        //These parameters are used to pre-compute a function
-        //which is used to extract the properties of the generated
-        //particles.
-
-        //Minimun chi for the table. If a photon has chi < tab_pair_chi_min
-        //chi is considered as it were equal to chi_phot_tpair_min
-        getWithParser(pp_qed_bw, "tab_pair_chi_min", ctrl.pair_prod_params.chi_phot_min);
-
-        //Maximum chi for the table. If a photon has chi > tab_pair_chi_max
-        //chi is considered as it were equal to chi_phot_tpair_max
-        getWithParser(pp_qed_bw, "tab_pair_chi_max", ctrl.pair_prod_params.chi_phot_max);
-
-        //How many points should be used for chi in the table
-        getWithParser(pp_qed_bw, "tab_pair_chi_how_many", ctrl.pair_prod_params.chi_phot_how_many);
-
-        //The other axis of the table is the fraction of the initial energy
-        //'taken away' by the most energetic particle of the pair.
-        //This parameter is the number of different fractions to consider
-        getWithParser(pp_qed_bw, "tab_pair_frac_how_many", ctrl.pair_prod_params.frac_how_many);
-        //====================
-
+    PicsarBreitWheelerCtrl ctrl;
+
+    //==Table parameters==
+
+    //--- sub-table 1 (1D)
+    //These parameters are used to pre-compute a function
+    //which appears in the evolution of the optical depth
+
+    //Minimun chi for the table. If a photon has chi < tab_dndt_chi_min,
+    //an analytical approximation is used.
+    getWithParser(pp_qed_bw, "tab_dndt_chi_min", ctrl.dndt_params.chi_phot_min);
+
+    //Maximum chi for the table. If a photon has chi > tab_dndt_chi_max,
+    //an analytical approximation is used.
+    getWithParser(pp_qed_bw, "tab_dndt_chi_max", ctrl.dndt_params.chi_phot_max);
+
+    //How many points should be used for chi in the table
+    getWithParser(pp_qed_bw, "tab_dndt_how_many", ctrl.dndt_params.chi_phot_how_many);
+    //------
+
+    //--- sub-table 2 (2D)
+    //These parameters are used to pre-compute a function
+    //which is used to extract the properties of the generated
+    //particles.
+
+    //Minimun chi for the table. If a photon has chi < tab_pair_chi_min
+    //chi is considered as it were equal to chi_phot_tpair_min
+    getWithParser(pp_qed_bw, "tab_pair_chi_min", ctrl.pair_prod_params.chi_phot_min);
+
+    //Maximum chi for the table. If a photon has chi > tab_pair_chi_max
+    //chi is considered as it were equal to chi_phot_tpair_max
+    getWithParser(pp_qed_bw, "tab_pair_chi_max", ctrl.pair_prod_params.chi_phot_max);
+
+    //How many points should be used for chi in the table
+    getWithParser(pp_qed_bw, "tab_pair_chi_how_many", ctrl.pair_prod_params.chi_phot_how_many);
+
+    //The other axis of the table is the fraction of the initial energy
+    //'taken away' by the most energetic particle of the pair.
+    //This parameter is the number of different fractions to consider
+    getWithParser(pp_qed_bw, "tab_pair_frac_how_many", ctrl.pair_prod_params.frac_how_many);
+    //====================
+
+    // Lookup tables are cached on disk, in files keyed by the table parameters
+    std::string cache_dir;
+    pp_qed_bw.query("table_cache_dir", cache_dir);
+    std::string cache_file;
+    bool init_from_cache = false;
+    if(!cache_dir.empty()){
+        cache_file = QEDTableCacheFileName(cache_dir, "bw", {
+            ctrl.dndt_params.chi_phot_min, ctrl.dndt_params.chi_phot_max,
+            static_cast<double>(ctrl.dndt_params.chi_phot_how_many),
+            ctrl.pair_prod_params.chi_phot_min, ctrl.pair_prod_params.chi_phot_max,
+            static_cast<double>(ctrl.pair_prod_params.chi_phot_how_many),
+            static_cast<double>(ctrl.pair_prod_params.frac_how_many)});
+        const auto cached_data = ReadQEDTableFromCache(cache_file);
+        init_from_cache = !cached_data.empty() &&
+            m_shr_p_bw_engine->init_lookup_tables_from_raw_data(cached_data, bw_minimum_chi_part);
+    }
+
+    if(!init_from_cache){
+        // The rows of the tables are distributed over all the MPI ranks
         m_shr_p_bw_engine->compute_lookup_tables(ctrl, bw_minimum_chi_part);
-        const auto data = m_shr_p_bw_engine->export_lookup_tables_data();
-        WarpXUtilIO::WriteBinaryDataOnFile(table_name,
-            Vector<char>{data.begin(), data.end()});
     }
 
-    ParallelDescriptor::Barrier();
-    Vector<char> table_data;
-    ParallelDescriptor::ReadAndBcastFile(table_name, table_data);
-    ParallelDescriptor::Barrier();
-
-    //No need to initialize from raw data for the processor that
-    //has just generated the table
-    if(!ParallelDescriptor::IOProcessor()){
-        m_shr_p_bw_engine->init_lookup_tables_from_raw_data(
-            table_data, bw_minimum_chi_part);
+    const auto data = m_shr_p_bw_engine->export_lookup_tables_data();
+    const auto table_data = Vector<char>{data.begin(), data.end()};
+    if(ParallelDescriptor::IOProcessor()){
+        WarpXUtilIO::WriteBinaryDataOnFile(table_name, table_data);
+    }
+    if(!cache_dir.empty() && !init_from_cache){
+        WriteQEDTableInCache(cache_file, table_data);
     }
 }
 
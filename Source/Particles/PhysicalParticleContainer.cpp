@@ -15,10 +15,13 @@
 #include "Initialization/InjectorMomentum.H"
 #include "Initialization/InjectorPosition.H"
 #include "MultiParticleContainer.H"
+#include "Parallelization/KernelTimer.H"
 #ifdef WARPX_QED
 #   include "Particles/ElementaryProcess/QEDInternals/BreitWheelerEngineWrapper.H"
 #   include "Particles/ElementaryProcess/QEDInternals/QuantumSyncEngineWrapper.H"
 #endif
+#include "Particles/Deposition/ChargeDeposition.H"
+#include "Particles/Deposition/CurrentDeposition.H"
 #include "Particles/Gather/FieldGather.H"
 #include "Particles/Gather/GetExternalFields.H"
 #include "Particles/Pusher/CopyParticleAttribs.H"
@@ -75,6 +78,7 @@
 #include <AMReX_ParticleContainerBase.H>
 #include <AMReX_AmrParticles.H>
 #include <AMReX_ParticleTile.H>
+#include <AMReX_ParticleUtil.H>
 #include <AMReX_Print.H>
 #include <AMReX_Random.H>
 #include <AMReX_SPACE.H>
@@ -96,9 +100,11 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
 #include <limits>
 #include <map>
+#include <memory>
 #include <random>
 #include <string>
 #include <utility>
@@ -245,6 +251,7 @@ PhysicalParticleContainer::PhysicalParticleContainer (AmrCore* amr_core, int isp
     queryWithParser(pp_species_name, "self_fields_absolute_tolerance", self_fields_absolute_tolerance);
     queryWithParser(pp_species_name, "self_fields_max_iters", self_fields_max_iters);
     pp_species_name.query("self_fields_verbosity", self_fields_verbosity);
+    self_fields_solver = GetAlgorithmInteger(pp_species_name, "self_fields_solver");
     // Whether to plot back-transformed (lab-frame) diagnostics
     // for this species.
     pp_species_name.query("do_back_transformed_diagnostics", do_back_transformed_diagnostics);
@@ -521,94 +528,135 @@ PhysicalParticleContainer::AddPlasmaFromFile(ParticleReal q_tot,
     Gpu::HostVector<ParticleReal> particle_uy;
 
 #ifdef WARPX_USE_OPENPMD
-    //TODO: Make changes for read/write in multiple MPI ranks
-    if (ParallelDescriptor::IOProcessor()) {
-        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(plasma_injector,
-                                         "AddPlasmaFromFile: plasma injector not initialized.\n");
-        // take ownership of the series and close it when done
-        auto series = std::move(plasma_injector->m_openpmd_input_series);
-
-        // assumption asserts: see PlasmaInjector
-        openPMD::Iteration it = series->iterations.begin()->second;
-        std::string const ps_name = it.particles.begin()->first;
-        openPMD::ParticleSpecies ps = it.particles.begin()->second;
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(plasma_injector,
+                                     "AddPlasmaFromFile: plasma injector not initialized.\n");
+    // take ownership of the series and close it when done
+    auto series = std::move(plasma_injector->m_openpmd_input_series);
+
+    // assumption asserts: see PlasmaInjector
+    openPMD::Iteration it = series->iterations.begin()->second;
+    std::string const ps_name = it.particles.begin()->first;
+    openPMD::ParticleSpecies ps = it.particles.begin()->second;
+
+    auto const npart = ps["position"]["z"].getExtent()[0];
+
+    // Each MPI rank reads a contiguous slice of the particle records.
+    // The particles are then sent to the rank that owns them by AddNParticles.
+    auto const nprocs = static_cast<std::uint64_t>(ParallelDescriptor::NProcs());
+    auto const myproc = static_cast<std::uint64_t>(ParallelDescriptor::MyProc());
+    std::uint64_t const offset = (npart*myproc)/nprocs;
+    std::uint64_t const count = (npart*(myproc+1))/nprocs - offset;
+    auto load_slice = [offset, count] (openPMD::RecordComponent rc) {
+        return (count > 0) ? rc.loadChunk<ParticleReal>({offset}, {count})
+                           : std::shared_ptr<ParticleReal>{};
+    };
 
-        auto const npart = ps["position"]["x"].getExtent()[0];
 #if !defined(WARPX_DIM_1D_Z)
-        std::shared_ptr<ParticleReal> ptr_x = ps["position"]["x"].loadChunk<ParticleReal>();
-        double const position_unit_x = ps["position"]["x"].unitSI();
-#endif
-        std::shared_ptr<ParticleReal> ptr_z = ps["position"]["z"].loadChunk<ParticleReal>();
-        double const position_unit_z = ps["position"]["z"].unitSI();
-        std::shared_ptr<ParticleReal> ptr_ux = ps["momentum"]["x"].loadChunk<ParticleReal>();
-        double const momentum_unit_x = ps["momentum"]["x"].unitSI();
-        std::shared_ptr<ParticleReal> ptr_uz = ps["momentum"]["z"].loadChunk<ParticleReal>();
-        double const momentum_unit_z = ps["momentum"]["z"].unitSI();
+    std::shared_ptr<ParticleReal> ptr_x = load_slice(ps["position"]["x"]);
+    double const position_unit_x = ps["position"]["x"].unitSI();
+#endif
+    std::shared_ptr<ParticleReal> ptr_z = load_slice(ps["position"]["z"]);
+    double const position_unit_z = ps["position"]["z"].unitSI();
+    std::shared_ptr<ParticleReal> ptr_ux = load_slice(ps["momentum"]["x"]);
+    double const momentum_unit_x = ps["momentum"]["x"].unitSI();
+    std::shared_ptr<ParticleReal> ptr_uz = load_slice(ps["momentum"]["z"]);
+    double const momentum_unit_z = ps["momentum"]["z"].unitSI();
 #   if !(defined(WARPX_DIM_XZ) || defined(WARPX_DIM_1D_Z))
-        std::shared_ptr<ParticleReal> ptr_y = ps["position"]["y"].loadChunk<ParticleReal>();
-        double const position_unit_y = ps["position"]["y"].unitSI();
-#endif
-        std::shared_ptr<ParticleReal> ptr_uy = nullptr;
-        double momentum_unit_y = 1.0;
-        if (ps["momentum"].contains("y")) {
-            ptr_uy = ps["momentum"]["y"].loadChunk<ParticleReal>();
-             momentum_unit_y = ps["momentum"]["y"].unitSI();
-        }
-        series->flush();  // shared_ptr data can be read now
-
-        ParticleReal weight = 1.0_prt;  // base standard: no info means "real" particles
-        if (q_tot != 0.0) {
-            weight = std::abs(q_tot) / ( std::abs(charge) * ParticleReal(npart) );
-            if (ps.contains("weighting")) {
-                std::stringstream ss;
-                ss << "Both '" << ps_name << ".q_tot' and '"
-                        << ps_name << ".injection_file' specify a total charge.\n'"
-                        << ps_name << ".q_tot' will take precedence.";
-                WarpX::GetInstance().RecordWarning("Species", ss.str());
-            }
+    std::shared_ptr<ParticleReal> ptr_y = load_slice(ps["position"]["y"]);
+    double const position_unit_y = ps["position"]["y"].unitSI();
+#endif
+    bool const has_uy = ps["momentum"].contains("y");
+    std::shared_ptr<ParticleReal> ptr_uy = nullptr;
+    double momentum_unit_y = 1.0;
+    if (has_uy) {
+        ptr_uy = load_slice(ps["momentum"]["y"]);
+        momentum_unit_y = ps["momentum"]["y"].unitSI();
+    }
+    // ED-PIC extension: the weighting is a constant record, so only its first value is read
+    bool const read_weighting = (q_tot == 0.0) && ps.contains("weighting");
+    std::shared_ptr<ParticleReal> ptr_w = nullptr;
+    double w_unit = 1.0;
+    if (read_weighting) {
+        ptr_w = ps["weighting"][openPMD::RecordComponent::SCALAR].loadChunk<ParticleReal>({0}, {1});
+        w_unit = ps["weighting"][openPMD::RecordComponent::SCALAR].unitSI();
+    }
+    series->flush();  // shared_ptr data can be read now
+
+    ParticleReal weight = 1.0_prt;  // base standard: no info means "real" particles
+    if (q_tot != 0.0) {
+        weight = std::abs(q_tot) / ( std::abs(charge) * ParticleReal(npart) );
+        if (ps.contains("weighting") && ParallelDescriptor::IOProcessor()) {
+            std::stringstream ss;
+            ss << "Both '" << ps_name << ".q_tot' and '"
+                    << ps_name << ".injection_file' specify a total charge.\n'"
+                    << ps_name << ".q_tot' will take precedence.";
+            WarpX::GetInstance().RecordWarning("Species", ss.str());
         }
-        // ED-PIC extension?
-        else if (ps.contains("weighting")) {
-            // TODO: Add ASSERT_WITH_MESSAGE to test if weighting is a constant record
-            // TODO: Add ASSERT_WITH_MESSAGE for macroWeighted value in ED-PIC
-            ParticleReal w = ps["weighting"][openPMD::RecordComponent::SCALAR].loadChunk<ParticleReal>().get()[0];
-            double const w_unit = ps["weighting"][openPMD::RecordComponent::SCALAR].unitSI();
-            weight = w * w_unit;
+    }
+    // ED-PIC extension?
+    else if (read_weighting) {
+        // TODO: Add ASSERT_WITH_MESSAGE to test if weighting is a constant record
+        // TODO: Add ASSERT_WITH_MESSAGE for macroWeighted value in ED-PIC
+        weight = ptr_w.get()[0] * w_unit;
+    }
+
+    // Convert the units of the whole slice at once, in place
+    auto convert_units = [count] (std::shared_ptr<ParticleReal> const& data,
+                                  double const unit, double const divisor, ParticleReal const shift) {
+        ParticleReal* const AMREX_RESTRICT d = data.get();
+        for (std::uint64_t i = 0; i < count; ++i) {
+            d[i] = static_cast<ParticleReal>(d[i]*unit/divisor) + shift;
         }
+    };
+    if (count > 0) {
+#if !defined(WARPX_DIM_1D_Z)
+        convert_units(ptr_x, position_unit_x, 1.0, 0.0_prt);
+#endif
+#if defined(WARPX_DIM_3D) || defined(WARPX_DIM_RZ)
+        convert_units(ptr_y, position_unit_y, 1.0, 0.0_prt);
+#endif
+        convert_units(ptr_z, position_unit_z, 1.0, z_shift);
+        convert_units(ptr_ux, momentum_unit_x, PhysConst::m_e, 0.0_prt);
+        if (has_uy) convert_units(ptr_uy, momentum_unit_y, PhysConst::m_e, 0.0_prt);
+        convert_units(ptr_uz, momentum_unit_z, PhysConst::m_e, 0.0_prt);
+    }
 
-        for (auto i = decltype(npart){0}; i<npart; ++i){
+    particle_x.reserve(count);
+    particle_y.reserve(count);
+    particle_z.reserve(count);
+    particle_ux.reserve(count);
+    particle_uy.reserve(count);
+    particle_uz.reserve(count);
+    particle_w.reserve(count);
+    for (std::uint64_t i = 0; i < count; ++i){
 #if !defined(WARPX_DIM_1D_Z)
-            ParticleReal const x = ptr_x.get()[i]*position_unit_x;
+        ParticleReal const x = ptr_x.get()[i];
 #else
-            ParticleReal const x = 0.0_prt;
+        ParticleReal const x = 0.0_prt;
 #endif
-            ParticleReal const z = ptr_z.get()[i]*position_unit_z+z_shift;
+        ParticleReal const z = ptr_z.get()[i];
 #if defined(WARPX_DIM_3D) || defined(WARPX_DIM_RZ)
-            ParticleReal const y = ptr_y.get()[i]*position_unit_y;
+        ParticleReal const y = ptr_y.get()[i];
 #else
-            ParticleReal const y = 0.0_prt;
-#endif
-            if (plasma_injector->insideBounds(x, y, z)) {
-                ParticleReal const ux = ptr_ux.get()[i]*momentum_unit_x/PhysConst::m_e;
-                ParticleReal const uz = ptr_uz.get()[i]*momentum_unit_z/PhysConst::m_e;
-                ParticleReal uy = 0.0_prt;
-                if (ps["momentum"].contains("y")) {
-                    uy = ptr_uy.get()[i]*momentum_unit_y/PhysConst::m_e;
-                }
-                CheckAndAddParticle(x, y, z, ux, uy, uz, weight,
-                                    particle_x,  particle_y,  particle_z,
-                                    particle_ux, particle_uy, particle_uz,
-                                    particle_w);
-            }
-        }
-        auto const np = particle_z.size();
-        if (np < npart) {
-            WarpX::GetInstance().RecordWarning("Species",
-                "Simulation box doesn't cover all particles",
-                WarnPriority::high);
+        ParticleReal const y = 0.0_prt;
+#endif
+        if (plasma_injector->insideBounds(x, y, z)) {
+            ParticleReal const uy = (has_uy) ? ptr_uy.get()[i] : 0.0_prt;
+            CheckAndAddParticle(x, y, z, ptr_ux.get()[i], uy, ptr_uz.get()[i], weight,
+                                particle_x,  particle_y,  particle_z,
+                                particle_ux, particle_uy, particle_uz,
+                                particle_w);
         }
-    } // IO Processor
+    }
+
     auto const np = particle_z.size();
+    auto np_total = static_cast<Long>(np);
+    ParallelDescriptor::ReduceLongSum(np_total);
+    if (np_total < static_cast<Long>(npart)) {
+        WarpX::GetInstance().RecordWarning("Species",
+            "Simulation box doesn't cover all particles",
+            WarnPriority::high);
+    }
     AddNParticles(0, np,
                   particle_x.dataPtr(),  particle_y.dataPtr(),  particle_z.dataPtr(),
                   particle_ux.dataPtr(), particle_uy.dataPtr(), particle_uz.dataPtr(),
@@ -1685,6 +1733,7 @@ PhysicalParticleContainer::Evolve (int lev,
 
     WARPX_PROFILE("PhysicalParticleContainer::Evolve()");
     WARPX_PROFILE_VAR_NS("PhysicalParticleContainer::Evolve::GatherAndPush", blp_fg);
+    WARPX_PROFILE_VAR_NS("PhysicalParticleContainer::Evolve::GatherPushAndDeposit", blp_fused);
 
     BL_ASSERT(OnSameGrids(lev,jx));
 
@@ -1695,8 +1744,14 @@ PhysicalParticleContainer::Evolve (int lev,
 
     bool has_buffer = cEx || cjx;
 
-    if ( (WarpX::do_back_transformed_diagnostics && do_back_transformed_diagnostics) ||
-         (m_do_back_transformed_particles) )
+    // Gather, push and deposit in a single pass over the particles, when possible
+    const bool do_fused = UseFusedParticleKernel() && !has_buffer && !skip_deposition;
+
+    // When the tiles are processed in two calls (Boundary then Interior),
+    // the buffers of all the tiles are resized in the first one
+    if ( ((WarpX::do_back_transformed_diagnostics && do_back_transformed_diagnostics) ||
+          (m_do_back_transformed_particles)) &&
+         tile_selection != TileSelection::Interior )
     {
         for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
         {
@@ -1724,6 +1779,8 @@ PhysicalParticleContainer::Evolve (int lev,
 
         for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
         {
+            if (!IsTileSelected(pti)) continue;
+
             if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
             {
                 amrex::Gpu::synchronize();
@@ -1783,7 +1840,7 @@ PhysicalParticleContainer::Evolve (int lev,
 
             const long np_current = (cjx) ? nfine_current : np;
 
-            if (rho && ! skip_deposition) {
+            if (rho && ! skip_deposition && ! do_fused) {
                 // Deposit charge before particle push, in component 0 of MultiFab rho.
                 int* AMREX_RESTRICT ion_lev;
                 if (do_field_ionization){
@@ -1799,7 +1856,18 @@ PhysicalParticleContainer::Evolve (int lev,
                 }
             }
 
-            if (! do_not_push)
+            if (do_fused)
+            {
+                // Gather, push, deposit current and (if needed) charge before
+                // and after the push, in one loop over the particles
+                WARPX_PROFILE_VAR_START(blp_fused);
+                PushPXAndDeposit(pti, exfab, eyfab, ezfab,
+                                 bxfab, byfab, bzfab,
+                                 Ex.nGrowVect(), jx, jy, jz, rho,
+                                 thread_num, lev, dt, ScaleFields(false), a_dt_type);
+                WARPX_PROFILE_VAR_STOP(blp_fused);
+            }
+            else if (! do_not_push)
             {
                 const long np_gather = (cEx) ? nfine_gather : np;
 
@@ -1879,7 +1947,7 @@ PhysicalParticleContainer::Evolve (int lev,
                 } // end of "if do_electrostatic == ElectrostaticSolverAlgo::None"
             } // end of "if do_not_push"
 
-            if (rho && ! skip_deposition) {
+            if (rho && ! skip_deposition && ! do_fused) {
                 // Deposit charge after particle push, in component 1 of MultiFab rho.
                 // (Skipped for electrostatic solver, as this may lead to out-of-bounds)
                 if (WarpX::do_electrostatic == ElectrostaticSolverAlgo::None) {
@@ -1914,7 +1982,10 @@ PhysicalParticleContainer::Evolve (int lev,
     // are not consistent, and the call to Redistribute (inside
     // SplitParticles) may result in split particles to deposit twice on the
     // coarse level.
-    if (do_splitting && (a_dt_type == DtType::SecondHalf || a_dt_type == DtType::Full) ){
+    // When the tiles are processed in two calls (Boundary then Interior),
+    // the splitting is done after the last one.
+    if (do_splitting && (a_dt_type == DtType::SecondHalf || a_dt_type == DtType::Full) &&
+        tile_selection != TileSelection::Boundary){
         SplitParticles(lev);
     }
 }
@@ -2705,6 +2776,373 @@ PhysicalParticleContainer::PushPX (WarpXParIter& pti,
     });
 }
 
+bool
+PhysicalParticleContainer::UseFusedParticleKernel () const
+{
+    if (!WarpX::use_fused_particle_kernel) return false;
+    if (do_not_push || do_not_deposit) return false;
+    if (WarpX::current_deposition_algo != CurrentDepositionAlgo::Esirkepov &&
+        WarpX::current_deposition_algo != CurrentDepositionAlgo::Direct) return false;
+    if (WarpX::do_electrostatic != ElectrostaticSolverAlgo::None) return false;
+#ifdef WARPX_QED
+    if (has_quantum_sync()) return false;
+#endif
+    return true;
+}
+
+#if defined(WARPX_DIM_3D)
+template <int depos_order, bool do_esirkepov>
+void
+PhysicalParticleContainer::PushPXAndDepositShapeN (WarpXParIter& pti,
+                                                   amrex::FArrayBox const * exfab,
+                                                   amrex::FArrayBox const * eyfab,
+                                                   amrex::FArrayBox const * ezfab,
+                                                   amrex::FArrayBox const * bxfab,
+                                                   amrex::FArrayBox const * byfab,
+                                                   amrex::FArrayBox const * bzfab,
+                                                   const amrex::IntVect ngEB,
+                                                   amrex::MultiFab& jx, amrex::MultiFab& jy, amrex::MultiFab& jz,
+                                                   amrex::MultiFab* rho,
+                                                   int thread_num, int lev,
+                                                   amrex::Real dt, ScaleFields scaleFields,
+                                                   DtType a_dt_type)
+{
+    const long np = pti.numParticles();
+    // If no particles, do not do anything
+    if (np == 0) return;
+
+    WarpX& warpx = WarpX::GetInstance();
+
+    const std::array<Real,3>& dx = WarpX::CellSize(lev);
+    const amrex::GpuArray<amrex::Real, 3> dx_arr = {dx[0], dx[1], dx[2]};
+    const amrex::GpuArray<amrex::Real, 3> dinv_arr = {1._rt/dx[0], 1._rt/dx[1], 1._rt/dx[2]};
+    const amrex::Real invvol = dinv_arr[0]*dinv_arr[1]*dinv_arr[2];
+    const amrex::GpuArray<amrex::Real, 3> invdtd_arr = {1._rt/(dt*dx[1]*dx[2]),
+                                                        1._rt/(dt*dx[0]*dx[2]),
+                                                        1._rt/(dt*dx[0]*dx[1])};
+
+    // Field gather: box from which the fields are gathered, including guard cells
+    Box gather_box = pti.tilebox();
+    gather_box.grow(ngEB);
+    const std::array<amrex::Real, 3>& xyzmin_gather = WarpX::LowerCorner(gather_box, lev, 0._rt);
+    const amrex::GpuArray<amrex::Real, 3> xyzmin_gather_arr = {xyzmin_gather[0], xyzmin_gather[1], xyzmin_gather[2]};
+    const Dim3 lo_gather = lbound(gather_box);
+
+    const bool galerkin_interpolation = WarpX::galerkin_interpolation;
+    const int nox = WarpX::nox;
+    const int n_rz_azimuthal_modes = WarpX::n_rz_azimuthal_modes;
+
+    amrex::Array4<const amrex::Real> const& ex_arr = exfab->array();
+    amrex::Array4<const amrex::Real> const& ey_arr = eyfab->array();
+    amrex::Array4<const amrex::Real> const& ez_arr = ezfab->array();
+    amrex::Array4<const amrex::Real> const& bx_arr = bxfab->array();
+    amrex::Array4<const amrex::Real> const& by_arr = byfab->array();
+    amrex::Array4<const amrex::Real> const& bz_arr = bzfab->array();
+
+    amrex::IndexType const ex_type = exfab->box().ixType();
+    amrex::IndexType const ey_type = eyfab->box().ixType();
+    amrex::IndexType const ez_type = ezfab->box().ixType();
+    amrex::IndexType const bx_type = bxfab->box().ixType();
+    amrex::IndexType const by_type = byfab->box().ixType();
+    amrex::IndexType const bz_type = bzfab->box().ixType();
+
+    // Current deposition: same tile and guard cells as in DepositCurrent
+    const amrex::IntVect& ng_J = warpx.get_ng_depos_J();
+    const amrex::IntVect shape_extent = amrex::IntVect(depos_order/2);
+#ifndef AMREX_USE_GPU
+    const amrex::IntVect range = ng_J - shape_extent;
+#else
+    const amrex::IntVect range = jx.nGrowVect() - shape_extent;
+#endif
+    amrex::ignore_unused(range); // for release builds
+    AMREX_ASSERT_WITH_MESSAGE(
+        amrex::numParticlesOutOfRange(pti, range) == 0,
+        "Particles shape does not fit within tile (CPU) or guard cells (GPU) used for current deposition");
+
+    Box j_box = pti.tilebox();
+#ifndef AMREX_USE_GPU
+    // Staggered tile boxes (different in each direction)
+    Box tbx = convert( j_box, jx.ixType().toIntVect() );
+    Box tby = convert( j_box, jy.ixType().toIntVect() );
+    Box tbz = convert( j_box, jz.ixType().toIntVect() );
+    tbx.grow(ng_J);
+    tby.grow(ng_J);
+    tbz.grow(ng_J);
+#endif
+    j_box.grow(ng_J);
+    const Dim3 lo_j = lbound(j_box);
+    // Take into account Galilean shift
+    const std::array<amrex::Real, 3>& xyzmin_j = WarpX::LowerCorner(j_box, lev, 0.5_rt*dt);
+    const amrex::GpuArray<amrex::Real, 3> xyzmin_j_arr = {xyzmin_j[0], xyzmin_j[1], xyzmin_j[2]};
+
+#ifdef AMREX_USE_GPU
+    amrex::ignore_unused(thread_num);
+    // GPU, no tiling: j<xyz>_arr point to the full j<xyz> arrays
+    Array4<Real> const& jx_arr = jx.array(pti);
+    Array4<Real> const& jy_arr = jy.array(pti);
+    Array4<Real> const& jz_arr = jz.array(pti);
+#else
+    // CPU, tiling: j<xyz>_arr point to the local_j<xyz>[thread_num] arrays
+    local_jx[thread_num].resize(tbx, jx.nComp());
+    local_jy[thread_num].resize(tby, jy.nComp());
+    local_jz[thread_num].resize(tbz, jz.nComp());
+    local_jx[thread_num].setVal(0.0);
+    local_jy[thread_num].setVal(0.0);
+    local_jz[thread_num].setVal(0.0);
+    Array4<Real> const& jx_arr = local_jx[thread_num].array();
+    Array4<Real> const& jy_arr = local_jy[thread_num].array();
+    Array4<Real> const& jz_arr = local_jz[thread_num].array();
+#endif
+    const amrex::IntVect jx_type = jx.ixType().toIntVect();
+    const amrex::IntVect jy_type = jy.ixType().toIntVect();
+    const amrex::IntVect jz_type = jz.ixType().toIntVect();
+
+    // Charge deposition: component 0 of rho before the push, component 1 after the push
+    const bool do_rho = (rho != nullptr);
+    const int nc = WarpX::ncomps;
+    Array4<Real> rho_arr;
+    amrex::IntVect rho_type(0);
+    Dim3 lo_rho{0, 0, 0};
+    amrex::GpuArray<amrex::Real, 3> xyzmin_rho_old_arr = {0._rt, 0._rt, 0._rt};
+    amrex::GpuArray<amrex::Real, 3> xyzmin_rho_new_arr = {0._rt, 0._rt, 0._rt};
+#ifndef AMREX_USE_GPU
+    Box tb;
+#endif
+    if (do_rho) {
+        const amrex::IntVect& ng_rho = warpx.get_ng_depos_rho();
+        Box rho_box = pti.tilebox();
+#ifndef AMREX_USE_GPU
+        tb = convert( rho_box, rho->ixType().toIntVect() );
+        tb.grow(ng_rho);
+#endif
+        rho_box.grow(ng_rho);
+        lo_rho = lbound(rho_box);
+        const std::array<amrex::Real, 3>& xyzmin_rho_old = WarpX::LowerCorner(rho_box, lev, 0._rt);
+        const std::array<amrex::Real, 3>& xyzmin_rho_new = WarpX::LowerCorner(rho_box, lev, warpx.getdt(lev));
+        xyzmin_rho_old_arr = {xyzmin_rho_old[0], xyzmin_rho_old[1], xyzmin_rho_old[2]};
+        xyzmin_rho_new_arr = {xyzmin_rho_new[0], xyzmin_rho_new[1], xyzmin_rho_new[2]};
+        rho_type = rho->ixType().toIntVect();
+#ifdef AMREX_USE_GPU
+        rho_arr = rho->array(pti);
+#else
+        local_rho[thread_num].resize(tb, 2*nc);
+        local_rho[thread_num].setVal(0.0);
+        rho_arr = local_rho[thread_num].array();
+#endif
+    }
+
+    // Particle data
+    const auto getPosition = GetParticlePosition(pti);
+          auto setPosition = SetParticlePosition(pti);
+    const auto getExternalEB = GetExternalEBField(pti);
+
+    auto& attribs = pti.GetAttribs();
+    const ParticleReal* const AMREX_RESTRICT wp = attribs[PIdx::w].dataPtr();
+    ParticleReal* const AMREX_RESTRICT ux = attribs[PIdx::ux].dataPtr();
+    ParticleReal* const AMREX_RESTRICT uy = attribs[PIdx::uy].dataPtr();
+    ParticleReal* const AMREX_RESTRICT uz = attribs[PIdx::uz].dataPtr();
+
+    int do_copy = ( (WarpX::do_back_transformed_diagnostics
+                     && do_back_transformed_diagnostics
+                     && a_dt_type!=DtType::SecondHalf)
+                  || (m_do_back_transformed_particles && (a_dt_type!=DtType::SecondHalf)) );
+    CopyParticleAttribs copyAttribs;
+    if (do_copy) {
+        copyAttribs = CopyParticleAttribs(pti, tmp_particle_data, 0);
+    }
+
+    int* AMREX_RESTRICT ion_lev = nullptr;
+    if (do_field_ionization) {
+        ion_lev = pti.GetiAttribs(particle_icomps["ionizationLevel"]).dataPtr();
+    }
+
+    const bool save_previous_position = m_save_previous_position;
+    ParticleReal* x_old = nullptr;
+    ParticleReal* y_old = nullptr;
+    ParticleReal* z_old = nullptr;
+    if (save_previous_position) {
+        x_old = pti.GetAttribs(particle_comps["prev_x"]).dataPtr();
+        y_old = pti.GetAttribs(particle_comps["prev_y"]).dataPtr();
+        z_old = pti.GetAttribs(particle_comps["prev_z"]).dataPtr();
+    }
+
+    const amrex::Real q = this->charge;
+    const amrex::Real m = this->mass;
+    const amrex::Real clightsq = 1.0_rt/PhysConst::c/PhysConst::c;
+    // Deposit J at t_{n+1/2}
+    const amrex::Real relative_time = -0.5_rt * dt;
+
+    const auto pusher_algo = WarpX::particle_pusher_algo;
+    const auto do_crr = do_classical_radiation_reaction;
+    const auto t_do_not_gather = do_not_gather;
+
+    amrex::LayoutData<amrex::Real> * const costs = WarpX::getCosts(lev);
+    amrex::Real * const cost = costs ? &((*costs)[pti.index()]) : nullptr;
+    const auto load_balance_costs_update_algo = WarpX::load_balance_costs_update_algo;
+#if defined(WARPX_USE_GPUCLOCK)
+    amrex::Real* cost_real = nullptr;
+    if( load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::GpuClock) {
+        cost_real = (amrex::Real *) amrex::The_Managed_Arena()->alloc(sizeof(amrex::Real));
+        *cost_real = 0._rt;
+    }
+#else
+    amrex::ignore_unused(cost, load_balance_costs_update_algo);
+#endif
+
+    amrex::ParallelFor( np, [=] AMREX_GPU_DEVICE (long ip)
+    {
+#if defined(WARPX_USE_GPUCLOCK)
+        KernelTimer kernelTimer(cost && load_balance_costs_update_algo
+                                == LoadBalanceCostsUpdateAlgo::GpuClock, cost_real);
+#endif
+        amrex::ParticleReal xp, yp, zp;
+        getPosition(ip, xp, yp, zp);
+
+        if (save_previous_position) {
+            x_old[ip] = xp;
+            y_old[ip] = yp;
+            z_old[ip] = zp;
+        }
+
+        amrex::Real wq = q*wp[ip];
+        if (ion_lev) {
+            wq *= ion_lev[ip];
+        }
+
+        // Deposit charge before particle push, in component 0 of rho
+        if (do_rho) {
+            doChargeDepositionSingleParticle<depos_order>(
+                xp, yp, zp, wq*invvol, rho_arr, 0, rho_type,
+                dinv_arr, xyzmin_rho_old_arr, lo_rho);
+        }
+
+        amrex::ParticleReal Exp = 0._rt, Eyp = 0._rt, Ezp = 0._rt;
+        amrex::ParticleReal Bxp = 0._rt, Byp = 0._rt, Bzp = 0._rt;
+
+        if(!t_do_not_gather){
+            // first gather E and B to the particle positions
+            doGatherShapeN(xp, yp, zp, Exp, Eyp, Ezp, Bxp, Byp, Bzp,
+                           ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,
+                           ex_type, ey_type, ez_type, bx_type, by_type, bz_type,
+                           dx_arr, xyzmin_gather_arr, lo_gather, n_rz_azimuthal_modes,
+                           nox, galerkin_interpolation);
+        }
+        // Externally applied E and B-field in Cartesian co-ordinates
+        getExternalEB(ip, Exp, Eyp, Ezp, Bxp, Byp, Bzp);
+
+        scaleFields(xp, yp, zp, Exp, Eyp, Ezp, Bxp, Byp, Bzp);
+
+        doParticlePush(getPosition, setPosition, copyAttribs, ip,
+                       ux[ip], uy[ip], uz[ip],
+                       Exp, Eyp, Ezp, Bxp, Byp, Bzp,
+                       ion_lev ? ion_lev[ip] : 0,
+                       m, q, pusher_algo, do_crr, do_copy,
+#ifdef WARPX_QED
+                       0, 0._rt,
+#endif
+                       dt);
+
+        // Deposit current with the updated position and momentum
+        getPosition(ip, xp, yp, zp);
+        const amrex::Real gaminv = 1.0_rt/std::sqrt(1.0_rt + ux[ip]*ux[ip]*clightsq
+                                                    + uy[ip]*uy[ip]*clightsq
+                                                    + uz[ip]*uz[ip]*clightsq);
+        const amrex::Real vx = ux[ip]*gaminv;
+        const amrex::Real vy = uy[ip]*gaminv;
+        const amrex::Real vz = uz[ip]*gaminv;
+
+        if constexpr (do_esirkepov) {
+            doEsirkepovDepositionSingleParticle<depos_order>(
+                xp, yp, zp, wq, ux[ip], uy[ip], uz[ip], gaminv, dt, relative_time,
+                jx_arr, jy_arr, jz_arr, dinv_arr, invdtd_arr, xyzmin_j_arr, lo_j);
+        } else {
+            doDirectCurrentDepositionSingleParticle<depos_order>(
+                xp, yp, zp, wq*invvol, vx, vy, vz, relative_time,
+                jx_arr, jy_arr, jz_arr, jx_type, jy_type, jz_type,
+                dinv_arr, xyzmin_j_arr, lo_j);
+        }
+
+        // Deposit charge after particle push, in component 1 of rho
+        if (do_rho) {
+            doChargeDepositionSingleParticle<depos_order>(
+                xp, yp, zp, wq*invvol, rho_arr, nc, rho_type,
+                dinv_arr, xyzmin_rho_new_arr, lo_rho);
+        }
+    });
+
+#if defined(WARPX_USE_GPUCLOCK)
+    if( load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::GpuClock) {
+        amrex::Gpu::streamSynchronize();
+        *cost += *cost_real;
+        amrex::The_Managed_Arena()->free(cost_real);
+    }
+#endif
+
+#ifndef AMREX_USE_GPU
+    // CPU, tiling: atomicAdd local_j<xyz> and local_rho into j<xyz> and rho
+    jx[pti].atomicAdd(local_jx[thread_num], tbx, tbx, 0, 0, jx.nComp());
+    jy[pti].atomicAdd(local_jy[thread_num], tby, tby, 0, 0, jy.nComp());
+    jz[pti].atomicAdd(local_jz[thread_num], tbz, tbz, 0, 0, jz.nComp());
+    if (do_rho) {
+        (*rho)[pti].atomicAdd(local_rho[thread_num], tb, tb, 0, 0, 2*nc);
+    }
+#endif
+}
+#endif // WARPX_DIM_3D
+
+void
+PhysicalParticleContainer::PushPXAndDeposit (WarpXParIter& pti,
+                                             amrex::FArrayBox const * exfab,
+                                             amrex::FArrayBox const * eyfab,
+                                             amrex::FArrayBox const * ezfab,
+                                             amrex::FArrayBox const * bxfab,
+                                             amrex::FArrayBox const * byfab,
+                                             amrex::FArrayBox const * bzfab,
+                                             const amrex::IntVect ngEB,
+                                             amrex::MultiFab& jx, amrex::MultiFab& jy, amrex::MultiFab& jz,
+                                             amrex::MultiFab* rho,
+                                             int thread_num, int lev,
+                                             amrex::Real dt, ScaleFields scaleFields,
+                                             DtType a_dt_type)
+{
+#if defined(WARPX_DIM_3D)
+    const bool do_esirkepov = (WarpX::current_deposition_algo == CurrentDepositionAlgo::Esirkepov);
+    if (do_esirkepov && WarpX::do_nodal==1) {
+        amrex::Abort("The Esirkepov algorithm cannot be used with a nodal grid.");
+    }
+
+    if (WarpX::nox == 1) {
+        if (do_esirkepov) {
+            PushPXAndDepositShapeN<1, true>(pti, exfab, eyfab, ezfab, bxfab, byfab, bzfab, ngEB,
+                                            jx, jy, jz, rho, thread_num, lev, dt, scaleFields, a_dt_type);
+        } else {
+            PushPXAndDepositShapeN<1, false>(pti, exfab, eyfab, ezfab, bxfab, byfab, bzfab, ngEB,
+                                             jx, jy, jz, rho, thread_num, lev, dt, scaleFields, a_dt_type);
+        }
+    } else if (WarpX::nox == 2) {
+        if (do_esirkepov) {
+            PushPXAndDepositShapeN<2, true>(pti, exfab, eyfab, ezfab, bxfab, byfab, bzfab, ngEB,
+                                            jx, jy, jz, rho, thread_num, lev, dt, scaleFields, a_dt_type);
+        } else {
+            PushPXAndDepositShapeN<2, false>(pti, exfab, eyfab, ezfab, bxfab, byfab, bzfab, ngEB,
+                                             jx, jy, jz, rho, thread_num, lev, dt, scaleFields, a_dt_type);
+        }
+    } else if (WarpX::nox == 3) {
+        if (do_esirkepov) {
+            PushPXAndDepositShapeN<3, true>(pti, exfab, eyfab, ezfab, bxfab, byfab, bzfab, ngEB,
+                                            jx, jy, jz, rho, thread_num, lev, dt, scaleFields, a_dt_type);
+        } else {
+            PushPXAndDepositShapeN<3, false>(pti, exfab, eyfab, ezfab, bxfab, byfab, bzfab, ngEB,
+                                             jx, jy, jz, rho, thread_num, lev, dt, scaleFields, a_dt_type);
+        }
+    }
+#else
+    amrex::ignore_unused(pti, exfab, eyfab, ezfab, bxfab, byfab, bzfab, ngEB,
+                         jx, jy, jz, rho, thread_num, lev, dt, scaleFields, a_dt_type);
+    amrex::Abort("PushPXAndDeposit is only implemented in 3D");
+#endif
+}
+
 void
 PhysicalParticleContainer::InitIonizationModule ()
 {
@@ -2793,7 +3231,7 @@ PhysicalParticleContainer::getIonizationFunc (const WarpXParIter& pti,
                                 ion_atomic_number);
 }
 
-void PhysicalParticleContainer::resample (const int timestep)
+void PhysicalParticleContainer::resample (const int timestep, CellBinsCache& cell_bins)
 {
     // In heavily load imbalanced simulations, MPI processes with few particles will spend most of
     // the time at the MPI synchronization in TotalNumberOfParticles(). Having two profiler entries
@@ -2816,7 +3254,7 @@ void PhysicalParticleContainer::resample (const int timestep)
         {
             for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
             {
-                m_resampler(pti, lev, this);
+                m_resampler(pti, lev, this, cell_bins);
             }
         }
     }
@@ -6,6 +6,7 @@
  */
 #include "LevelingThinning.H"
 
+#include "Particles/Sorting/CellBinsCache.H"
 #include "Particles/WarpXParticleContainer.H"
 #include "Utils/ParticleUtils.H"
 #include "Utils/TextMsg.H"
@@ -50,7 +51,8 @@ LevelingThinning::LevelingThinning (const std::string species_name)
 }
 
 void LevelingThinning::operator() (WarpXParIter& pti, const int lev,
-                                   WarpXParticleContainer * const pc) const
+                                   WarpXParticleContainer * const pc,
+                                   CellBinsCache& cell_bins) const
 {
     using namespace amrex::literals;
 
@@ -65,7 +67,8 @@ void LevelingThinning::operator() (WarpXParIter& pti, const int lev,
     // efficient to directly loop over the particles. Nevertheless, this structure with a loop over
     // the cells is more general and can be readily used to implement almost any other resampling
     // algorithm.
-    auto bins = ParticleUtils::findParticlesInEachCell(lev, pti, ptile);
+    // The bins are cached and shared with the collision operators.
+    auto& bins = cell_bins.getBins(lev, pti, ptile);
 
     const int n_cells = bins.numBins();
     const auto indices = bins.permutationPtr();
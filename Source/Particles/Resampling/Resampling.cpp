@@ -32,7 +32,8 @@ bool Resampling::triggered (const int timestep, const amrex::Real global_numpart
     return m_resampling_trigger.triggered(timestep, global_numparts);
 }
 
-void Resampling::operator() (WarpXParIter& pti, const int lev, WarpXParticleContainer * const pc) const
+void Resampling::operator() (WarpXParIter& pti, const int lev, WarpXParticleContainer * const pc,
+                              CellBinsCache& cell_bins) const
 {
-    (*m_resampling_algorithm)(pti, lev, pc);
+    (*m_resampling_algorithm)(pti, lev, pc, cell_bins);
 }
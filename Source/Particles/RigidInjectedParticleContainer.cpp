@@ -298,18 +298,21 @@ RigidInjectedParticleContainer::Evolve (int lev,
 {
 
     // Update location of injection plane in the boosted frame
-    zinject_plane_lev_previous = zinject_plane_levels[lev];
-    zinject_plane_levels[lev] -= dt*WarpX::beta_boost*PhysConst::c;
-    zinject_plane_lev = zinject_plane_levels[lev];
-
-    // Set the done injecting flag whan the inject plane moves out of the
-    // simulation domain.
-    // It is much easier to do this check, rather than checking if all of the
-    // particles have crossed the inject plane.
-    const Real* plo = Geom(lev).ProbLo();
-    const Real* phi = Geom(lev).ProbHi();
-    done_injecting_lev = ((zinject_plane_levels[lev] < plo[WARPX_ZINDEX] && WarpX::moving_window_v + WarpX::beta_boost*PhysConst::c >= 0.) ||
-                           (zinject_plane_levels[lev] > phi[WARPX_ZINDEX] && WarpX::moving_window_v + WarpX::beta_boost*PhysConst::c <= 0.));
+    // (only once per step, when the tiles are processed in two calls)
+    if (tile_selection != TileSelection::Interior) {
+        zinject_plane_lev_previous = zinject_plane_levels[lev];
+        zinject_plane_levels[lev] -= dt*WarpX::beta_boost*PhysConst::c;
+        zinject_plane_lev = zinject_plane_levels[lev];
+
+        // Set the done injecting flag whan the inject plane moves out of the
+        // simulation domain.
+        // It is much easier to do this check, rather than checking if all of the
+        // particles have crossed the inject plane.
+        const Real* plo = Geom(lev).ProbLo();
+        const Real* phi = Geom(lev).ProbHi();
+        done_injecting_lev = ((zinject_plane_levels[lev] < plo[WARPX_ZINDEX] && WarpX::moving_window_v + WarpX::beta_boost*PhysConst::c >= 0.) ||
+                               (zinject_plane_levels[lev] > phi[WARPX_ZINDEX] && WarpX::moving_window_v + WarpX::beta_boost*PhysConst::c <= 0.));
+    }
 
     PhysicalParticleContainer::Evolve (lev,
                                        Ex, Ey, Ez,
@@ -0,0 +1,63 @@
+/* Copyright 2022 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "CellBinsCache.H"
+
+#include "Utils/ParticleUtils.H"
+#include "WarpX.H"
+
+#include <AMReX_Geometry.H>
+#include <AMReX_IntVect.H>
+
+CellBinsCache::ParticleBins&
+CellBinsCache::getBins (int lev, amrex::MFIter const& mfi, ParticleTileType const& ptile)
+{
+    CachedBins* entry = nullptr;
+    // Insertion in a std::map does not invalidate references to the other
+    // elements, so only the lookup needs to be protected
+#ifdef AMREX_USE_OMP
+#pragma omp critical (warpx_cell_bins_cache)
+#endif
+    {
+        entry = &m_bins[std::make_tuple(lev, mfi.index(), mfi.LocalTileIndex())];
+    }
+
+    const int np = ptile.numParticles();
+    auto const* particle_ptr = ptile.GetArrayOfStructs()().data();
+    const amrex::Box cbx = mfi.tilebox(amrex::IntVect::TheZeroVector());
+    const auto plo = WarpX::GetInstance().Geom(lev).ProbLoArray();
+
+    bool up_to_date = entry->valid && (entry->np == np) &&
+        (entry->particle_ptr == particle_ptr) && (entry->cbx == cbx);
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        up_to_date = up_to_date && (entry->plo[idim] == plo[idim]);
+    }
+
+    if (!up_to_date) {
+        entry->bins = ParticleUtils::findParticlesInEachCell(lev, mfi, ptile);
+        entry->cbx = cbx;
+        entry->plo = plo;
+        entry->particle_ptr = particle_ptr;
+        entry->np = np;
+        entry->valid = true;
+    }
+
+    return entry->bins;
+}
+
+void
+CellBinsCache::invalidate ()
+{
+    for (auto& kv : m_bins) {
+        kv.second.valid = false;
+    }
+}
+
+void
+CellBinsCache::clear ()
+{
+    m_bins.clear();
+}
@@ -80,6 +80,10 @@ WarpXParIter::WarpXParIter (ContainerType& pc, int level, MFItInfo& info)
 {
 }
 
+WarpXParticleContainer::TileSelection WarpXParticleContainer::tile_selection =
+    WarpXParticleContainer::TileSelection::All;
+IntVect WarpXParticleContainer::tile_selection_reach = IntVect::TheZeroVector();
+
 WarpXParticleContainer::WarpXParticleContainer (AmrCore* amr_core, int ispecies)
     : ParticleContainer<0,0,PIdx::nattribs>(amr_core->GetParGDB())
     , species_id(ispecies)
@@ -137,6 +141,18 @@ WarpXParticleContainer::ReadParameters ()
     }
 }
 
+bool
+WarpXParticleContainer::IsTileSelected (const WarpXParIter& pti)
+{
+    if (tile_selection == TileSelection::All) return true;
+    // The tile is an interior tile if its deposition, and the cells that are
+    // exchanged with the neighboring boxes, cannot overlap (with a margin of
+    // one cell for the nodal components)
+    const bool is_interior = amrex::grow(pti.validbox(), -1).contains(
+        amrex::grow(pti.tilebox(), tile_selection_reach));
+    return is_interior == (tile_selection == TileSelection::Interior);
+}
+
 void
 WarpXParticleContainer::AllocData ()
 {
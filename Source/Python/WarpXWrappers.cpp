@@ -33,8 +33,11 @@
 #include <AMReX_Particles.H>
 #include <AMReX_StructOfArrays.H>
 
+#include <algorithm>
 #include <array>
 #include <cstdlib>
+#include <string>
+#include <vector>
 
 namespace
 {
@@ -65,6 +68,47 @@ namespace
         }
         return data;
     }
+    // Same as getMultiFabPointers, for the three components of a vector field at once,
+    // also returning the lower corners of the boxes (including guard cells).
+    // The output arrays are ordered by direction, then by box.
+    amrex::Real** getVectorMultiFabPointers (const std::array<amrex::MultiFab*, 3>& mfs,
+                                             int *num_boxes, int *ncomps, int **ngrowvect,
+                                             int **shapes, int **lovects)
+    {
+        for (const auto* mf : mfs) {
+            if (mf == nullptr) return nullptr;
+        }
+        *ncomps = mfs[0]->nComp();
+        *num_boxes = mfs[0]->local_size();
+        int shapesize = AMREX_SPACEDIM;
+        if (*ncomps > 1) shapesize += 1;
+        *ngrowvect = static_cast<int*>(malloc(sizeof(int) * 3*AMREX_SPACEDIM));
+        *shapes = static_cast<int*>(malloc(sizeof(int) * 3*shapesize*(*num_boxes)));
+        *lovects = static_cast<int*>(malloc(sizeof(int) * 3*AMREX_SPACEDIM*(*num_boxes)));
+        auto data =
+            static_cast<amrex::Real**>(malloc(3*(*num_boxes) * sizeof(amrex::Real*)));
+
+        for (int idir = 0; idir < 3; ++idir) {
+            for (int j = 0; j < AMREX_SPACEDIM; ++j) {
+                (*ngrowvect)[AMREX_SPACEDIM*idir+j] = mfs[idir]->nGrow(j);
+            }
+        }
+
+        // the components are defined on the same boxes, with different index types
+        for ( amrex::MFIter mfi(*mfs[0], false); mfi.isValid(); ++mfi ) {
+            for (int idir = 0; idir < 3; ++idir) {
+                const int i = idir*(*num_boxes) + mfi.LocalIndex();
+                auto& fab = (*mfs[idir])[mfi];
+                data[i] = fab.dataPtr();
+                for (int j = 0; j < AMREX_SPACEDIM; ++j) {
+                    (*shapes)[shapesize*i+j] = fab.box().length(j);
+                    (*lovects)[AMREX_SPACEDIM*i+j] = fab.box().smallEnd(j);
+                }
+                if (*ncomps > 1) (*shapes)[shapesize*i+AMREX_SPACEDIM] = *ncomps;
+            }
+        }
+        return data;
+    }
     int* getMultiFabLoVects (const amrex::MultiFab& mf, int *num_boxes, int **ngrowvect)
     {
         int shapesize = AMREX_SPACEDIM;
@@ -285,6 +329,18 @@ namespace
     WARPX_GET_FIELD(warpx_getCurrentDensityCP, WarpX::GetInstance().get_pointer_current_cp)
     WARPX_GET_FIELD(warpx_getCurrentDensityFP, WarpX::GetInstance().get_pointer_current_fp)
 
+#define WARPX_GET_FIELD_ALL_DIRECTIONS(FIELD, GETTER) \
+    amrex::Real** FIELD(int lev, \
+                        int *return_size, int *ncomps, int **ngrowvect, int **shapes, \
+                        int **lovects) { \
+        return getVectorMultiFabPointers({GETTER(lev, 0), GETTER(lev, 1), GETTER(lev, 2)}, \
+                                         return_size, ncomps, ngrowvect, shapes, lovects); \
+    }
+
+    WARPX_GET_FIELD_ALL_DIRECTIONS(warpx_getEfieldAllDirections, WarpX::GetInstance().get_pointer_Efield_aux)
+    WARPX_GET_FIELD_ALL_DIRECTIONS(warpx_getBfieldAllDirections, WarpX::GetInstance().get_pointer_Bfield_aux)
+    WARPX_GET_FIELD_ALL_DIRECTIONS(warpx_getCurrentDensityAllDirections, WarpX::GetInstance().get_pointer_current_fp)
+
     WARPX_GET_LOVECTS(warpx_getEfieldLoVects, WarpX::GetInstance().get_pointer_Efield_aux)
     WARPX_GET_LOVECTS(warpx_getEfieldCPLoVects, WarpX::GetInstance().get_pointer_Efield_cp)
     WARPX_GET_LOVECTS(warpx_getEfieldFPLoVects, WarpX::GetInstance().get_pointer_Efield_fp)
@@ -490,6 +546,44 @@ namespace
         return data;
     }
 
+    amrex::ParticleReal** warpx_getParticleArraysBatch (
+            const char* char_species_name, int ncomps, const char** char_comp_names,
+            int lev, int* num_tiles, int** particles_per_tile,
+            amrex::ParticleReal*** structs ) {
+
+        const auto & mypc = WarpX::GetInstance().GetPartContainer();
+        const std::string species_name(char_species_name);
+        auto & myspc = mypc.GetParticleContainerFromName(species_name);
+
+        const auto particle_comps = myspc.getParticleComps();
+        std::vector<int> comps(ncomps);
+        for (int icomp = 0; icomp < ncomps; ++icomp) {
+            comps[icomp] = particle_comps.at(std::string(char_comp_names[icomp]));
+        }
+
+        // single walk over the tiles, for the structs and all the components
+        std::vector<int> tile_np;
+        std::vector<amrex::ParticleReal*> tile_structs;
+        std::vector<amrex::ParticleReal*> tile_arrays;
+        for (WarpXParIter pti(myspc, lev); pti.isValid(); ++pti) {
+            tile_np.push_back(pti.numParticles());
+            tile_structs.push_back((amrex::ParticleReal*) pti.GetArrayOfStructs().data());
+            auto& soa = pti.GetStructOfArrays();
+            for (const int comp : comps) {
+                tile_arrays.push_back((amrex::ParticleReal*) soa.GetRealData(comp).dataPtr());
+            }
+        }
+
+        *num_tiles = static_cast<int>(tile_np.size());
+        *particles_per_tile = static_cast<int*>(malloc(*num_tiles*sizeof(int)));
+        std::copy(tile_np.begin(), tile_np.end(), *particles_per_tile);
+        *structs = static_cast<amrex::ParticleReal**>(malloc(*num_tiles*sizeof(amrex::ParticleReal*)));
+        std::copy(tile_structs.begin(), tile_structs.end(), *structs);
+        auto data = static_cast<amrex::ParticleReal**>(malloc(*num_tiles*ncomps*sizeof(amrex::ParticleReal*)));
+        std::copy(tile_arrays.begin(), tile_arrays.end(), data);
+        return data;
+    }
+
     int warpx_getParticleCompIndex (
          const char* char_species_name, const char* char_comp_name )
     {
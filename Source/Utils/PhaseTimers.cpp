@@ -0,0 +1,93 @@
+/* Copyright 2022 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+#include "PhaseTimers.H"
+
+#include <AMReX_GpuDevice.H>
+#include <AMReX_Utility.H>
+
+const std::array<std::string, PhaseTimers::NumPhases> PhaseTimers::names = {
+    "push_deposit", "field_solve", "communication", "collisions",
+    "diagnostics", "redistribute", "other"};
+
+bool PhaseTimers::m_enabled = false;
+bool PhaseTimers::m_in_step = false;
+bool PhaseTimers::m_do_device_synchronize = false;
+double PhaseTimers::m_last_time = 0.;
+std::vector<PhaseTimers::Phase> PhaseTimers::m_stack;
+std::array<double, PhaseTimers::NumPhases> PhaseTimers::m_step_times = {};
+std::array<double, PhaseTimers::NumPhases+1> PhaseTimers::m_accumulated_times = {};
+int PhaseTimers::m_num_steps = 0;
+
+void
+PhaseTimers::Enable (bool do_device_synchronize)
+{
+    m_enabled = true;
+    m_do_device_synchronize = do_device_synchronize;
+}
+
+void
+PhaseTimers::BeginStep ()
+{
+    if (!m_enabled) return;
+    m_in_step = true;
+    m_step_times.fill(0.);
+    m_stack.assign(1, Other);
+    if (m_do_device_synchronize) amrex::Gpu::synchronize();
+    m_last_time = amrex::second();
+}
+
+void
+PhaseTimers::EndStep ()
+{
+    if (!m_in_step) return;
+    Charge();
+    m_in_step = false;
+    m_stack.clear();
+    double total = 0.;
+    for (int i = 0; i < NumPhases; ++i) {
+        m_accumulated_times[i] += m_step_times[i];
+        total += m_step_times[i];
+    }
+    m_accumulated_times[NumPhases] += total;
+    ++m_num_steps;
+}
+
+std::array<double, PhaseTimers::NumPhases+1>
+PhaseTimers::GetAndReset (int& num_steps)
+{
+    num_steps = m_num_steps;
+    const auto times = m_accumulated_times;
+    m_accumulated_times.fill(0.);
+    m_num_steps = 0;
+    return times;
+}
+
+void
+PhaseTimers::Start (Phase phase)
+{
+    if (!m_in_step) return;
+    Charge();
+    m_stack.push_back(phase);
+}
+
+void
+PhaseTimers::Stop ()
+{
+    if (!m_in_step) return;
+    Charge();
+    m_stack.pop_back();
+}
+
+void
+PhaseTimers::Charge ()
+{
+    if (m_do_device_synchronize) amrex::Gpu::synchronize();
+    const double now = amrex::second();
+    m_step_times[m_stack.back()] += now - m_last_time;
+    m_last_time = now;
+}
@@ -13,8 +13,12 @@
 std::vector< double >
 utils::getRelativeCellPosition(amrex::MultiFab const& mf)
 {
-    amrex::IndexType const idx_type = mf.ixType();
+    return getRelativeCellPosition(mf.ixType());
+}
 
+std::vector< double >
+utils::getRelativeCellPosition(amrex::IndexType const& idx_type)
+{
     std::vector< double > relative_position(AMREX_SPACEDIM, 0.0);
 
     // amrex::CellIndex::CELL means: 0.5 from lower corner for that index/direction
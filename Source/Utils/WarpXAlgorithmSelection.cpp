@@ -66,6 +66,7 @@ const std::map<std::string, int> load_balance_costs_update_algo_to_int = {
     {"timers",    LoadBalanceCostsUpdateAlgo::Timers },
     {"gpuclock",  LoadBalanceCostsUpdateAlgo::GpuClock },
     {"heuristic", LoadBalanceCostsUpdateAlgo::Heuristic },
+    {"calibrated", LoadBalanceCostsUpdateAlgo::Calibrated },
     {"default",   LoadBalanceCostsUpdateAlgo::Timers }
 };
 
@@ -100,6 +101,12 @@ const std::map<std::string, ParticleBoundaryType> ParticleBCType_algo_to_enum =
     {"default",    ParticleBoundaryType::Absorbing}
 };
 
+const std::map<std::string, int> self_fields_solver_algo_to_int = {
+    {"multigrid", SelfFieldsSolverAlgo::Multigrid },
+    {"fft_igf",   SelfFieldsSolverAlgo::FFTIGF },
+    {"default",   SelfFieldsSolverAlgo::Multigrid }
+};
+
 const std::map<std::string, int> ReductionType_algo_to_int = {
     {"maximum",  ReductionType::Maximum},
     {"minimum",  ReductionType::Minimum},
@@ -139,6 +146,8 @@ GetAlgorithmInteger( amrex::ParmParse& pp, const char* pp_search_key ){
         algo_to_int = MacroscopicSolver_algo_to_int;
     } else if (0 == std::strcmp(pp_search_key, "reduction_type")) {
         algo_to_int = ReductionType_algo_to_int;
+    } else if (0 == std::strcmp(pp_search_key, "self_fields_solver")) {
+        algo_to_int = self_fields_solver_algo_to_int;
     } else {
         std::string pp_search_string = pp_search_key;
         amrex::Abort("Unknown algorithm type: " + pp_search_string);
@@ -25,6 +25,7 @@
 #include <AMReX_BoxArray.H>
 #include <AMReX_Config.H>
 #include <AMReX_Dim3.H>
+#include <AMReX_Extension.H>
 #include <AMReX_FArrayBox.H>
 #include <AMReX_FabArray.H>
 #include <AMReX_Geometry.H>
@@ -308,12 +309,19 @@ WarpX::shiftMF (amrex::MultiFab& mf, const amrex::Geometry& geom,
 
     AMREX_ALWAYS_ASSERT(ng[dir] >= num_shift);
 
-    amrex::MultiFab tmpmf(ba, dm, nc, ng);
-    amrex::MultiFab::Copy(tmpmf, mf, 0, 0, nc, ng);
+    // The data is shifted either in place, or by copying it to a temporary
+    // MultiFab first (the in-place shift avoids this copy of all the data)
+    const bool in_place = WarpX::moving_window_in_place_shift;
+    amrex::MultiFab tmpmf;
+    if (!in_place) {
+        tmpmf.define(ba, dm, nc, ng);
+        amrex::MultiFab::Copy(tmpmf, mf, 0, 0, nc, ng);
+    }
+    amrex::MultiFab& srcmf = (in_place) ? mf : tmpmf;
 
     if ( WarpX::safe_guard_cells ) {
         // Fill guard cells.
-        WarpXCommUtil::FillBoundary(tmpmf, geom.periodicity());
+        WarpXCommUtil::FillBoundary(srcmf, geom.periodicity());
     } else {
         amrex::IntVect ng_mw = amrex::IntVect::TheUnitVector();
         // Enough guard cells in the MW direction
@@ -321,7 +329,7 @@ WarpX::shiftMF (amrex::MultiFab& mf, const amrex::Geometry& geom,
         // Make sure we don't exceed number of guard cells allocated
         ng_mw = ng_mw.min(ng);
         // Fill guard cells.
-        WarpXCommUtil::FillBoundary(tmpmf, ng_mw, geom.periodicity());
+        WarpXCommUtil::FillBoundary(srcmf, ng_mw, geom.periodicity());
     }
 
     // Make a box that covers the region that the window moved into
@@ -360,7 +368,7 @@ WarpX::shiftMF (amrex::MultiFab& mf, const amrex::Geometry& geom,
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
 
-    for (amrex::MFIter mfi(tmpmf); mfi.isValid(); ++mfi )
+    for (amrex::MFIter mfi(srcmf); mfi.isValid(); ++mfi )
     {
         if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
         {
@@ -369,7 +377,7 @@ WarpX::shiftMF (amrex::MultiFab& mf, const amrex::Geometry& geom,
         amrex::Real wt = amrex::second();
 
         auto const& dstfab = mf.array(mfi);
-        auto const& srcfab = tmpmf.array(mfi);
+        auto const& srcfab = srcmf.array(mfi);
 
         const amrex::Box& outbox = mfi.fabbox() & adjBox;
 
@@ -381,7 +389,7 @@ WarpX::shiftMF (amrex::MultiFab& mf, const amrex::Geometry& geom,
                 })
             } else if (useparser == true) {
                 // index type of the src mf
-                auto const& mf_IndexType = (tmpmf).ixType();
+                auto const& mf_IndexType = (srcmf).ixType();
                 amrex::IntVect mf_type(AMREX_D_DECL(0,0,0));
                 for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
                     mf_type[idim] = mf_IndexType.nodeCentered(idim);
@@ -422,10 +430,59 @@ WarpX::shiftMF (amrex::MultiFab& mf, const amrex::Geometry& geom,
         } else {
             dstBox.growLo(dir,  num_shift);
         }
-        AMREX_PARALLEL_FOR_4D ( dstBox, nc, i, j, k, n,
-        {
-            dstfab(i,j,k,n) = srcfab(i+shift.x,j+shift.y,k+shift.z,n);
-        })
+        if (in_place && amrex::Gpu::inLaunchRegion()) {
+            // Each thread shifts one line of cells along the moving direction,
+            // in the order in which the cells can be overwritten
+            const int dst_lo = dstBox.smallEnd(dir);
+            const int dst_hi = dstBox.bigEnd(dir);
+            amrex::Box lineBox = dstBox;
+            lineBox.setBig(dir, dst_lo);
+            amrex::ParallelFor(lineBox, nc,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+            {
+                amrex::ignore_unused(j,k);
+                amrex::IntVect iv(AMREX_D_DECL(i,j,k));
+                for (int m = 0; m <= dst_hi - dst_lo; ++m) {
+                    iv[dir] = (num_shift > 0) ? dst_lo + m : dst_hi - m;
+                    dstfab(iv,n) = srcfab(iv+shiftiv,n);
+                }
+            });
+        } else if (in_place) {
+            // On CPU, the cells are visited in memory order, with the first
+            // (unit-stride) direction innermost, and the loop along the moving
+            // direction runs in the order in which the cells can be overwritten
+            const amrex::Dim3 lo = amrex::lbound(dstBox);
+            const amrex::Dim3 hi = amrex::ubound(dstBox);
+            const amrex::IntVect rev(AMREX_D_DECL(dir == 0 && num_shift < 0,
+                                                  dir == 1 && num_shift < 0,
+                                                  dir == 2 && num_shift < 0));
+            const amrex::Dim3 r = rev.dim3();
+            for (int n = 0; n < nc; ++n) {
+                for (int kk = 0; kk <= hi.z - lo.z; ++kk) {
+                    const int k = (r.z) ? hi.z - kk : lo.z + kk;
+                    for (int jj = 0; jj <= hi.y - lo.y; ++jj) {
+                        const int j = (r.y) ? hi.y - jj : lo.y + jj;
+                        if (dir == 0) {
+                            // The shift is along the unit-stride direction
+                            for (int ii = 0; ii <= hi.x - lo.x; ++ii) {
+                                const int i = (r.x) ? hi.x - ii : lo.x + ii;
+                                dstfab(i,j,k,n) = srcfab(i+shift.x,j,k,n);
+                            }
+                        } else {
+                            AMREX_PRAGMA_SIMD
+                            for (int i = lo.x; i <= hi.x; ++i) {
+                                dstfab(i,j,k,n) = srcfab(i,j+shift.y,k+shift.z,n);
+                            }
+                        }
+                    }
+                }
+            }
+        } else {
+            AMREX_PARALLEL_FOR_4D ( dstBox, nc, i, j, k, n,
+            {
+                dstfab(i,j,k,n) = srcfab(i+shift.x,j+shift.y,k+shift.z,n);
+            })
+        }
 
         if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
         {
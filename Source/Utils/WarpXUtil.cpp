@@ -25,6 +25,7 @@
 #include <AMReX_GpuLaunch.H>
 #include <AMReX_MFIter.H>
 #include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
 #include <AMReX_ParmParse.H>
 #include <AMReX_Parser.H>
 
@@ -36,6 +37,8 @@
 #include <set>
 #include <string>
 #include <limits>
+#include <utility>
+#include <vector>
 
 using namespace amrex;
 
@@ -263,6 +266,46 @@ namespace WarpXUtilIO{
     }
 }
 
+namespace WarpXUtilMPI{
+    namespace {
+        // First row of the block of rows of an MPI rank (the block of the rank r is
+        // [RowBlockStart(r), RowBlockStart(r+1)))
+        int RowBlockStart(const int rank, const int nprocs, const int nrows)
+        {
+            return static_cast<int>((static_cast<amrex::Long>(rank)*nrows)/nprocs);
+        }
+    }
+
+    std::pair<int,int> GetRowBlock(const int nrows)
+    {
+        const int nprocs = amrex::ParallelDescriptor::NProcs();
+        const int rank = amrex::ParallelDescriptor::MyProc();
+        const int first = RowBlockStart(rank, nprocs, nrows);
+        return {first, RowBlockStart(rank+1, nprocs, nrows) - first};
+    }
+
+    void AllGatherRows(std::vector<amrex::Real>& vals, const int row_size)
+    {
+#ifdef AMREX_USE_MPI
+        const int nprocs = amrex::ParallelDescriptor::NProcs();
+        const int nrows = static_cast<int>(vals.size())/row_size;
+        std::vector<int> counts(nprocs);
+        std::vector<int> displs(nprocs);
+        for (int rank = 0; rank < nprocs; ++rank) {
+            const int first = RowBlockStart(rank, nprocs, nrows);
+            counts[rank] = (RowBlockStart(rank+1, nprocs, nrows) - first)*row_size;
+            displs[rank] = first*row_size;
+        }
+        MPI_Allgatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL,
+                       vals.data(), counts.data(), displs.data(),
+                       amrex::ParallelDescriptor::Mpi_typemap<amrex::Real>::type(),
+                       amrex::ParallelDescriptor::Communicator());
+#else
+        amrex::ignore_unused(vals, row_size);
+#endif
+    }
+}
+
 void Store_parserString(const amrex::ParmParse& pp, std::string query_string,
                         std::string& stored_string)
 {
@@ -18,6 +18,7 @@
 #include "FieldSolver/FiniteDifferenceSolver/FiniteDifferenceSolver.H"
 #include "FieldSolver/FiniteDifferenceSolver/MacroscopicProperties/MacroscopicProperties.H"
 #ifdef WARPX_USE_PSATD
+#   include "FieldSolver/SpectralSolver/AnyFFT.H"
 #   include "FieldSolver/SpectralSolver/SpectralKSpace.H"
 #   ifdef WARPX_DIM_RZ
 #       include "FieldSolver/SpectralSolver/SpectralSolverRZ.H"
@@ -28,6 +29,7 @@
 #endif // use PSATD ifdef
 #include "FieldSolver/WarpX_FDTD.H"
 #include "Filter/NCIGodfreyFilter.H"
+#include "Parallelization/WarpXCommUtil.H"
 #include "Particles/MultiParticleContainer.H"
 #include "Particles/ParticleBoundaryBuffer.H"
 #include "Utils/TextMsg.H"
@@ -104,6 +106,7 @@ int WarpX::moving_window_dir = -1;
 Real WarpX::moving_window_v = std::numeric_limits<amrex::Real>::max();
 
 bool WarpX::fft_do_time_averaging = false;
+int WarpX::fft_batch_size = 3;
 
 amrex::IntVect WarpX::fill_guards = amrex::IntVect(0);
 
@@ -120,11 +123,16 @@ short WarpX::field_gathering_algo;
 short WarpX::particle_pusher_algo;
 short WarpX::maxwell_solver_id;
 short WarpX::load_balance_costs_update_algo;
+bool WarpX::use_fused_particle_kernel = false;
+bool WarpX::use_fused_maxwell_kernel = false;
 bool WarpX::do_dive_cleaning = false;
 bool WarpX::do_divb_cleaning = false;
 int WarpX::em_solver_medium;
 int WarpX::macroscopic_solver_algo;
 bool WarpX::do_single_precision_comms = false;
+bool WarpX::do_fused_comms = false;
+bool WarpX::do_overlap_current_sum = false;
+int WarpX::fdtd_temporal_blocking = 0;
 amrex::Vector<int> WarpX::field_boundary_lo(AMREX_SPACEDIM,0);
 amrex::Vector<int> WarpX::field_boundary_hi(AMREX_SPACEDIM,0);
 amrex::Vector<ParticleBoundaryType> WarpX::particle_boundary_lo(AMREX_SPACEDIM,ParticleBoundaryType::Absorbing);
@@ -156,6 +164,7 @@ bool WarpX::galerkin_interpolation = true;
 bool WarpX::use_filter = true;
 bool WarpX::use_kspace_filter       = true;
 bool WarpX::use_filter_compensation = false;
+bool WarpX::use_separable_filter = false;
 
 bool WarpX::serialize_initial_conditions = false;
 bool WarpX::refine_plasma     = false;
@@ -183,11 +192,13 @@ Real WarpX::self_fields_required_precision = 1.e-11_rt;
 Real WarpX::self_fields_absolute_tolerance = 0.0_rt;
 int WarpX::self_fields_max_iters = 200;
 int WarpX::self_fields_verbosity = 2;
+bool WarpX::self_fields_reuse_solver = true;
 
 bool WarpX::do_subcycling = false;
 bool WarpX::do_multi_J = false;
 int WarpX::do_multi_J_n_depositions;
 bool WarpX::safe_guard_cells = 0;
+bool WarpX::moving_window_in_place_shift = true;
 
 IntVect WarpX::filter_npass_each_dir(1);
 
@@ -258,6 +269,8 @@ WarpX::WarpX ()
 
     // Particle Container
     mypc = std::make_unique<MultiParticleContainer>(this);
+
+    m_pending_current_sum = std::make_unique<WarpXCommUtil::PendingExchange>();
     warpx_do_continuous_injection = mypc->doContinuousInjection();
     if (warpx_do_continuous_injection){
         if (moving_window_v >= 0){
@@ -341,6 +354,11 @@ WarpX::WarpX ()
 
     costs.resize(nlevs_max);
     load_balance_efficiency.resize(nlevs_max);
+    costs_history.resize(nlevs_max);
+    costs_history_steps.resize(nlevs_max);
+    load_balance_efficiency_predicted.resize(nlevs_max, -1);
+    load_balance_efficiency_expected.resize(nlevs_max, -1);
+    load_balance_efficiency_actual.resize(nlevs_max, -1);
 
     m_field_factory.resize(nlevs_max);
 
@@ -353,8 +371,10 @@ WarpX::WarpX ()
     // Set default values for particle and cell weights for costs update;
     // Default values listed here for the case AMREX_USE_GPU are determined
     // from single-GPU tests on Summit.
+    // (these are also the initial weights of the calibrated cost model)
     if (costs_heuristic_cells_wt<=0. && costs_heuristic_particles_wt<=0.
-        && WarpX::load_balance_costs_update_algo==LoadBalanceCostsUpdateAlgo::Heuristic)
+        && (WarpX::load_balance_costs_update_algo==LoadBalanceCostsUpdateAlgo::Heuristic
+            || load_balance_costs_calibrated))
     {
 #ifdef AMREX_USE_GPU
         if (WarpX::maxwell_solver_id == MaxwellSolverAlgo::PSATD) {
@@ -688,6 +708,7 @@ WarpX::ReadParameters ()
 
             getWithParser(pp_warpx, "moving_window_v", moving_window_v);
             moving_window_v *= PhysConst::c;
+            pp_warpx.query("moving_window_in_place_shift", moving_window_in_place_shift);
         }
 
         pp_warpx.query("do_back_transformed_diagnostics", do_back_transformed_diagnostics);
@@ -743,6 +764,9 @@ WarpX::ReadParameters ()
             queryWithParser(pp_warpx, "self_fields_max_iters", self_fields_max_iters);
             pp_warpx.query("self_fields_verbosity", self_fields_verbosity);
         }
+        if (do_electrostatic != ElectrostaticSolverAlgo::None) {
+            pp_warpx.query("self_fields_reuse_solver", self_fields_reuse_solver);
+        }
         // Parse the input file for domain boundary potentials
         ParmParse pp_boundary("boundary");
         pp_boundary.query("potential_lo_x", field_boundary_handler.potential_xlo_str);
@@ -766,6 +790,7 @@ WarpX::ReadParameters ()
         // proper size for AMREX_SPACEDIM
         pp_warpx.query("use_filter", use_filter);
         pp_warpx.query("use_filter_compensation", use_filter_compensation);
+        pp_warpx.query("use_separable_filter", use_separable_filter);
         Vector<int> parse_filter_npass_each_dir(AMREX_SPACEDIM,1);
         queryArrWithParser(pp_warpx, "filter_npass_each_dir", parse_filter_npass_each_dir, 0, AMREX_SPACEDIM);
         filter_npass_each_dir[0] = parse_filter_npass_each_dir[0];
@@ -813,6 +838,11 @@ WarpX::ReadParameters ()
                                " to be 0, since WarpX was built in single precision.");
         }
 #endif
+        pp_warpx.query("do_fused_comms", do_fused_comms);
+        pp_warpx.query("do_overlap_current_sum", do_overlap_current_sum);
+        queryWithParser(pp_warpx, "fdtd_temporal_blocking", fdtd_temporal_blocking);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(fdtd_temporal_blocking >= 0,
+            "warpx.fdtd_temporal_blocking must be non-negative");
 
         pp_warpx.query("serialize_initial_conditions", serialize_initial_conditions);
         pp_warpx.query("refine_plasma", refine_plasma);
@@ -1015,6 +1045,13 @@ WarpX::ReadParameters ()
         charge_deposition_algo = GetAlgorithmInteger(pp_algo, "charge_deposition");
         particle_pusher_algo = GetAlgorithmInteger(pp_algo, "particle_pusher");
 
+        pp_algo.query("fused_particle_kernel", use_fused_particle_kernel);
+#ifndef WARPX_DIM_3D
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!use_fused_particle_kernel,
+            "algo.fused_particle_kernel = 1 is only implemented in 3D geometry");
+#endif
+        pp_algo.query("fused_maxwell_kernel", use_fused_maxwell_kernel);
+
         if (current_deposition_algo == CurrentDepositionAlgo::Esirkepov && do_current_centering)
         {
             amrex::Abort("\nCurrent centering (nodal deposition) cannot be used with Esirkepov deposition."
@@ -1032,6 +1069,31 @@ WarpX::ReadParameters ()
             amrex::Abort("\nVay deposition not implemented with mesh refinement");
         }
 
+        if (do_overlap_current_sum)
+        {
+#ifdef WARPX_DIM_RZ
+            amrex::Abort("\nwarpx.do_overlap_current_sum = 1 is not implemented in RZ geometry");
+#endif
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                maxLevel() == 0 && !use_filter && !do_current_centering && !do_multi_J &&
+                current_deposition_algo != CurrentDepositionAlgo::Vay,
+                "warpx.do_overlap_current_sum = 1 is not implemented with mesh refinement, "
+                "filtering of the current, current centering, multi-J or Vay deposition");
+
+            // Without tiling of the particles (the default on GPU), each tile is a whole box,
+            // which always deposits in the cells exchanged with the neighboring boxes:
+            // the summation then starts after all the particles have deposited
+            ParmParse pp_particles("particles");
+            bool do_tiling = false;
+            pp_particles.query("do_tiling", do_tiling);
+            if (!do_tiling) {
+                this->RecordWarning("Parallelization",
+                    "warpx.do_overlap_current_sum = 1 has no effect without tiling of the "
+                    "particles (particles.do_tiling = 0, the default on GPU): set "
+                    "particles.do_tiling = 1 and a particles.tile_size smaller than the boxes");
+            }
+        }
+
         field_gathering_algo = GetAlgorithmInteger(pp_algo, "field_gathering");
         if (field_gathering_algo == GatheringAlgo::MomentumConserving) {
             // Use same shape factors in all directions, for gathering
@@ -1043,6 +1105,51 @@ WarpX::ReadParameters ()
             macroscopic_solver_algo = GetAlgorithmInteger(pp_algo,"macroscopic_sigma_method");
         }
 
+        if (use_fused_maxwell_kernel)
+        {
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(fdtd_temporal_blocking > 0,
+                "algo.fused_maxwell_kernel = 1 requires warpx.fdtd_temporal_blocking > 0, "
+                "so that no guard cells need to be exchanged between the updates of B and E");
+            // Only the PEC boundary conditions are applied between the updates of B and E
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                for (const auto bc : {field_boundary_lo[idim], field_boundary_hi[idim]}) {
+                    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                        bc != FieldBoundaryType::PML,
+                        "algo.fused_maxwell_kernel = 1 is not implemented with PML: "
+                        "the PML fields are not updated in the fused sweep");
+                    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                        bc == FieldBoundaryType::Periodic || bc == FieldBoundaryType::PEC,
+                        "algo.fused_maxwell_kernel = 1 requires periodic or PEC field boundaries");
+                }
+            }
+        }
+
+        if (fdtd_temporal_blocking > 0)
+        {
+#if defined(WARPX_DIM_RZ) || defined(AMREX_USE_EB)
+            amrex::Abort("\nwarpx.fdtd_temporal_blocking > 0 is not implemented in RZ geometry "
+                         "or with embedded boundaries");
+#endif
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                (maxwell_solver_id == MaxwellSolverAlgo::Yee ||
+                 maxwell_solver_id == MaxwellSolverAlgo::CKC) &&
+                em_solver_medium == MediumForEM::Vacuum &&
+                do_electrostatic == ElectrostaticSolverAlgo::None,
+                "warpx.fdtd_temporal_blocking > 0 requires the Yee or CKC solver in vacuum");
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                maxLevel() == 0 && !do_moving_window && !do_dive_cleaning && !do_divb_cleaning &&
+                num_mirrors == 0,
+                "warpx.fdtd_temporal_blocking > 0 is not implemented with mesh refinement, "
+                "moving window, div(E)/div(B) cleaning or mirrors");
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                for (const auto bc : {field_boundary_lo[idim], field_boundary_hi[idim]}) {
+                    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                        bc == FieldBoundaryType::Periodic || bc == FieldBoundaryType::PEC,
+                        "warpx.fdtd_temporal_blocking > 0 requires periodic or PEC field boundaries");
+                }
+            }
+        }
+
         // Load balancing parameters
         std::vector<std::string> load_balance_intervals_string_vec = {"0"};
         pp_algo.queryarr("load_balance_intervals", load_balance_intervals_string_vec);
@@ -1052,6 +1159,19 @@ WarpX::ReadParameters ()
         queryWithParser(pp_algo, "load_balance_efficiency_ratio_threshold",
                         load_balance_efficiency_ratio_threshold);
         load_balance_costs_update_algo = GetAlgorithmInteger(pp_algo, "load_balance_costs_update");
+        if (load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Calibrated)
+        {
+            // The cost model is calibrated with the timers over the first interval
+            load_balance_costs_calibrated = true;
+            load_balance_costs_update_algo = LoadBalanceCostsUpdateAlgo::Timers;
+        }
+        std::vector<std::string> costs_calibration_intervals_string_vec = {"0"};
+        pp_algo.queryarr("costs_calibration_intervals", costs_calibration_intervals_string_vec);
+        costs_calibration_intervals = IntervalsParser(costs_calibration_intervals_string_vec);
+        pp_algo.query("load_balance_predictive", load_balance_predictive);
+        queryWithParser(pp_algo, "load_balance_history_length", load_balance_history_length);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(load_balance_history_length >= 1,
+            "algo.load_balance_history_length must be at least 1");
         queryWithParser(pp_algo, "costs_heuristic_cells_wt", costs_heuristic_cells_wt);
         queryWithParser(pp_algo, "costs_heuristic_particles_wt", costs_heuristic_particles_wt);
 
@@ -1177,10 +1297,23 @@ WarpX::ReadParameters ()
     {
         ParmParse pp_psatd("psatd");
         pp_psatd.query("periodic_single_box_fft", fft_periodic_single_box);
+        pp_psatd.query("distributed_fft", fft_distributed);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!(fft_periodic_single_box && fft_distributed),
+            "psatd.distributed_fft cannot be used with psatd.periodic_single_box_fft");
+#if defined(WARPX_DIM_RZ) || defined(WARPX_DIM_1D_Z)
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(fft_distributed == false,
+            "psatd.distributed_fft is only implemented in 2D and 3D Cartesian geometry");
+#endif
+        if (fft_distributed) {
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(max_level == 0,
+                "psatd.distributed_fft can only be used without mesh refinement");
+        }
 
-        std::string nox_str;
-        std::string noy_str;
-        std::string noz_str;
+        // Distributed FFTs: infinite order by default (there are no guard cells to fill)
+        std::string default_order_str = (fft_distributed) ? "inf" : "";
+        std::string nox_str = default_order_str;
+        std::string noy_str = default_order_str;
+        std::string noz_str = default_order_str;
 
         pp_psatd.query("nox", nox_str);
         pp_psatd.query("noy", noy_str);
@@ -1203,27 +1336,49 @@ WarpX::ReadParameters ()
         }
 
 
-        if (!fft_periodic_single_box) {
-            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(nox_fft > 0, "PSATD order must be finite unless psatd.periodic_single_box_fft is used");
-            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(noy_fft > 0, "PSATD order must be finite unless psatd.periodic_single_box_fft is used");
-            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(noz_fft > 0, "PSATD order must be finite unless psatd.periodic_single_box_fft is used");
+        if (!fft_periodic_single_box && !fft_distributed) {
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(nox_fft > 0, "PSATD order must be finite unless psatd.periodic_single_box_fft or psatd.distributed_fft is used");
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(noy_fft > 0, "PSATD order must be finite unless psatd.periodic_single_box_fft or psatd.distributed_fft is used");
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(noz_fft > 0, "PSATD order must be finite unless psatd.periodic_single_box_fft or psatd.distributed_fft is used");
         }
 
         pp_psatd.query("current_correction", current_correction);
         pp_psatd.query("do_time_averaging", fft_do_time_averaging);
 
+        queryWithParser(pp_psatd, "fft_batch_size", fft_batch_size);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(fft_batch_size >= 1,
+            "psatd.fft_batch_size must be at least 1");
+
+#ifdef WARPX_USE_PSATD
+        // Effort of the FFTW planner, and directory where the FFTW wisdom is saved
+        std::string fftw_plan_effort = "estimate";
+        pp_psatd.query("fftw_plan_effort", fftw_plan_effort);
+        std::string fftw_wisdom_dir;
+        pp_psatd.query("fftw_wisdom_dir", fftw_wisdom_dir);
+        AnyFFT::plan_effort effort = AnyFFT::plan_effort::estimate;
+        if (fftw_plan_effort == "measure") {
+            effort = AnyFFT::plan_effort::measure;
+        } else if (fftw_plan_effort == "patient") {
+            effort = AnyFFT::plan_effort::patient;
+        } else {
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(fftw_plan_effort == "estimate",
+                "psatd.fftw_plan_effort must be estimate, measure or patient");
+        }
+        AnyFFT::SetPlannerOptions(effort, fftw_wisdom_dir);
+#endif
+
         if (WarpX::current_correction == true)
         {
             WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
-                fft_periodic_single_box == true,
-                "Option psatd.current_correction=1 must be used with psatd.periodic_single_box_fft=1.");
+                fft_periodic_single_box == true || fft_distributed == true,
+                "Option psatd.current_correction=1 must be used with psatd.periodic_single_box_fft=1 or psatd.distributed_fft=1.");
         }
 
         if (WarpX::current_deposition_algo == CurrentDepositionAlgo::Vay)
         {
             WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
-                fft_periodic_single_box == false,
-                "Option algo.current_deposition=vay must be used with psatd.periodic_single_box_fft=0.");
+                fft_periodic_single_box == false && fft_distributed == false,
+                "Option algo.current_deposition=vay must be used with psatd.periodic_single_box_fft=0 and psatd.distributed_fft=0.");
         }
 
         // Auxiliary: boosted_frame = true if warpx.gamma_boost is set in the inputs
@@ -1577,6 +1732,7 @@ WarpX::ClearLevel (int lev)
     G_fp  [lev].reset();
     rho_fp[lev].reset();
     phi_fp[lev].reset();
+    if (lev < static_cast<int>(m_poisson_solvers.size())) m_poisson_solvers[lev].clear();
     F_cp  [lev].reset();
     G_cp  [lev].reset();
     rho_cp[lev].reset();
@@ -1590,6 +1746,8 @@ WarpX::ClearLevel (int lev)
 
     costs[lev].reset();
     load_balance_efficiency[lev] = -1;
+    costs_history[lev].clear();
+    costs_history_steps[lev].clear();
 }
 
 void
@@ -1627,7 +1785,8 @@ WarpX::AllocLevelData (int lev, const BoxArray& ba, const DistributionMapping& d
         WarpX::isAnyBoundaryPML(),
         WarpX::do_pml_in_domain,
         WarpX::pml_ncell,
-        this->refRatio());
+        this->refRatio(),
+        WarpX::fdtd_temporal_blocking);
 
 
 #ifdef AMREX_USE_EB
@@ -1911,6 +2070,12 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
                 "The option `psatd.periodic_single_box_fft` can only be used for a periodic domain, decomposed in a single box");
 #   endif
         }
+        // Check whether the option distributed FFT is valid here
+        if (fft_distributed) {
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                geom[0].isAllPeriodic() && lev == 0, // domain is periodic in all directions
+                "The option `psatd.distributed_fft` can only be used for a periodic domain, without mesh refinement");
+        }
         // Get the cell-centered box
         BoxArray realspace_ba = ba;  // Copy box
         realspace_ba.enclosedCells(); // Make it cell-centered
@@ -1930,7 +2095,7 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
                                    dm,
                                    dx);
 #   else
-        if ( fft_periodic_single_box == false ) {
+        if ( fft_periodic_single_box == false && fft_distributed == false ) {
             realspace_ba.grow(ngEB);   // add guard cells
         }
         bool const pml_flag_false = false;
@@ -2236,6 +2401,7 @@ void WarpX::AllocLevelSpectralSolver (amrex::Vector<std::unique_ptr<SpectralSolv
                                                 solver_dt,
                                                 pml_flag,
                                                 fft_periodic_single_box,
+                                                fft_distributed,
                                                 update_with_rho,
                                                 fft_do_time_averaging,
                                                 do_multi_J,
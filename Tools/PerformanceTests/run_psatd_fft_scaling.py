@@ -0,0 +1,88 @@
+# Copyright 2022 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# Strong scaling of the PSATD solver, with local FFTs in each box (with guard
+# cells) and with FFTs distributed over the whole domain (psatd.distributed_fft).
+#
+# The same periodic 3D problem is run on 1, 2, 4, ..., 64 MPI ranks (one box
+# per rank along z), and the average time per step printed by WarpX is
+# reported for each number of ranks and each FFT mode, with the speedup and
+# parallel efficiency with respect to the smallest run.
+#
+# Usage (on one or several nodes of a cluster, with a 3D PSATD executable):
+#   python run_psatd_fft_scaling.py --executable <path/to/warpx.3d...> \
+#       --mpiexec "srun -n" --ranks 1 2 4 8 16 32 64 --csv psatd_fft_scaling.csv
+
+import argparse
+import os
+import re
+import subprocess
+
+parser = argparse.ArgumentParser(
+    description='Strong scaling of the PSATD solver, with local and distributed FFTs')
+parser.add_argument('--executable', required=True,
+                    help='3D WarpX executable compiled with PSATD support')
+parser.add_argument('--input_file', default=os.path.join(
+                    os.path.dirname(os.path.abspath(__file__)), 'psatd_fft_scaling_periodic_3d'),
+                    help='input file of the test')
+parser.add_argument('--mpiexec', default='mpiexec -n',
+                    help='command that launches the executable on a given number of ranks')
+parser.add_argument('--ranks', type=int, nargs='+', default=[1, 2, 4, 8, 16, 32, 64],
+                    help='numbers of MPI ranks')
+parser.add_argument('--n_cell', type=int, nargs=3, default=[128, 128, 128],
+                    help='number of cells of the domain')
+parser.add_argument('--n_step', type=int, default=20, help='number of time steps')
+parser.add_argument('--n_omp', type=int, default=1, help='number of OpenMP threads per rank')
+parser.add_argument('--modes', type=int, nargs='+', default=[0, 1],
+                    help='values of psatd.distributed_fft to run')
+parser.add_argument('--extra_args', nargs='*', default=[],
+                    help='additional input parameters, e.g. psatd.fft_batch_size=6')
+parser.add_argument('--csv', default='psatd_fft_scaling.csv', help='output table')
+args = parser.parse_args()
+
+def run_test(n_ranks, distributed_fft):
+    """Run one simulation and return the average time per step, in seconds"""
+    # One box per rank, split along z, as for the slab decomposition
+    # of the distributed FFTs
+    max_grid_size = [args.n_cell[0], args.n_cell[1], max(1, args.n_cell[2] // n_ranks)]
+    run_dir = 'psatd_fft_scaling_n{}_dist{}'.format(n_ranks, distributed_fft)
+    os.makedirs(run_dir, exist_ok=True)
+    command = args.mpiexec.split() + [str(n_ranks), os.path.abspath(args.executable),
+               os.path.abspath(args.input_file),
+               'amr.n_cell={} {} {}'.format(*args.n_cell),
+               'amr.max_grid_size_x={}'.format(max_grid_size[0]),
+               'amr.max_grid_size_y={}'.format(max_grid_size[1]),
+               'amr.max_grid_size_z={}'.format(max_grid_size[2]),
+               'amr.blocking_factor=1',
+               'max_step={}'.format(args.n_step),
+               'psatd.distributed_fft={}'.format(distributed_fft)] + args.extra_args
+    env = dict(os.environ, OMP_NUM_THREADS=str(args.n_omp))
+    with open(os.path.join(run_dir, 'output.txt'), 'w') as output:
+        subprocess.run(command, cwd=run_dir, env=env, stdout=output,
+                       stderr=subprocess.STDOUT, check=True)
+    with open(os.path.join(run_dir, 'output.txt')) as output:
+        step_times = re.findall(r'Avg\. per step = ([0-9.eE+-]+) s', output.read())
+    if not step_times:
+        raise RuntimeError('No time per step found in ' + run_dir + '/output.txt')
+    return float(step_times[-1])
+
+rows = []
+for distributed_fft in args.modes:
+    reference = None
+    for n_ranks in sorted(args.ranks):
+        time_per_step = run_test(n_ranks, distributed_fft)
+        if reference is None:
+            reference = (n_ranks, time_per_step)
+        speedup = reference[1] / time_per_step
+        efficiency = speedup * reference[0] / n_ranks
+        rows.append((distributed_fft, n_ranks, time_per_step, speedup, efficiency))
+        print('distributed_fft={} ranks={:4d} time/step={:.4e} s speedup={:.2f} efficiency={:.2f}'
+              .format(distributed_fft, n_ranks, time_per_step, speedup, efficiency), flush=True)
+
+with open(args.csv, 'w') as f:
+    f.write('distributed_fft,n_ranks,time_per_step,speedup,efficiency\n')
+    for row in rows:
+        f.write('{},{},{:.6e},{:.4f},{:.4f}\n'.format(*row))
@@ -318,12 +318,15 @@ def _read_buffer(snapshot, header_fn, _component_names):
                 all_data[_component_names[i]] = data
     return all_data
 
-def read_reduced_diags(filename, delimiter=' '):
+def read_reduced_diags(filename, delimiter=' ', binary_filename=None):
     '''
     Read data written by WarpX Reduced Diagnostics, and return them into Python objects
     input:
     - filename name of file to open
     - delimiter (optional, default ',') delimiter between fields in header.
+    - binary_filename (optional) name of the file with the data rows, for
+      reduced diagnostics written with format = binary (filename then only
+      contains the header)
     output:
     - metadata_dict dictionary where first key is the type of metadata, second is the field
     - data dictionary with data
@@ -335,7 +338,10 @@ def read_reduced_diags(filename, delimiter=' '):
     field_units =  [s[s.find("(")+1:s.find(")")] for s in unformatted_header]
     field_column =  [s[s.find("[")+1:s.find("]")] for s in unformatted_header]
     # Load data and re-format to a dictionary
-    data = np.loadtxt( filename, delimiter=delimiter )
+    if binary_filename is None:
+        data = np.loadtxt( filename, delimiter=delimiter )
+    else:
+        data = np.fromfile( binary_filename, dtype=np.float64 ).reshape(-1, len(field_names))
     if data.ndim == 1:
         data_dict = {key: np.atleast_1d(data[i]) for i, key in enumerate(field_names)}
     else: